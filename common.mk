@@ -72,32 +72,114 @@ $(SRCDIR)/license.hpp: $(DOCDIR)/COPYING $(SCRIPTDIR)/create-hex-include.sh
 # dependencies
 $(DSTDIR)/pp/parser/Utility$(OBJEXT): \
 	$(SRCDIR)/pp/parser/Utility.hpp \
+	$(SRCDIR)/pp/ContentHashStore.hpp \
+	$(SRCDIR)/pp/FileStatusCache.hpp \
+	$(SRCDIR)/pp/Shell.hpp \
+	$(SRCDIR)/pp/Type.hpp \
+	$(SRCDIR)/pp/Variable.hpp
+$(DSTDIR)/pp/ContentHashStore$(OBJEXT): \
+	$(SRCDIR)/pp/ContentHashStore.cpp \
+	$(SRCDIR)/pp/ContentHashStore.hpp \
+	$(SRCDIR)/pp/FileStatusCache.hpp
+$(DSTDIR)/pp/Database$(OBJEXT): \
+	$(SRCDIR)/pp/ContentHashStore.hpp \
+	$(SRCDIR)/pp/Database.cpp \
+	$(SRCDIR)/pp/Database.hpp \
+	$(SRCDIR)/pp/DatabaseBackend.hpp \
+	$(SRCDIR)/pp/FileStatusCache.hpp \
+	$(SRCDIR)/pp/LogDatabase.hpp \
+	$(SRCDIR)/pp/Shell.hpp \
+	$(SRCDIR)/pp/SqliteDatabase.hpp \
+	$(SRCDIR)/pp/Type.hpp \
+	$(SRCDIR)/pp/Variable.hpp
+$(DSTDIR)/pp/DatabaseBackend$(OBJEXT): \
+	$(SRCDIR)/pp/ContentHashStore.hpp \
+	$(SRCDIR)/pp/Database.hpp \
+	$(SRCDIR)/pp/DatabaseBackend.cpp \
+	$(SRCDIR)/pp/DatabaseBackend.hpp \
+	$(SRCDIR)/pp/FileStatusCache.hpp \
+	$(SRCDIR)/pp/Shell.hpp \
+	$(SRCDIR)/pp/Type.hpp \
+	$(SRCDIR)/pp/Variable.hpp
+$(DSTDIR)/pp/DirectoryIndex$(OBJEXT): \
+	$(SRCDIR)/pp/ContentHashStore.hpp \
+	$(SRCDIR)/pp/DirectoryIndex.cpp \
+	$(SRCDIR)/pp/DirectoryIndex.hpp \
+	$(SRCDIR)/pp/FileStatusCache.hpp \
 	$(SRCDIR)/pp/Shell.hpp \
 	$(SRCDIR)/pp/Type.hpp \
 	$(SRCDIR)/pp/Variable.hpp
 $(DSTDIR)/pp/Execution$(OBJEXT): \
 	$(SRCDIR)/pp/Command.hpp \
+	$(SRCDIR)/pp/ContentHashStore.hpp \
+	$(SRCDIR)/pp/DirectoryIndex.hpp \
 	$(SRCDIR)/pp/Execution.cpp \
 	$(SRCDIR)/pp/Execution.hpp \
+	$(SRCDIR)/pp/FileSnapshot.hpp \
+	$(SRCDIR)/pp/FileStatusCache.hpp \
+	$(SRCDIR)/pp/FileWatcher.hpp \
 	$(SRCDIR)/pp/Process.hpp \
 	$(SRCDIR)/pp/ProcessBlock.hpp \
 	$(SRCDIR)/pp/ProcessNode.hpp \
+	$(SRCDIR)/pp/Scheduler.hpp \
 	$(SRCDIR)/pp/Shell.hpp \
+	$(SRCDIR)/pp/TaskGroup.hpp \
 	$(SRCDIR)/pp/Type.hpp \
 	$(SRCDIR)/pp/Utility.hpp \
 	$(SRCDIR)/pp/Variable.hpp
+$(DSTDIR)/pp/FileSnapshot$(OBJEXT): \
+	$(SRCDIR)/pp/ContentHashStore.hpp \
+	$(SRCDIR)/pp/Database.hpp \
+	$(SRCDIR)/pp/FileSnapshot.cpp \
+	$(SRCDIR)/pp/FileSnapshot.hpp \
+	$(SRCDIR)/pp/FileStatusCache.hpp \
+	$(SRCDIR)/pp/Shell.hpp \
+	$(SRCDIR)/pp/Type.hpp \
+	$(SRCDIR)/pp/Variable.hpp
+$(DSTDIR)/pp/FileStatusCache$(OBJEXT): \
+	$(SRCDIR)/pp/FileStatusCache.cpp \
+	$(SRCDIR)/pp/FileStatusCache.hpp
+$(DSTDIR)/pp/FileWatcher$(OBJEXT): \
+	$(SRCDIR)/pp/FileStatusCache.hpp \
+	$(SRCDIR)/pp/FileWatcher.cpp \
+	$(SRCDIR)/pp/FileWatcher.hpp
+$(DSTDIR)/pp/LoadController$(OBJEXT): \
+	$(SRCDIR)/pp/ContentHashStore.hpp \
+	$(SRCDIR)/pp/FileStatusCache.hpp \
+	$(SRCDIR)/pp/LoadController.cpp \
+	$(SRCDIR)/pp/LoadController.hpp \
+	$(SRCDIR)/pp/Scheduler.hpp \
+	$(SRCDIR)/pp/Shell.hpp \
+	$(SRCDIR)/pp/Type.hpp \
+	$(SRCDIR)/pp/Variable.hpp
+$(DSTDIR)/pp/LogDatabase$(OBJEXT): \
+	$(SRCDIR)/pp/ContentHashStore.hpp \
+	$(SRCDIR)/pp/Database.hpp \
+	$(SRCDIR)/pp/DatabaseBackend.hpp \
+	$(SRCDIR)/pp/FileStatusCache.hpp \
+	$(SRCDIR)/pp/LogDatabase.cpp \
+	$(SRCDIR)/pp/LogDatabase.hpp \
+	$(SRCDIR)/pp/Shell.hpp \
+	$(SRCDIR)/pp/Type.hpp \
+	$(SRCDIR)/pp/Variable.hpp
 $(DSTDIR)/pp/Script$(OBJEXT): \
 	$(SRCDIR)/pp/parser/Script.hpp \
 	$(SRCDIR)/pp/parser/StringLiteral.hpp \
 	$(SRCDIR)/pp/parser/Utility.hpp \
 	$(SRCDIR)/pp/Command.hpp \
+	$(SRCDIR)/pp/ContentHashStore.hpp \
 	$(SRCDIR)/pp/Execution.hpp \
+	$(SRCDIR)/pp/FileSnapshot.hpp \
+	$(SRCDIR)/pp/FileStatusCache.hpp \
+	$(SRCDIR)/pp/FileWatcher.hpp \
 	$(SRCDIR)/pp/Process.hpp \
 	$(SRCDIR)/pp/ProcessBlock.hpp \
 	$(SRCDIR)/pp/ProcessNode.hpp \
+	$(SRCDIR)/pp/Scheduler.hpp \
 	$(SRCDIR)/pp/Script.cpp \
 	$(SRCDIR)/pp/Script.hpp \
 	$(SRCDIR)/pp/Shell.hpp \
+	$(SRCDIR)/pp/TaskGroup.hpp \
 	$(SRCDIR)/pp/Type.hpp \
 	$(SRCDIR)/pp/Utility.hpp \
 	$(SRCDIR)/pp/Variable.hpp
@@ -105,7 +187,19 @@ $(DSTDIR)/pp/Shell$(OBJEXT): \
 	$(SRCDIR)/pp/Shell.cpp \
 	$(SRCDIR)/pp/Shell.hpp \
 	$(SRCDIR)/pp/Variable.hpp
+$(DSTDIR)/pp/SqliteDatabase$(OBJEXT): \
+	$(SRCDIR)/pp/ContentHashStore.hpp \
+	$(SRCDIR)/pp/Database.hpp \
+	$(SRCDIR)/pp/DatabaseBackend.hpp \
+	$(SRCDIR)/pp/FileStatusCache.hpp \
+	$(SRCDIR)/pp/Shell.hpp \
+	$(SRCDIR)/pp/SqliteDatabase.cpp \
+	$(SRCDIR)/pp/SqliteDatabase.hpp \
+	$(SRCDIR)/pp/Type.hpp \
+	$(SRCDIR)/pp/Variable.hpp
 $(DSTDIR)/pp/Type$(OBJEXT): \
+	$(SRCDIR)/pp/ContentHashStore.hpp \
+	$(SRCDIR)/pp/FileStatusCache.hpp \
 	$(SRCDIR)/pp/Shell.hpp \
 	$(SRCDIR)/pp/Type.cpp \
 	$(SRCDIR)/pp/Type.hpp \
@@ -113,6 +207,8 @@ $(DSTDIR)/pp/Type$(OBJEXT): \
 $(DSTDIR)/pp/Variable$(OBJEXT): \
 	$(SRCDIR)/pp/parser/StringLiteral.hpp \
 	$(SRCDIR)/pp/parser/Utility.hpp \
+	$(SRCDIR)/pp/ContentHashStore.hpp \
+	$(SRCDIR)/pp/FileStatusCache.hpp \
 	$(SRCDIR)/pp/Shell.hpp \
 	$(SRCDIR)/pp/Type.hpp \
 	$(SRCDIR)/pp/Variable.cpp \
@@ -122,12 +218,19 @@ $(DSTDIR)/posix_main$(OBJEXT): \
 	$(SRCDIR)/posix_main.hpp
 $(DSTDIR)/pp$(OBJEXT): \
 	$(SRCDIR)/pp/Command.hpp \
+	$(SRCDIR)/pp/ContentHashStore.hpp \
 	$(SRCDIR)/pp/Execution.hpp \
+	$(SRCDIR)/pp/FileSnapshot.hpp \
+	$(SRCDIR)/pp/FileStatusCache.hpp \
+	$(SRCDIR)/pp/FileWatcher.hpp \
+	$(SRCDIR)/pp/LoadController.hpp \
 	$(SRCDIR)/pp/Process.hpp \
 	$(SRCDIR)/pp/ProcessBlock.hpp \
 	$(SRCDIR)/pp/ProcessNode.hpp \
+	$(SRCDIR)/pp/Scheduler.hpp \
 	$(SRCDIR)/pp/Script.hpp \
 	$(SRCDIR)/pp/Shell.hpp \
+	$(SRCDIR)/pp/TaskGroup.hpp \
 	$(SRCDIR)/pp/Type.hpp \
 	$(SRCDIR)/pp/Utility.hpp \
 	$(SRCDIR)/pp/Variable.hpp \
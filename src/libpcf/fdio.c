@@ -4,8 +4,9 @@
  * @copyright Copyright 2015-2018 Daniel Starke
  * @see fdio.h
  * @date 2015-02-28
- * @version 2018-02-26
+ * @version 2026-10-17
  */
+#define _GNU_SOURCE /* close_range() */
 #define _POSIX_C_SOURCE 200809L
 #include <stdlib.h>
 #include <libpcf/target.h>
@@ -76,6 +77,12 @@ volatile HANDLE _LIBPCF_CREATEPROCESS_MUTEX;
  * @internal
  */
 int fdio_closeNonDefFds() {
+#if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 34)
+	if (close_range(3, ~0U, 0) == 0) return 1;
+	/* not supported by the running kernel */
+#endif /* glibc 2.34 or newer */
+#endif /* __GLIBC__ */
 #ifdef F_CLOSEM
 	int ret;
 	do {
@@ -5,10 +5,12 @@
  * @see fdios.h
  * @see fdious.h
  * @date 2016-08-17
- * @version 2018-02-27
+ * @version 2026-10-17
  * @internal This file is never used or compiled directly but only included.
  * @remarks Define CHAR_T to the character type before including this file.
  * @remarks See FPOPEN_FUNC() and FPCLOSE_FUNC() for further notes.
+ * @remarks Define _GNU_SOURCE before including any header to enable the posix_spawn() based
+ * implementation on Linux (glibc 2.34 or newer).
  * @see https://blogs.msdn.microsoft.com/oldnewthing/20111216-00/?p=8873/
  */
 #define _POSIX_C_SOURCE 200809L
@@ -24,12 +26,20 @@
 #include <winbase.h>
 #else /* ! PCF_IS_WIN */
 #include <errno.h>
+#include <fcntl.h>
 #include <signal.h>
 #include <unistd.h>
 #ifdef FPOPEN_UNICODE
 #include <wchar.h>
 #endif
 #include <sys/wait.h>
+#if defined(_GNU_SOURCE) && defined(O_CLOEXEC) && defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 34)
+#include <spawn.h>
+/** Defined if the child process is started via posix_spawn() instead of fork(). */
+#define FDIO_USE_POSIX_SPAWN 1
+#endif /* glibc 2.34 or newer */
+#endif /* _GNU_SOURCE */
 #endif /* PCF_IS_WIN */
 
 
@@ -604,14 +614,31 @@ int FPCLOSE_FUNC(tFdioPHandle * fd) {
 extern int fdio_closeNonDefFds();
 
 
+#ifdef FDIO_USE_POSIX_SPAWN
+/* Environment of the current process. */
+extern char ** environ;
+/* Create pipes which are not inherited by the child processes started in parallel. */
+#define FDIO_PIPE(x) pipe2((x), O_CLOEXEC)
+#else /* ! FDIO_USE_POSIX_SPAWN */
+#define FDIO_PIPE(x) pipe(x)
+#endif /* FDIO_USE_POSIX_SPAWN */
+
+
 tFdioPHandle * FPOPEN_FUNC(const CHAR_T * shellPath, const char ** shell, const char * command, FILE * input, const tFdioPMode mode) {
 	int pStandardInput[2];
 	int pStandardOutput[2];
 	int pStandardError[2];
 	int hasPStdIn, hasPStdOut, hasPStdErr;
+#ifdef FDIO_USE_POSIX_SPAWN
+	posix_spawn_file_actions_t fileActions;
+	posix_spawnattr_t spawnAttr;
+	int hasFileActions, hasSpawnAttr;
+	sigset_t childMask, defaultSignals;
+#else /* ! FDIO_USE_POSIX_SPAWN */
 	sigset_t oldMask, newMask;
 	struct sigaction sigAction;
 	int hasOldMask;
+#endif /* FDIO_USE_POSIX_SPAWN */
 	tFdioPHandle * fd;
 	size_t numArgs, strLen, totalStrLen;
 	const CHAR_T ** args;
@@ -627,7 +654,12 @@ tFdioPHandle * FPOPEN_FUNC(const CHAR_T * shellPath, const char ** shell, const
 	hasPStdIn = 0;
 	hasPStdOut = 0;
 	hasPStdErr = 0;
+#ifdef FDIO_USE_POSIX_SPAWN
+	hasFileActions = 0;
+	hasSpawnAttr = 0;
+#else /* ! FDIO_USE_POSIX_SPAWN */
 	hasOldMask = 0;
+#endif /* FDIO_USE_POSIX_SPAWN */
 	fd = NULL;
 	argv = NULL;
 	
@@ -661,20 +693,61 @@ tFdioPHandle * FPOPEN_FUNC(const CHAR_T * shellPath, const char ** shell, const
 	argv[i] = NULL;
 	
 	if ((((int)mode) & FDIO_USE_STDIN) != 0) {
-		if (pipe(pStandardInput) != 0) goto onerror;
+		if (FDIO_PIPE(pStandardInput) != 0) goto onerror;
 		hasPStdIn = 1;
 	}
 	if ((((int)mode) & FDIO_USE_STDOUT) != 0) {
-		if (pipe(pStandardOutput) != 0) goto onerror;
+		if (FDIO_PIPE(pStandardOutput) != 0) goto onerror;
 		hasPStdOut = 1;
 	}
 	if ((((int)mode) & FDIO_USE_STDERR) != 0 && (((int)mode) & FDIO_COMBINE) == 0) {
-		if (pipe(pStandardError) != 0) goto onerror;
+		if (FDIO_PIPE(pStandardError) != 0) goto onerror;
 		hasPStdErr = 1;
 	}
 
 	if ((fd = (tFdioPHandle *)malloc(sizeof(tFdioPHandle))) == NULL) goto onerror;
 	
+#ifdef FDIO_USE_POSIX_SPAWN
+	/* The child process shares the memory of the parent until execution (vfork semantics).
+	 * This keeps the start-up time independent of the memory usage of the calling process. */
+	if (posix_spawn_file_actions_init(&fileActions) != 0) goto onerror;
+	hasFileActions = 1;
+	if (posix_spawnattr_init(&spawnAttr) != 0) goto onerror;
+	hasSpawnAttr = 1;
+	
+	/* clear out signal handlers and keep the signal mask of the calling thread */
+	sigfillset(&defaultSignals);
+	if (pthread_sigmask(SIG_BLOCK, NULL, &childMask) != 0) goto onerror;
+	if (posix_spawnattr_setsigdefault(&spawnAttr, &defaultSignals) != 0) goto onerror;
+	if (posix_spawnattr_setsigmask(&spawnAttr, &childMask) != 0) goto onerror;
+	if (posix_spawnattr_setflags(&spawnAttr, POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETSIGMASK) != 0) goto onerror;
+	
+	/* set stdin/stdout/stderr accordingly */
+	if ((((int)mode) & FDIO_USE_STDIN) != 0) {
+		if (posix_spawn_file_actions_adddup2(&fileActions, pStandardInput[READ_PIPE], STDIN_FILENO) != 0) goto onerror;
+	} else if (input != NULL) {
+		if (posix_spawn_file_actions_adddup2(&fileActions, fileno(input), STDIN_FILENO) != 0) goto onerror;
+	}
+	if ((((int)mode) & FDIO_USE_STDOUT) != 0) {
+		if (posix_spawn_file_actions_adddup2(&fileActions, pStandardOutput[WRITE_PIPE], STDOUT_FILENO) != 0) goto onerror;
+	}
+	if ((((int)mode) & FDIO_USE_STDERR) != 0 && (((int)mode) & FDIO_COMBINE) == 0) {
+		if (posix_spawn_file_actions_adddup2(&fileActions, pStandardError[WRITE_PIPE], STDERR_FILENO) != 0) goto onerror;
+	} else if ((((int)mode) & FDIO_COMBINE) != 0) {
+		if (posix_spawn_file_actions_adddup2(&fileActions, STDOUT_FILENO, STDERR_FILENO) != 0) goto onerror;
+	}
+	
+	/* close all unwanted file descriptors inherited from the parent process */
+	if (posix_spawn_file_actions_addclosefrom_np(&fileActions, 3) != 0) goto onerror;
+	
+	/* see why argv cannot be const char **: http://pubs.opengroup.org/onlinepubs/9699919799/functions/exec.html#tag_16_111 */
+	if (posix_spawnp(&(fd->pid), shellPath, &fileActions, &spawnAttr, argv, environ) != 0) goto onerror;
+	
+	posix_spawnattr_destroy(&spawnAttr);
+	hasSpawnAttr = 0;
+	posix_spawn_file_actions_destroy(&fileActions);
+	hasFileActions = 0;
+#else /* ! FDIO_USE_POSIX_SPAWN */
 	/* Temporary disable signal handling for calling thread to avoid unexpected signals between
 	 * fork() and execvp(). */
 	sigfillset(&newMask);
@@ -733,55 +806,60 @@ tFdioPHandle * FPOPEN_FUNC(const CHAR_T * shellPath, const char ** shell, const
 		break;
 	default: /* parent */
 		/* restore original signal handler */
-		if (hasOldMask != 0) {
-			pthread_sigmask(SIG_SETMASK, &oldMask, NULL);
-		}
-		
-		/* close other pipe fds */
-		if (hasPStdIn != 0) close(pStandardInput[READ_PIPE]);
-		if (hasPStdOut != 0) close(pStandardOutput[WRITE_PIPE]);
-		if (hasPStdErr != 0) close(pStandardError[WRITE_PIPE]);
-		
-		if ((((int)mode) & FDIO_USE_STDIN) != 0) {
-			if ((fd->in = fdopen(
-				pStandardInput[WRITE_PIPE],
-				(((int)mode) & FDIO_BINARY_PIPE) != 0 ? "wb" : "w"
-			)) == NULL) {
-				close(pStandardInput[WRITE_PIPE]);
-			}
-		} else {
-			fd->in = NULL;
+		pthread_sigmask(SIG_SETMASK, &oldMask, NULL);
+		hasOldMask = 0;
+		break;
+	}
+#endif /* FDIO_USE_POSIX_SPAWN */
+	
+	/* close other pipe fds */
+	if (hasPStdIn != 0) close(pStandardInput[READ_PIPE]);
+	if (hasPStdOut != 0) close(pStandardOutput[WRITE_PIPE]);
+	if (hasPStdErr != 0) close(pStandardError[WRITE_PIPE]);
+	
+	if ((((int)mode) & FDIO_USE_STDIN) != 0) {
+		if ((fd->in = fdopen(
+			pStandardInput[WRITE_PIPE],
+			(((int)mode) & FDIO_BINARY_PIPE) != 0 ? "wb" : "w"
+		)) == NULL) {
+			close(pStandardInput[WRITE_PIPE]);
 		}
-		if ((((int)mode) & FDIO_USE_STDOUT) != 0) {
-			if ((fd->out = fdopen(
-				pStandardOutput[READ_PIPE],
-				(((int)mode) & FDIO_BINARY_PIPE) != 0 ? "rb" : "r"
-			)) == NULL) {
-				close(pStandardOutput[READ_PIPE]);
-			}
-		} else {
-			fd->out = NULL;
+	} else {
+		fd->in = NULL;
+	}
+	if ((((int)mode) & FDIO_USE_STDOUT) != 0) {
+		if ((fd->out = fdopen(
+			pStandardOutput[READ_PIPE],
+			(((int)mode) & FDIO_BINARY_PIPE) != 0 ? "rb" : "r"
+		)) == NULL) {
+			close(pStandardOutput[READ_PIPE]);
 		}
-		if ((((int)mode) & FDIO_USE_STDERR) != 0) {
-			if ((fd->err = fdopen(
-				pStandardError[READ_PIPE],
-				(((int)mode) & FDIO_BINARY_PIPE) != 0 ? "rb" : "r"
-			)) == NULL) {
-				close(pStandardError[READ_PIPE]);
-			}
-		} else {
-			fd->err = NULL;
+	} else {
+		fd->out = NULL;
+	}
+	if ((((int)mode) & FDIO_USE_STDERR) != 0) {
+		if ((fd->err = fdopen(
+			pStandardError[READ_PIPE],
+			(((int)mode) & FDIO_BINARY_PIPE) != 0 ? "rb" : "r"
+		)) == NULL) {
+			close(pStandardError[READ_PIPE]);
 		}
-		if (argv != NULL) free(argv);
-		break;
+	} else {
+		fd->err = NULL;
 	}
+	if (argv != NULL) free(argv);
 	
 	return fd;
 onerror:
+#ifdef FDIO_USE_POSIX_SPAWN
+	if (hasSpawnAttr != 0) posix_spawnattr_destroy(&spawnAttr);
+	if (hasFileActions != 0) posix_spawn_file_actions_destroy(&fileActions);
+#else /* ! FDIO_USE_POSIX_SPAWN */
 	/* restore original signal handler */
 	if (hasOldMask != 0) {
 		pthread_sigmask(SIG_SETMASK, &oldMask, NULL);
 	}
+#endif /* FDIO_USE_POSIX_SPAWN */
 	if (hasPStdIn != 0) {
 		close(pStandardInput[READ_PIPE]);
 		close(pStandardInput[WRITE_PIPE]);
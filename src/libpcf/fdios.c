@@ -4,7 +4,9 @@
  * @copyright Copyright 2016-2018 Daniel Starke
  * @see fdios.h
  * @date 2016-11-13
+ * @version 2026-10-17
  */
+#define _GNU_SOURCE /* pipe2() and posix_spawn_file_actions_addclosefrom_np() */
 #define _POSIX_C_SOURCE 200809L
 #include <stdlib.h>
 #include <stdint.h>
@@ -0,0 +1,240 @@
+/**
+ * @file Hash.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <pcf/data/Hash.hpp>
+#include <pcf/file/Stream.hpp>
+
+
+namespace pcf {
+namespace data {
+
+
+namespace {
+
+
+/** XXH64 prime constants. */
+static const boost::uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+static const boost::uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+static const boost::uint64_t prime3 = 0x165667B19E3779F9ULL;
+static const boost::uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+static const boost::uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+
+/** Block size used to read files in bytes. */
+static const size_t fileBlockSize = 65536;
+
+
+/**
+ * Rotates the given value to the left.
+ *
+ * @param[in] x - value to rotate
+ * @param[in] r - number of bits to rotate
+ * @return rotated value
+ */
+static inline boost::uint64_t rotl(const boost::uint64_t x, const int r) {
+	return (x << r) | (x >> (64 - r));
+}
+
+
+/**
+ * Reads a 64-bit little-endian value.
+ *
+ * @param[in] p - read from here
+ * @return read value
+ */
+static inline boost::uint64_t read64(const boost::uint8_t * p) {
+	boost::uint64_t result = 0;
+	for (int i = 7; i >= 0; i--) {
+		result = (result << 8) | static_cast<boost::uint64_t>(p[i]);
+	}
+	return result;
+}
+
+
+/**
+ * Reads a 32-bit little-endian value.
+ *
+ * @param[in] p - read from here
+ * @return read value
+ */
+static inline boost::uint64_t read32(const boost::uint8_t * p) {
+	boost::uint64_t result = 0;
+	for (int i = 3; i >= 0; i--) {
+		result = (result << 8) | static_cast<boost::uint64_t>(p[i]);
+	}
+	return result;
+}
+
+
+/**
+ * Processes a single lane value.
+ *
+ * @param[in] acc - lane accumulator
+ * @param[in] lane - lane input value
+ * @return new lane accumulator
+ */
+static inline boost::uint64_t laneRound(boost::uint64_t acc, const boost::uint64_t lane) {
+	acc += lane * prime2;
+	acc = rotl(acc, 31);
+	return acc * prime1;
+}
+
+
+/**
+ * Merges a lane accumulator into the final accumulator.
+ *
+ * @param[in] acc - final accumulator
+ * @param[in] lane - lane accumulator
+ * @return new final accumulator
+ */
+static inline boost::uint64_t mergeRound(boost::uint64_t acc, const boost::uint64_t lane) {
+	acc ^= laneRound(0, lane);
+	return (acc * prime1) + prime4;
+}
+
+
+} /* namespace */
+
+
+/**
+ * Constructor.
+ *
+ * @param[in] aSeed - hash seed
+ */
+Xxh64::Xxh64(const boost::uint64_t aSeed):
+	seed(aSeed)
+{
+	this->reset();
+}
+
+
+/**
+ * Resets the internal state to start a new hash calculation.
+ */
+void Xxh64::reset() {
+	this->acc[0] = this->seed + prime1 + prime2;
+	this->acc[1] = this->seed + prime2;
+	this->acc[2] = this->seed;
+	this->acc[3] = this->seed - prime1;
+	this->bufferSize = 0;
+	this->totalSize = 0;
+}
+
+
+/**
+ * Adds the given data to the hash calculation.
+ *
+ * @param[in] data - data to add
+ * @param[in] size - size of data in bytes
+ * @return reference to this object for chained operations
+ */
+Xxh64 & Xxh64::update(const void * data, const size_t size) {
+	const boost::uint8_t * p = static_cast<const boost::uint8_t *>(data);
+	const boost::uint8_t * const end = p + size;
+	this->totalSize += size;
+	/* complete the buffered stripe */
+	if (this->bufferSize > 0) {
+		const size_t fill = std::min(size, sizeof(this->buffer) - this->bufferSize);
+		std::memcpy(this->buffer + this->bufferSize, p, fill);
+		this->bufferSize += fill;
+		p += fill;
+		if (this->bufferSize < sizeof(this->buffer)) return *this;
+		for (size_t i = 0; i < 4; i++) {
+			this->acc[i] = laneRound(this->acc[i], read64(this->buffer + (i * 8)));
+		}
+		this->bufferSize = 0;
+	}
+	/* process full stripes */
+	for (; (end - p) >= 32; p += 32) {
+		for (size_t i = 0; i < 4; i++) {
+			this->acc[i] = laneRound(this->acc[i], read64(p + (i * 8)));
+		}
+	}
+	/* buffer remaining bytes */
+	if (p < end) {
+		this->bufferSize = static_cast<size_t>(end - p);
+		std::memcpy(this->buffer, p, this->bufferSize);
+	}
+	return *this;
+}
+
+
+/**
+ * Returns the hash value of all data passed so far.
+ *
+ * @return 64-bit hash value
+ */
+boost::uint64_t Xxh64::digest() const {
+	boost::uint64_t result;
+	if (this->totalSize >= 32) {
+		result = rotl(this->acc[0], 1) + rotl(this->acc[1], 7) + rotl(this->acc[2], 12) + rotl(this->acc[3], 18);
+		for (size_t i = 0; i < 4; i++) {
+			result = mergeRound(result, this->acc[i]);
+		}
+	} else {
+		result = this->seed + prime5;
+	}
+	result += this->totalSize;
+	/* consume remaining input */
+	const boost::uint8_t * p = this->buffer;
+	const boost::uint8_t * const end = p + this->bufferSize;
+	for (; (end - p) >= 8; p += 8) {
+		result ^= laneRound(0, read64(p));
+		result = (rotl(result, 27) * prime1) + prime4;
+	}
+	if ((end - p) >= 4) {
+		result ^= read32(p) * prime1;
+		result = (rotl(result, 23) * prime2) + prime3;
+		p += 4;
+	}
+	for (; p < end; p++) {
+		result ^= static_cast<boost::uint64_t>(*p) * prime5;
+		result = rotl(result, 11) * prime1;
+	}
+	/* avalanche */
+	result ^= result >> 33;
+	result *= prime2;
+	result ^= result >> 29;
+	result *= prime3;
+	result ^= result >> 32;
+	return result;
+}
+
+
+/**
+ * Calculates the XXH64 hash value of the content of the given file.
+ *
+ * @param[out] hash - set to the hash value of the file content
+ * @param[in] path - file to read
+ * @return true on success, false if the file could not be read
+ */
+bool hashFile(boost::uint64_t & hash, const boost::filesystem::path & path) {
+	try {
+		pcf::file::ifstream in(path, std::ios::in | std::ios::binary);
+		if ( ! in.is_open() ) return false;
+		Xxh64 state;
+		std::vector<char> block(fileBlockSize);
+		while ( in ) {
+			in.read(&(block.front()), static_cast<std::streamsize>(block.size()));
+			const std::streamsize count = in.gcount();
+			if (count <= 0) break;
+			state.update(&(block.front()), static_cast<size_t>(count));
+		}
+		if ( in.bad() ) return false;
+		hash = state.digest();
+	} catch (...) {
+		return false;
+	}
+	return true;
+}
+
+
+} /* namespace data */
+} /* namespace pcf */
@@ -0,0 +1,48 @@
+/**
+ * @file Hash.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ * @see https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+ */
+#ifndef __LIBPCFXX_DATA_HASH_HPP__
+#define __LIBPCFXX_DATA_HASH_HPP__
+
+#include <cstddef>
+#include <boost/cstdint.hpp>
+#include <boost/filesystem/path.hpp>
+#include <libpcfxx.hpp>
+
+
+namespace pcf {
+namespace data {
+
+
+/**
+ * Non-cryptographic 64-bit hash function XXH64 for fast content comparison.
+ * The data can be passed in arbitrary sized chunks.
+ */
+class LIBPCFXX_DLLPORT Xxh64 {
+private:
+	boost::uint64_t acc[4]; /**< Lane accumulators. */
+	boost::uint8_t buffer[32]; /**< Incomplete stripe of the last update. */
+	size_t bufferSize; /**< Number of bytes in buffer. */
+	boost::uint64_t totalSize; /**< Total number of bytes processed. */
+	boost::uint64_t seed; /**< Hash seed. */
+public:
+	explicit Xxh64(const boost::uint64_t aSeed = 0);
+	void reset();
+	Xxh64 & update(const void * data, const size_t size);
+	boost::uint64_t digest() const;
+};
+
+
+LIBPCFXX_DLLPORT bool LIBPCFXX_DECL hashFile(boost::uint64_t & hash, const boost::filesystem::path & path);
+
+
+} /* namespace data */
+} /* namespace pcf */
+
+
+#endif /* __LIBPCFXX_DATA_HASH_HPP__ */
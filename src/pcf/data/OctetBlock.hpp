@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2013-2018 Daniel Starke
  * @date 2013-06-25
- * @version 2016-11-20
+ * @version 2026-10-17
  * @see http://2π.com/11/variable-sized-integers
  */
 #ifndef __LIBPCFXX_DATA_OCTETBLOCK_HPP__
@@ -622,6 +622,7 @@ public:
 	static size_t getVarIntSize(const boost::uint64_t value) {
 		using namespace pcf::os;
 		if (value >= UINT64_C(0x8000000000000000)) return 9;
+		if (value == 0) return 1;
 		return static_cast<const size_t>(9 - ((PCF_LEADING_ZEROS64(value) - 1) / 7));
 	}
 };
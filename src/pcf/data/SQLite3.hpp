@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2014-2018 Daniel Starke
  * @date 2014-01-23
- * @version 2016-11-20
+ * @version 2026-10-17
  */
 #ifndef __LIBPCFXX_DATA_SQLITE3_HPP__
 #define __LIBPCFXX_DATA_SQLITE3_HPP__
@@ -995,6 +995,15 @@ public:
 		return sqlite3_exec(this->db, cmd.c_str(), NULL, NULL, NULL) == SQLITE_OK;
 	}
 	
+	/**
+	 * Returns the row ID of the most recent successful insert into a table with row IDs.
+	 *
+	 * @return row ID of the last inserted row or 0 if none was inserted
+	 */
+	boost::int64_t getLastInsertRowId() {
+		return static_cast<boost::int64_t>(sqlite3_last_insert_rowid(this->db));
+	}
+	
 	/**
 	 * Clears all data within the database.
 	 *
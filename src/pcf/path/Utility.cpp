@@ -3,19 +3,29 @@
  * @author Daniel Starke
  * @copyright Copyright 2013-2018 Daniel Starke
  * @date 2013-11-23
- * @version 2018-06-18
+ * @version 2026-10-17
  */
 #include <algorithm>
 #include <cstdlib>
+#include <deque>
 #include <limits>
+#include <map>
 #include <string>
 #include <vector>
 #include <boost/algorithm/string.hpp>
+#include <boost/bind.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/exception_ptr.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/foreach.hpp>
 #include <boost/function.hpp>
 #include <boost/locale.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
 #include <boost/regex.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
 #include <pcf/exception/General.hpp>
 #include <pcf/os/Target.hpp>
 #include <pcf/path/Utility.hpp>
@@ -34,6 +44,15 @@ extern "C" {
 }
 #endif /* PCF_IS_LINUX */
 
+#if ! defined(PCF_IS_WIN)
+extern "C" {
+#include <dirent.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+}
+#endif /* ! PCF_IS_WIN */
+
 
 namespace pcf {
 namespace path {
@@ -569,6 +588,400 @@ boost::filesystem::path getExecutablePath(boost::system::error_code & errorCode)
 }
 
 
+/** Maximum number of helper tasks posted to walk a directory tree. */
+static const size_t maxWalkerHelpers = 15;
+
+
+/**
+ * Reads all entries of the given directory in the order reported by the file
+ * system. The entries "." and ".." are skipped. The entry types are taken from
+ * the directory listing without additional file system queries if available.
+ *
+ * @param[in,out] entries - append directory entries to this vector
+ * @param[in] dir - directory to read (empty for the current working directory)
+ * @throws boost::filesystem::filesystem_error if the directory could not be read
+ */
+void readDirectory(std::vector<DirectoryEntry> & entries, const boost::filesystem::path & dir) {
+#if defined(PCF_IS_WIN)
+	for (boost::filesystem::directory_iterator n(dir.empty() ? boost::filesystem::current_path() : dir), endN; n != endN; ++n) {
+		const boost::filesystem::file_status status(n->symlink_status());
+		EntryType type = ENTRY_OTHER;
+		if ( boost::filesystem::is_symlink(status) ) {
+			type = ENTRY_SYMLINK;
+		} else if ( boost::filesystem::is_regular_file(status) ) {
+			type = ENTRY_REGULAR;
+		} else if ( boost::filesystem::is_directory(status) ) {
+			type = ENTRY_DIRECTORY;
+		}
+		entries.push_back(DirectoryEntry(n->path().filename(), type));
+	}
+#else /* ! PCF_IS_WIN */
+	DIR * handle = opendir(dir.empty() ? "." : dir.c_str());
+	if (handle == NULL) {
+		BOOST_THROW_EXCEPTION(boost::filesystem::filesystem_error(
+			"directory_iterator::construct",
+			dir,
+			boost::system::error_code(errno, boost::system::system_category())
+		));
+	}
+	int error;
+	for (;;) {
+		errno = 0;
+		const struct dirent * entry = readdir(handle);
+		error = errno;
+		if (entry == NULL) break;
+		const char * name = entry->d_name;
+		if (name[0] == '.' && (name[1] == 0 || (name[1] == '.' && name[2] == 0))) continue;
+		EntryType type = ENTRY_UNKNOWN;
+#if defined(DT_UNKNOWN)
+		switch (entry->d_type) {
+		case DT_UNKNOWN: type = ENTRY_UNKNOWN; break;
+		case DT_REG: type = ENTRY_REGULAR; break;
+		case DT_DIR: type = ENTRY_DIRECTORY; break;
+		case DT_LNK: type = ENTRY_SYMLINK; break;
+		default: type = ENTRY_OTHER; break;
+		}
+#endif /* DT_UNKNOWN */
+		entries.push_back(DirectoryEntry(boost::filesystem::path(name), type));
+	}
+	closedir(handle);
+	if (error != 0) {
+		BOOST_THROW_EXCEPTION(boost::filesystem::filesystem_error(
+			"directory_iterator::operator++",
+			dir,
+			boost::system::error_code(error, boost::system::system_category())
+		));
+	}
+#endif /* ! PCF_IS_WIN */
+}
+
+
+/**
+ * Returns the type of the given path from the file system.
+ *
+ * @param[in] p - path to check
+ * @param[in] follow - set to true to follow symbolic links
+ * @return entry type
+ */
+static EntryType getEntryType(const boost::filesystem::path & p, const bool follow) {
+#if defined(PCF_IS_WIN)
+	boost::system::error_code ec;
+	const boost::filesystem::file_status status(follow ? boost::filesystem::status(p, ec) : boost::filesystem::symlink_status(p, ec));
+	if (ec || ( ! boost::filesystem::exists(status) )) return ENTRY_MISSING;
+	if ( boost::filesystem::is_symlink(status) ) return ENTRY_SYMLINK;
+	if ( boost::filesystem::is_regular_file(status) ) return ENTRY_REGULAR;
+	if ( boost::filesystem::is_directory(status) ) return ENTRY_DIRECTORY;
+	return ENTRY_OTHER;
+#else /* ! PCF_IS_WIN */
+	struct stat st;
+	if ((follow ? stat(p.c_str(), &st) : lstat(p.c_str(), &st)) != 0) return ENTRY_MISSING;
+	if ( S_ISLNK(st.st_mode) ) return ENTRY_SYMLINK;
+	if ( S_ISREG(st.st_mode) ) return ENTRY_REGULAR;
+	if ( S_ISDIR(st.st_mode) ) return ENTRY_DIRECTORY;
+	return ENTRY_OTHER;
+#endif /* ! PCF_IS_WIN */
+}
+
+
+/**
+ * The class matches the pattern path elements against a directory tree. Sub
+ * directories are read in parallel by helper tasks which are passed to the given
+ * callback. The calling thread processes directories itself and never waits for
+ * a helper task to start. The results of each directory are kept separately and
+ * merged in the order of a sequential walk.
+ */
+class DirectoryWalker : private boost::noncopyable, public boost::enable_shared_from_this<DirectoryWalker> {
+private:
+	struct Job;
+	
+	/**
+	 * Structure of a single result of a directory job.
+	 */
+	struct Item {
+		boost::filesystem::path path; /**< Matching path. */
+		Job * child; /**< Job of a sub directory or NULL. */
+		bool failed; /**< Set to true if the matching failed at this point. */
+		
+		/**
+		 * Constructor.
+		 *
+		 * @param[in] p - matching path
+		 * @param[in] c - job of a sub directory
+		 * @param[in] f - set to true if the matching failed at this point
+		 */
+		explicit Item(const boost::filesystem::path & p, Job * c = NULL, const bool f = false):
+			path(p),
+			child(c),
+			failed(f)
+		{}
+	};
+	
+	/**
+	 * Structure of a single directory job.
+	 */
+	struct Job {
+		boost::filesystem::path path; /**< Directory path as passed to the result (empty for the current directory). */
+		boost::filesystem::path relative; /**< Path relative to the walked root directory. */
+		size_t element; /**< Index of the next pattern element to match. */
+		bool recursive; /**< Set to true to match all sub directories against the remaining pattern. */
+		bool failed; /**< Set to true if the matching failed. */
+		std::vector<Item> items; /**< Ordered results. */
+		boost::exception_ptr error; /**< Exception thrown while processing this job. */
+		
+		/**
+		 * Constructor.
+		 *
+		 * @param[in] p - directory path
+		 * @param[in] rel - path relative to the walked root directory
+		 * @param[in] e - index of the next pattern element
+		 * @param[in] rec - set to true to match all sub directories against the remaining pattern
+		 */
+		explicit Job(const boost::filesystem::path & p, const boost::filesystem::path & rel, const size_t e, const bool rec):
+			path(p),
+			relative(rel),
+			element(e),
+			recursive(rec),
+			failed(false)
+		{}
+	};
+	
+	const std::vector<std::wstring> & elements; /**< Pattern path elements. */
+	const CheckPatternCallback & hasPattern; /**< Checks if a path element contains a pattern. */
+	const UnescapePatternCallback & unescapePattern; /**< Unescapes a literal path element. */
+	const MatchingCallback & matchesPattern; /**< Checks if a path element matches a pattern. */
+	const ReadDirectoryCallback & readDir; /**< Reads the entries of a directory. */
+	const MatchingCallback & matchesPatternPrefix; /**< Checks if a relative directory path can be the beginning of a match. */
+	const ExcludeCallback & isExcluded; /**< Checks if a relative path is excluded from recursive matching. */
+	const PostTaskCallback & postTask; /**< Passes helper tasks for asynchronous execution. */
+	std::deque<Job> jobs; /**< All jobs. References stay valid while adding new ones. */
+	std::deque<Job *> queue; /**< Jobs waiting for processing. */
+	size_t active; /**< Number of jobs in process. */
+	size_t idle; /**< Number of threads waiting for jobs. */
+	size_t helpers; /**< Number of posted helper tasks which have not finished yet. */
+	bool done; /**< Set to true once the walk has finished. */
+	boost::mutex mutex; /**< Mutex object for parallel execution. */
+	boost::condition_variable changed; /**< Signaled on new jobs and on completion. */
+public:
+	/**
+	 * Constructor.
+	 *
+	 * @param[in] e - pattern path elements
+	 * @param[in] hp - callback function to check if a path element contains a pattern
+	 * @param[in] up - callback function to unescape a literal path element
+	 * @param[in] mp - callback function to check if a path element matches a pattern
+	 * @param[in] rd - callback function to read the entries of a directory (optional)
+	 * @param[in] mpp - callback function to check if a relative directory path can be the beginning of a match (optional)
+	 * @param[in] ie - callback function to check if a relative path is excluded from recursive matching (optional)
+	 * @param[in] pt - callback function to pass helper tasks for asynchronous execution (optional)
+	 * @remarks The instance needs to be owned by a boost::shared_ptr as helper tasks may outlive run().
+	 */
+	explicit DirectoryWalker(const std::vector<std::wstring> & e, const CheckPatternCallback & hp, const UnescapePatternCallback & up, const MatchingCallback & mp, const ReadDirectoryCallback & rd, const MatchingCallback & mpp, const ExcludeCallback & ie, const PostTaskCallback & pt):
+		elements(e),
+		hasPattern(hp),
+		unescapePattern(up),
+		matchesPattern(mp),
+		readDir(rd),
+		matchesPatternPrefix(mpp),
+		isExcluded(ie),
+		postTask(pt),
+		active(0),
+		idle(0),
+		helpers(0),
+		done(false)
+	{}
+	
+	/**
+	 * Matches the pattern path elements starting at the given directory.
+	 *
+	 * @param[in,out] r - append matching paths to this vector
+	 * @param[in] p - directory to start from (empty for the current directory)
+	 * @param[in] recursive - set to true to match all sub directories against the remaining pattern
+	 * @return true on success, else false
+	 */
+	bool run(std::vector<boost::filesystem::path> & r, const boost::filesystem::path & p, const bool recursive) {
+		this->jobs.push_back(Job(p, boost::filesystem::path(), 0, recursive));
+		Job & root(this->jobs.back());
+		this->queue.push_back(&root);
+		this->work(true);
+		{
+			/* late helper tasks only touch the job queue */
+			boost::mutex::scoped_lock lock(this->mutex);
+			this->done = true;
+		}
+		return this->merge(r, root);
+	}
+private:
+	/**
+	 * Helper task entry point. Processes queued jobs of the given walker until
+	 * the queue is empty.
+	 *
+	 * @param[in,out] walker - walker to help
+	 */
+	static void help(const boost::shared_ptr<DirectoryWalker> & walker) {
+		walker->work(false);
+		boost::mutex::scoped_lock lock(walker->mutex);
+		walker->helpers--;
+	}
+	
+	/**
+	 * Adds a new directory job to the queue and posts a new helper task if
+	 * needed.
+	 *
+	 * @param[in] p - directory path
+	 * @param[in] rel - path relative to the walked root directory
+	 * @param[in] e - index of the next pattern element
+	 * @param[in] rec - set to true to match all sub directories against the remaining pattern
+	 * @return added job
+	 */
+	Job * enqueue(const boost::filesystem::path & p, const boost::filesystem::path & rel, const size_t e, const bool rec) {
+		boost::mutex::scoped_lock lock(this->mutex);
+		this->jobs.push_back(Job(p, rel, e, rec));
+		Job * job = &(this->jobs.back());
+		this->queue.push_back(job);
+		if (this->idle > 0) {
+			this->changed.notify_one();
+		} else if (this->postTask && this->helpers < maxWalkerHelpers) {
+			this->helpers++;
+			lock.unlock();
+			try {
+				this->postTask(boost::bind(&DirectoryWalker::help, this->shared_from_this()));
+			} catch (...) {
+				/* the job is processed by the other threads */
+				lock.lock();
+				this->helpers--;
+			}
+		}
+		return job;
+	}
+	
+	/**
+	 * Processes queued jobs. Helper tasks return as soon as the queue is empty.
+	 * The calling thread of run() waits until all jobs have been processed.
+	 *
+	 * @param[in] wait - set to true to wait for jobs which are still in process
+	 */
+	void work(const bool wait) {
+		boost::mutex::scoped_lock lock(this->mutex);
+		for (;;) {
+			if ( this->done ) return;
+			while (wait && this->queue.empty() && this->active > 0) {
+				this->idle++;
+				this->changed.wait(lock);
+				this->idle--;
+			}
+			if ( this->queue.empty() ) return;
+			Job & job(*(this->queue.front()));
+			this->queue.pop_front();
+			this->active++;
+			lock.unlock();
+			try {
+				this->process(job);
+			} catch (...) {
+				job.error = boost::current_exception();
+			}
+			lock.lock();
+			this->active--;
+			if (this->queue.empty() && this->active == 0) this->changed.notify_all();
+		}
+	}
+	
+	/**
+	 * Matches the next pattern path elements against the directory of the
+	 * given job. Matching sub directories are added as new jobs.
+	 *
+	 * @param[in,out] job - job to process
+	 */
+	void process(Job & job) {
+		const size_t count = this->elements.size();
+		boost::filesystem::path base(job.path);
+		size_t k = job.element;
+		/* append literal path elements */
+		for (; k < count && ( ! this->hasPattern(this->elements[k]) ); k++) {
+			if (this->elements[k] != L".") base /= this->unescapePattern(this->elements[k]);
+			if ((k + 1) == count) {
+				/* last element */
+				if (getEntryType(base, true) != ENTRY_MISSING) {
+					job.items.push_back(Item(base));
+				} else {
+					job.failed = true;
+				}
+				return;
+			}
+		}
+		if (k >= count) return;
+		std::vector<DirectoryEntry> entries;
+		if ( this->readDir ) {
+			this->readDir(entries, base);
+		} else {
+			readDirectory(entries, base);
+		}
+		if ( job.recursive ) {
+			/* match whole part from here */
+			std::wstring relativePattern(this->elements[k]);
+			for (size_t n = k + 1; n < count; n++) relativePattern.append(L"/").append(this->elements[n]);
+			BOOST_FOREACH(const DirectoryEntry & entry, entries) {
+				const boost::filesystem::path path(base / entry.name);
+				const boost::filesystem::path relative(job.relative / entry.name);
+				const std::wstring relativeStr(relative.generic_wstring(utf8));
+				/* symbolic links to directories are not followed */
+				const EntryType type = (entry.type == ENTRY_UNKNOWN) ? getEntryType(path, false) : entry.type;
+				if (this->isExcluded && this->isExcluded((type == ENTRY_DIRECTORY) ? relativeStr + L"/" : relativeStr)) continue;
+				if ( this->matchesPattern(relativeStr, relativePattern) ) {
+					job.items.push_back(Item(path));
+				}
+				if (type == ENTRY_DIRECTORY) {
+					/* skip sub directories which cannot contain any match */
+					if (this->matchesPatternPrefix && ( ! this->matchesPatternPrefix(relativeStr + L"/", relativePattern) )) continue;
+					job.items.push_back(Item(boost::filesystem::path(), this->enqueue(path, relative, k, true)));
+				}
+			}
+		} else {
+			/* match element-wise from here */
+			const std::wstring & pattern(this->elements[k]);
+			const bool last = ((k + 1) == count);
+			BOOST_FOREACH(const DirectoryEntry & entry, entries) {
+				if ( ! this->matchesPattern(entry.name.wstring(utf8), pattern) ) continue;
+				const boost::filesystem::path path(base / entry.name);
+				if ( last ) {
+					job.items.push_back(Item(path));
+					continue;
+				}
+				EntryType type = entry.type;
+				if (type == ENTRY_UNKNOWN || type == ENTRY_SYMLINK) type = getEntryType(path, true);
+				if (type == ENTRY_REGULAR) continue;
+				if (type == ENTRY_MISSING) {
+					job.items.push_back(Item(path, NULL, true));
+				} else {
+					job.items.push_back(Item(boost::filesystem::path(), this->enqueue(path, boost::filesystem::path(), k + 1, false)));
+				}
+			}
+		}
+	}
+	
+	/**
+	 * Appends the results of the given job and its sub directory jobs in order.
+	 * The merge stops at the first failed match like a sequential walk would do.
+	 *
+	 * @param[in,out] r - append matching paths to this vector
+	 * @param[in] job - merge results of this job
+	 * @return true on success, else false
+	 */
+	bool merge(std::vector<boost::filesystem::path> & r, const Job & job) const {
+		if ( job.error ) boost::rethrow_exception(job.error);
+		if ( job.failed ) return false;
+		BOOST_FOREACH(const Item & item, job.items) {
+			if ( item.failed ) return false;
+			if (item.child != NULL) {
+				if ( ! this->merge(r, *(item.child)) ) return false;
+			} else {
+				r.push_back(item.path);
+			}
+		}
+		return true;
+	}
+};
+
+
 /**
  * Adds a list of matching paths to the given output vector.
  * Elements that are already in the output vector are preserved.
@@ -580,13 +993,18 @@ boost::filesystem::path getExecutablePath(boost::system::error_code & errorCode)
  * @param[in] hasPattern - callback function to check if a path element contains a pattern
  * @param[in] unescapePattern - callback function to unescape a path element which contains a pattern (but only for literals)
  * @param[in] matchesPattern - callback function to check if a path element matches a pattern
+ * @param[in] readDir - callback function to read the entries of a directory (optional)
+ * @param[in] matchesPatternPrefix - callback function to check if a relative directory path can be the beginning of a match (optional, only for matchAll)
+ * @param[in] isExcluded - callback function to check if a relative path is excluded (optional, only for matchAll)
+ * @param[in] postTask - callback function to pass helper tasks for asynchronous execution (optional)
  * @return true on success, else false
- * @see CheckPatternCallback and MatchingCallback for callback definitions
+ * @remarks Sub directories are matched in parallel if postTask is given. Therefore, the callback functions need to be thread-safe.
+ * @see CheckPatternCallback, MatchingCallback, ReadDirectoryCallback, ExcludeCallback and PostTaskCallback for callback definitions
  */
-bool getMatchingPathList(std::vector<boost::filesystem::path> & r, const boost::filesystem::path & b, const boost::filesystem::path & p, const bool matchAll, const CheckPatternCallback & hasPattern, const UnescapePatternCallback & unescapePattern, const MatchingCallback & matchesPattern) {
+bool getMatchingPathList(std::vector<boost::filesystem::path> & r, const boost::filesystem::path & b, const boost::filesystem::path & p, const bool matchAll, const CheckPatternCallback & hasPattern, const UnescapePatternCallback & unescapePattern, const MatchingCallback & matchesPattern, const ReadDirectoryCallback & readDir, const MatchingCallback & matchesPatternPrefix, const ExcludeCallback & isExcluded, const PostTaskCallback & postTask) {
 	boost::filesystem::path realPath, basePath;
 	boost::system::error_code ec;
-	boost::filesystem::path::const_iterator next, i = p.begin();
+	boost::filesystem::path::const_iterator i = p.begin();
 	boost::filesystem::path::const_iterator end = p.end();
 	/* check pattern */
 	if ( p.empty() ) return true;
@@ -628,88 +1046,11 @@ bool getMatchingPathList(std::vector<boost::filesystem::path> & r, const boost::
 		r.push_back(realPath);
 		return true;
 	}
-	/* build string match list */
-	for(; i != end; i++) {
-		const std::wstring pattern(i->wstring(utf8));
-		next = i;
-		next++;
-		if ( hasPattern(pattern) ) {
-			/* string matching */
-			bool result = true;
-			if ( matchAll ) {
-				/* match whole part from here */
-				const bool removeBasePath = basePath.empty();
-				if ( removeBasePath ) basePath = boost::filesystem::current_path();
-				for (boost::filesystem::recursive_directory_iterator n(basePath), endN; n != endN; ++n) {
-					const std::wstring element(n->path().filename().wstring(utf8));
-					const std::wstring relativePart(removeBase(basePath, n->path()).generic_wstring(utf8));
-					const std::wstring relativePattern(buildPathFromIterator(i, end).generic_wstring(utf8));
-					if (element == L"." || element == L"..") continue;
-					if ( matchesPattern(relativePart, relativePattern) ) {
-						if ( removeBasePath ) {
-							r.push_back(relativePart);
-						} else {
-							r.push_back(realPath / relativePart);
-						}
-					}
-				}
-				break;
-			} else {
-				/* match element-wise from here */
-				const bool removeBasePath = basePath.empty();
-				if ( removeBasePath ) basePath = boost::filesystem::current_path();
-				for (boost::filesystem::directory_iterator n(basePath), endN; n != endN; ++n) {
-					const std::wstring element(n->path().filename().wstring(utf8));
-					if (element == L"." || element == L"..") continue;
-					if ( matchesPattern(element, pattern) ) {
-						if (next == end) {
-							if ( removeBasePath ) {
-								r.push_back(removeBase(basePath, n->path()));
-							} else {
-								r.push_back(n->path());
-							}
-						} else if ( ! boost::filesystem::is_regular_file(n->status()) ) {
-							if ( removeBasePath ) {
-								result = result && getMatchingPathList(
-									r,
-									boost::filesystem::path(),
-									buildPathFromIterator(removeBase(basePath, n->path()), next, end),
-									false,
-									hasPattern,
-									unescapePattern,
-									matchesPattern
-								);
-							} else {
-								result = result && getMatchingPathList(
-									r,
-									n->path(),
-									buildPathFromIterator(n->path(), next, end),
-									false,
-									hasPattern,
-									unescapePattern,
-									matchesPattern
-								);
-							}
-						}
-					}
-				}
-			}
-			if ( ! result ) return false;
-			break;
-		} else {
-			/* just copy path element */
-			basePath /= unescapePattern(i->wstring(utf8));
-			if (next == end) {
-				/* last element */
-				if (boost::filesystem::exists(basePath, ec) && ( ! ec )) {
-					r.push_back(basePath);
-				} else {
-					return false;
-				}
-			}
-		}
-	}
-	return true;
+	/* match the remaining path elements */
+	std::vector<std::wstring> elements;
+	for (; i != end; ++i) elements.push_back(i->wstring(utf8));
+	const boost::shared_ptr<DirectoryWalker> walker(boost::make_shared<DirectoryWalker>(elements, hasPattern, unescapePattern, matchesPattern, readDir, matchesPatternPrefix, isExcluded, postTask));
+	return walker->run(r, basePath, matchAll);
 }
 
 /**
@@ -719,10 +1060,12 @@ bool getMatchingPathList(std::vector<boost::filesystem::path> & r, const boost::
  * @param[in,out] r - output path vector
  * @param[in] p - wildcard path matching expression
  * @param[in] matchAll - set to true to check against all files recursively, false to match only path elements
+ * @param[in] readDir - callback function to read the entries of a directory (optional)
+ * @param[in] postTask - callback function to pass helper tasks for asynchronous execution (optional)
  * @return true on success, else false
  * @remarks Path matching is done case insensitive on Windows and case sensitive on any other platform.
  */
-bool getWildcardPathList(std::vector<boost::filesystem::path> & r, const std::wstring & p, const bool matchAll) {
+bool getWildcardPathList(std::vector<boost::filesystem::path> & r, const std::wstring & p, const bool matchAll, const ReadDirectoryCallback & readDir, const PostTaskCallback & postTask) {
 	/* callback function to decide whether a path element contains a pattern or not */
 	struct CheckPatternCallbackNamespace {
 		static bool isWildcardPattern(const std::wstring & str) {
@@ -755,11 +1098,172 @@ bool getWildcardPathList(std::vector<boost::filesystem::path> & r, const std::ws
 		matchAll,
 		CheckPatternCallbackNamespace::isWildcardPattern,
 		UnescapeCallbackNamespace::unescapeWildcardPattern,
-		MatchingCallbackNamespace::matchesWildcardPattern
+		MatchingCallbackNamespace::matchesWildcardPattern,
+		readDir,
+		MatchingCallback(),
+		ExcludeCallback(),
+		postTask
 	);
 }
 
 
+/**
+ * Compiles the given escaped path element pattern.
+ *
+ * @param[in] pattern - escaped path element pattern as passed to the matching callback
+ * @return compiled regular expression
+ * @throws pcf::exception::SyntaxError on regular expression syntax errors
+ */
+static boost::shared_ptr<const boost::wregex> compileRegexPattern(const std::wstring & pattern) {
+	using namespace boost::regex_constants;
+	std::wstring origPattern(pattern);
+	/* revert escape character from Unicode to ASCII version */
+	std::replace(origPattern.begin(), origPattern.end(), static_cast<std::wstring::value_type>(0x241B), L'\\');
+	std::replace(origPattern.begin(), origPattern.end(), static_cast<std::wstring::value_type>(0x241F), L':');
+	try {
+		return boost::make_shared<const boost::wregex>(
+			origPattern,
+			perl
+#if defined(PCF_IS_WIN)
+			| icase
+#endif /* PCF_IS_WIN */
+		);
+	} catch (std::invalid_argument &) {
+		BOOST_THROW_EXCEPTION(
+			pcf::exception::SyntaxError()
+			<< pcf::exception::tag::Message("Invalid regular expression: " + boost::locale::conv::utf_to_utf<char>(origPattern))
+		);
+	}
+	return boost::shared_ptr<const boost::wregex>();
+}
+
+
+/**
+ * Callback function object to match path elements against regular expressions. All patterns
+ * are compiled once on construction. Copies share the compiled patterns which are only read
+ * afterwards. Therefore, matching needs no locking.
+ *
+ * @see MatchingCallback
+ */
+class RegexPatternMatcher {
+private:
+	/** Map type of compiled path element regular expressions by their escaped pattern. */
+	typedef std::map< std::wstring, boost::shared_ptr<const boost::wregex> > PatternMap;
+	
+	boost::shared_ptr<const PatternMap> patterns; /**< Compiled regular expressions. */
+public:
+	/**
+	 * Constructor.
+	 *
+	 * @param[in] list - escaped path element patterns to compile
+	 * @throws pcf::exception::SyntaxError on regular expression syntax errors
+	 */
+	explicit RegexPatternMatcher(const std::vector<std::wstring> & list) {
+		const boost::shared_ptr<PatternMap> map(boost::make_shared<PatternMap>());
+		BOOST_FOREACH(const std::wstring & pattern, list) {
+			if (map->find(pattern) == map->end()) map->insert(std::make_pair(pattern, compileRegexPattern(pattern)));
+		}
+		this->patterns = map;
+	}
+	
+	/**
+	 * Checks whether the given path element matches the pattern.
+	 *
+	 * @param[in] str - match against this string
+	 * @param[in] pattern - escaped path element pattern
+	 * @return true on match, else false
+	 */
+	bool operator() (const std::wstring & str, const std::wstring & pattern) const {
+		return boost::regex_match(str, *(this->get(pattern)));
+	}
+	
+	/**
+	 * Checks whether the given relative directory path can be the beginning of a match.
+	 *
+	 * @param[in] str - match against this string
+	 * @param[in] pattern - escaped path element pattern
+	 * @return true on a partial or full match, else false
+	 */
+	bool matchesPrefix(const std::wstring & str, const std::wstring & pattern) const {
+		/* partial matches need to reach the end of the given string */
+		boost::match_results<std::wstring::const_iterator> what;
+		return boost::regex_search(str.begin(), str.end(), what, *(this->get(pattern)), boost::match_partial | boost::match_continuous);
+	}
+private:
+	/**
+	 * Returns the compiled regular expression for the given pattern. Patterns which were not
+	 * passed on construction are compiled for each call.
+	 *
+	 * @param[in] pattern - escaped path element pattern
+	 * @return compiled regular expression
+	 * @throws pcf::exception::SyntaxError on regular expression syntax errors
+	 */
+	boost::shared_ptr<const boost::wregex> get(const std::wstring & pattern) const {
+		const PatternMap::const_iterator it = this->patterns->find(pattern);
+		if (it != this->patterns->end()) return it->second;
+		return compileRegexPattern(pattern);
+	}
+};
+
+
+/**
+ * Callback function object to check relative paths against a list of regular expressions.
+ * Patterns ending with a slash only match directories. Patterns without any other slash are
+ * matched against the file name at any depth, all others against the whole relative path.
+ *
+ * @see ExcludeCallback
+ */
+class RegexExcludeMatcher {
+private:
+	/**
+	 * Structure of a single compiled exclude pattern.
+	 */
+	struct Pattern {
+		boost::shared_ptr<const boost::wregex> regex; /**< Compiled regular expression. */
+		bool directoryOnly; /**< Set to true if only directories are matched. */
+		bool wholePath; /**< Set to true to match the whole relative path instead of the file name. */
+	};
+	
+	std::vector<Pattern> patterns; /**< Compiled exclude patterns. */
+public:
+	/**
+	 * Constructor.
+	 *
+	 * @param[in] list - regular expressions of the excluded paths
+	 * @throws pcf::exception::SyntaxError on regular expression syntax errors
+	 */
+	explicit RegexExcludeMatcher(const std::vector<std::wstring> & list) {
+		BOOST_FOREACH(const std::wstring & str, list) {
+			if ( str.empty() ) continue;
+			Pattern pattern;
+			pattern.directoryOnly = (str[str.size() - 1] == L'/');
+			const std::wstring body(str, 0, pattern.directoryOnly ? str.size() - 1 : str.size());
+			pattern.wholePath = (body.find(L'/') != std::wstring::npos);
+			pattern.regex = compileRegexPattern(body);
+			this->patterns.push_back(pattern);
+		}
+	}
+	
+	/**
+	 * Checks whether the given relative path is excluded.
+	 *
+	 * @param[in] path - path relative to the walked root directory (directories end with a slash)
+	 * @return true if excluded, else false
+	 */
+	bool operator() (const std::wstring & path) const {
+		const bool isDirectory = (( ! path.empty() ) && path[path.size() - 1] == L'/');
+		const std::wstring relative(path, 0, isDirectory ? path.size() - 1 : path.size());
+		const size_t sep = relative.find_last_of(L'/');
+		const std::wstring name((sep == std::wstring::npos) ? relative : relative.substr(sep + 1));
+		BOOST_FOREACH(const Pattern & pattern, this->patterns) {
+			if (pattern.directoryOnly && ( ! isDirectory )) continue;
+			if ( boost::regex_match(pattern.wholePath ? relative : name, *(pattern.regex)) ) return true;
+		}
+		return false;
+	}
+};
+
+
 /**
  * Adds a list of matching paths to the given output vector.
  * Elements that are already in the output vector are preserved.
@@ -767,12 +1271,17 @@ bool getWildcardPathList(std::vector<boost::filesystem::path> & r, const std::ws
  * @param[in,out] r - output path vector
  * @param[in] p - regular expression for path matching
  * @param[in] matchAll - set to true to check against all files recursively, false to match only path elements
+ * @param[in] readDir - callback function to read the entries of a directory (optional)
+ * @param[in] exclude - regular expressions of paths skipped by the recursive match (optional, only for matchAll)
+ * @param[in] postTask - callback function to pass helper tasks for asynchronous execution (optional)
  * @return true on success, else false
  * @remarks Path matching is done case insensitive on Windows and case sensitive on any other platform.
  * @remarks The path separator needs to be / instead of \ on all platforms. Use correctSeparator() if needed.
+ * @remarks Sub directories which cannot contain a match of the recursive pattern are not walked.
  * @throws pcf::exception::SyntaxError on regular expression syntax errors
+ * @see RegexExcludeMatcher for the matching rules of exclude patterns
  */
-bool getRegexPathList(std::vector<boost::filesystem::path> & r, const std::wstring & p, const bool matchAll) {
+bool getRegexPathList(std::vector<boost::filesystem::path> & r, const std::wstring & p, const bool matchAll, const ReadDirectoryCallback & readDir, const std::vector<std::wstring> & exclude, const PostTaskCallback & postTask) {
 	/* callback function to decide whether a path element contains a pattern or not */
 	struct CheckPatternCallbackNamespace {
 		static bool isRegexPattern(const std::wstring & str) {
@@ -892,33 +1401,6 @@ bool getRegexPathList(std::vector<boost::filesystem::path> & r, const std::wstri
 		}
 	};
 	
-	/* callback function to check whether the given path element matches the pattern or not */
-	struct MatchingCallbackNamespace {
-		static bool matchesRegexPattern(const std::wstring & str, const std::wstring & pattern) {
-			using namespace boost::regex_constants;
-			std::wstring origPattern(pattern);
-			/* revert escape character from Unicode to ASCII version */
-			std::replace(origPattern.begin(), origPattern.end(), static_cast<std::wstring::value_type>(0x241B), L'\\');
-			std::replace(origPattern.begin(), origPattern.end(), static_cast<std::wstring::value_type>(0x241F), L':');
-			try {
-				boost::wregex regex(
-					origPattern,
-					perl
-#if defined(PCF_IS_WIN)
-					| icase
-#endif /* PCF_IS_WIN */
-				);
-				return boost::regex_match(str, regex);
-			} catch (std::invalid_argument &) {
-				BOOST_THROW_EXCEPTION(
-					pcf::exception::SyntaxError()
-					<< pcf::exception::tag::Message("Invalid regular expression: " + boost::locale::conv::utf_to_utf<char>(origPattern))
-				);
-			}
-			return false;
-		}
-	} ;
-	
 	/* replace escape character to enable the boost::filesystem::path iterator for paths */
 	std::wstring escapedPattern;
 	std::wstring::value_type lastChar(0);
@@ -951,20 +1433,157 @@ bool getRegexPathList(std::vector<boost::filesystem::path> & r, const std::wstri
 		lastChar = c;
 	}
 	if (escapedPattern.size() > 1 && escapedPattern[1] == 0x241F) escapedPattern[1] = L':';
+	const boost::filesystem::path escapedPath(escapedPattern, utf8);
+	
+	/* compile each pattern path element and each recursively matched remainder only once */
+	std::vector<std::wstring> elements, patterns;
+	for (boost::filesystem::path::const_iterator i = escapedPath.begin(), end = escapedPath.end(); i != end; ++i) {
+		elements.push_back(i->wstring(utf8));
+	}
+	for (size_t k = 0; k < elements.size(); k++) {
+		if ( ! CheckPatternCallbackNamespace::isRegexPattern(elements[k]) ) continue;
+		patterns.push_back(elements[k]);
+		if ( ! matchAll ) continue;
+		std::wstring relativePattern(elements[k]);
+		for (size_t n = k + 1; n < elements.size(); n++) relativePattern.append(L"/").append(elements[n]);
+		patterns.push_back(relativePattern);
+	}
+	const RegexPatternMatcher matcher(patterns);
 
 	return getMatchingPathList(
 		r,
 		boost::filesystem::path(),
-		boost::filesystem::path(escapedPattern, utf8),
+		escapedPath,
 		matchAll,
 		CheckPatternCallbackNamespace::isRegexPattern,
 		UnescapeCallbackNamespace::unescapeRegexPattern,
-		MatchingCallbackNamespace::matchesRegexPattern
+		matcher,
+		readDir,
+		boost::bind(&RegexPatternMatcher::matchesPrefix, matcher, _1, _2),
+		( exclude.empty() ) ? ExcludeCallback() : ExcludeCallback(RegexExcludeMatcher(exclude)),
+		postTask
 	);
 }
 
 
 
+/**
+ * Splits the given path string at each slash. Empty path elements are skipped.
+ *
+ * @param[in] str - path string with / as separator
+ * @return path elements
+ */
+static std::vector<std::wstring> splitGlobPath(const std::wstring & str) {
+	std::vector<std::wstring> result;
+	size_t start = 0;
+	while (start <= str.size()) {
+		size_t end = str.find(L'/', start);
+		if (end == std::wstring::npos) end = str.size();
+		if (end > start) result.push_back(str.substr(start, end - start));
+		start = end + 1;
+	}
+	return result;
+}
+
+
+/**
+ * Matches the path elements starting at the given index against the glob pattern elements
+ * starting at the given index. The pattern element ** matches zero or more path elements.
+ *
+ * @param[in] path - path elements
+ * @param[in] i - index of the next path element
+ * @param[in] pattern - glob pattern elements
+ * @param[in] k - index of the next glob pattern element
+ * @param[in] prefix - set to true to check if the path elements can be the beginning of a match
+ * @return true on match, else false
+ */
+static bool matchesGlobElements(const std::vector<std::wstring> & path, size_t i, const std::vector<std::wstring> & pattern, size_t k, const bool prefix) {
+	for (; k < pattern.size(); k++) {
+		if (pattern[k] == L"**") {
+			/* any directory below can contain a match */
+			if ( prefix ) return true;
+			for (size_t n = i; n <= path.size(); n++) {
+				if ( matchesGlobElements(path, n, pattern, k + 1, false) ) return true;
+			}
+			return false;
+		}
+		if (i >= path.size()) return prefix;
+#if defined(PCF_IS_WIN)
+		if ( ! pcf::string::matchWildcard(path[i], pattern[k], pcf::string::wildcardOption::CASE_INSENSITIVE) ) return false;
+#else /* ! PCF_IS_WIN */
+		if ( ! pcf::string::matchWildcard(path[i], pattern[k], pcf::string::wildcardOption::NONE) ) return false;
+#endif /* ! PCF_IS_WIN */
+		i++;
+	}
+	return ( ! prefix ) && i >= path.size();
+}
+
+
+/**
+ * Adds a list of matching paths to the given output vector.
+ * Elements that are already in the output vector are preserved.
+ * Valid wildcards within a path element are * for any number of characters, ? for exactly one
+ * character and # for exactly one digit. The path element ** matches zero or more directories.
+ *
+ * @param[in,out] r - output path vector
+ * @param[in] p - glob pattern for path matching
+ * @param[in] readDir - callback function to read the entries of a directory (optional)
+ * @param[in] exclude - regular expressions of paths skipped by the recursive match of ** (optional)
+ * @param[in] postTask - callback function to pass helper tasks for asynchronous execution (optional)
+ * @return true on success, else false
+ * @remarks Path matching is done case insensitive on Windows and case sensitive on any other platform.
+ * @remarks The path separator needs to be / instead of \ on all platforms. Use correctSeparator() if needed.
+ * @remarks Literal leading path elements are not matched and sub directories which cannot contain
+ * a match of the pattern are not walked.
+ * @throws pcf::exception::SyntaxError on regular expression syntax errors in exclude
+ * @see RegexExcludeMatcher for the matching rules of exclude patterns
+ */
+bool getGlobPathList(std::vector<boost::filesystem::path> & r, const std::wstring & p, const ReadDirectoryCallback & readDir, const std::vector<std::wstring> & exclude, const PostTaskCallback & postTask) {
+	/* callback function to decide whether a path element contains a pattern or not */
+	struct CheckPatternCallbackNamespace {
+		static bool isGlobPattern(const std::wstring & str) {
+			return (str.find_first_of(L"*?#") != std::wstring::npos);
+		}
+	};
+	
+	/* callback function to unescape a path element */
+	struct UnescapeCallbackNamespace {
+		static std::wstring unescapeGlobPattern(const std::wstring & str) {
+			return str;
+		}
+	};
+	
+	/* callback function to check whether the given path matches the pattern or not */
+	struct MatchingCallbackNamespace {
+		static bool matchesGlobPattern(const std::wstring & str, const std::wstring & pattern) {
+			return matchesGlobElements(splitGlobPath(str), 0, splitGlobPath(pattern), 0, false);
+		}
+		
+		static bool matchesGlobPatternPrefix(const std::wstring & str, const std::wstring & pattern) {
+			return matchesGlobElements(splitGlobPath(str), 0, splitGlobPath(pattern), 0, true);
+		}
+	};
+	
+	/* only walk recursively if a path element matches any number of directories */
+	const std::vector<std::wstring> elements(splitGlobPath(p));
+	const bool recursive = (std::find(elements.begin(), elements.end(), std::wstring(L"**")) != elements.end());
+	
+	return getMatchingPathList(
+		r,
+		boost::filesystem::path(),
+		boost::filesystem::path(p, utf8),
+		recursive,
+		CheckPatternCallbackNamespace::isGlobPattern,
+		UnescapeCallbackNamespace::unescapeGlobPattern,
+		MatchingCallbackNamespace::matchesGlobPattern,
+		readDir,
+		MatchingCallbackNamespace::matchesGlobPatternPrefix,
+		(exclude.empty() || ( ! recursive )) ? ExcludeCallback() : ExcludeCallback(RegexExcludeMatcher(exclude)),
+		postTask
+	);
+}
+
+
 Permission::Permission(const boost::filesystem::path & p):
 	path(p),
 	pExists(false),
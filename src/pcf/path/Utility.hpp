@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2013-2018 Daniel Starke
  * @date 2013-11-23
- * @version 2018-06-18
+ * @version 2026-10-17
  */
 #ifndef __LIBPCFXX_PATH_UTILITY_HPP__
 #define __LIBPCFXX_PATH_UTILITY_HPP__
@@ -46,6 +46,65 @@ typedef boost::function1<std::wstring, const std::wstring &> UnescapePatternCall
 typedef boost::function2<bool, const std::wstring &, const std::wstring &> MatchingCallback;
 
 
+/** 
+ * Defines a callback interface with:
+ * @param[in] string - path relative to the walked root directory (directories end with a slash)
+ * @return true if the path and everything below it shall be skipped, else false
+ */
+typedef boost::function1<bool, const std::wstring &> ExcludeCallback;
+
+
+/** 
+ * Defines a callback interface with:
+ * @param[in] task - function to execute asynchronously in any thread
+ * @remarks The task shall not be executed before the callback returns.
+ */
+typedef boost::function1<void, const boost::function0<void> &> PostTaskCallback;
+
+
+/**
+ * Enumeration of directory entry types as reported by readDirectory().
+ */
+enum EntryType {
+	ENTRY_UNKNOWN, /**< Type was not reported by the directory listing. */
+	ENTRY_MISSING, /**< Entry does not exist (e.g. broken symbolic link). */
+	ENTRY_REGULAR, /**< Regular file. */
+	ENTRY_DIRECTORY, /**< Directory. */
+	ENTRY_SYMLINK, /**< Symbolic link. */
+	ENTRY_OTHER /**< Any other file type. */
+};
+
+
+/**
+ * Structure of a single directory entry.
+ */
+struct DirectoryEntry {
+	boost::filesystem::path name; /**< File name of the entry. */
+	EntryType type; /**< Entry type without following symbolic links. */
+	
+	/**
+	 * Constructor.
+	 *
+	 * @param[in] n - file name
+	 * @param[in] t - entry type
+	 */
+	explicit DirectoryEntry(const boost::filesystem::path & n, const EntryType t):
+		name(n),
+		type(t)
+	{}
+};
+
+
+/** 
+ * Defines a callback interface with:
+ * @param[out] entries - append the directory entries in order here
+ * @param[in] directory - directory to read (empty for the current working directory)
+ * @throws boost::filesystem::filesystem_error if the directory could not be read
+ * @see readDirectory() for the default implementation
+ */
+typedef boost::function2<void, std::vector<DirectoryEntry> &, const boost::filesystem::path &> ReadDirectoryCallback;
+
+
 /**
  * Code conversion facet to transform from UTF-8 to std::wstring and back.
  */
@@ -61,9 +120,11 @@ LIBPCFXX_DLLPORT boost::filesystem::path LIBPCFXX_DECL resolveExecutable(const b
 LIBPCFXX_DLLPORT boost::filesystem::path LIBPCFXX_DECL resolveExecutable(const boost::filesystem::path & path, boost::system::error_code & errorCode);
 LIBPCFXX_DLLPORT boost::filesystem::path LIBPCFXX_DECL getExecutablePath();
 LIBPCFXX_DLLPORT boost::filesystem::path LIBPCFXX_DECL getExecutablePath(boost::system::error_code & errorCode);
-LIBPCFXX_DLLPORT bool LIBPCFXX_DECL getMatchingPathList(std::vector<boost::filesystem::path> & r, const boost::filesystem::path & b, const boost::filesystem::path & p, const bool matchAll, const CheckPatternCallback & hasPattern, const UnescapePatternCallback & unescapePattern, const MatchingCallback & matchesPattern);
-LIBPCFXX_DLLPORT bool LIBPCFXX_DECL getWildcardPathList(std::vector<boost::filesystem::path> & r, const std::wstring & p, const bool matchAll);
-LIBPCFXX_DLLPORT bool LIBPCFXX_DECL getRegexPathList(std::vector<boost::filesystem::path> & r, const std::wstring & p, const bool matchAll);
+LIBPCFXX_DLLPORT void LIBPCFXX_DECL readDirectory(std::vector<DirectoryEntry> & entries, const boost::filesystem::path & dir);
+LIBPCFXX_DLLPORT bool LIBPCFXX_DECL getMatchingPathList(std::vector<boost::filesystem::path> & r, const boost::filesystem::path & b, const boost::filesystem::path & p, const bool matchAll, const CheckPatternCallback & hasPattern, const UnescapePatternCallback & unescapePattern, const MatchingCallback & matchesPattern, const ReadDirectoryCallback & readDir = ReadDirectoryCallback(), const MatchingCallback & matchesPatternPrefix = MatchingCallback(), const ExcludeCallback & isExcluded = ExcludeCallback(), const PostTaskCallback & postTask = PostTaskCallback());
+LIBPCFXX_DLLPORT bool LIBPCFXX_DECL getWildcardPathList(std::vector<boost::filesystem::path> & r, const std::wstring & p, const bool matchAll, const ReadDirectoryCallback & readDir = ReadDirectoryCallback(), const PostTaskCallback & postTask = PostTaskCallback());
+LIBPCFXX_DLLPORT bool LIBPCFXX_DECL getRegexPathList(std::vector<boost::filesystem::path> & r, const std::wstring & p, const bool matchAll, const ReadDirectoryCallback & readDir = ReadDirectoryCallback(), const std::vector<std::wstring> & exclude = std::vector<std::wstring>(), const PostTaskCallback & postTask = PostTaskCallback());
+LIBPCFXX_DLLPORT bool LIBPCFXX_DECL getGlobPathList(std::vector<boost::filesystem::path> & r, const std::wstring & p, const ReadDirectoryCallback & readDir = ReadDirectoryCallback(), const std::vector<std::wstring> & exclude = std::vector<std::wstring>(), const PostTaskCallback & postTask = PostTaskCallback());
 
 
 /**
@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2014-2018 Daniel Starke
  * @date 2014-09-28
- * @version 2016-11-24
+ * @version 2026-10-17
  */
 #ifndef __LIBPCFXX_TIME_UTILITY_HPP__
 #define __LIBPCFXX_TIME_UTILITY_HPP__
@@ -65,6 +65,7 @@ protected:
 	value_type total; /**< Final progress state value. */
 	boost::optional<HistoryElement> startElement; /**< First history element every. */
 	boost::circular_buffer<HistoryElement> history; /**< History of progress needed to calculate ETA. */
+	boost::optional<boost::posix_time::time_duration> estimate; /**< Externally estimated remaining duration. */
 	mutable boost::mutex mutex; /** private mutex */
 public:
 	/**
@@ -98,7 +99,8 @@ public:
 		current(o.current),
 		total(o.total),
 		startElement(o.startElement),
-		history(o.history)
+		history(o.history),
+		estimate(o.estimate)
 	{}
 	
 	/**
@@ -113,6 +115,7 @@ public:
 			this->total = o.total;
 			this->startElement = o.startElement;
 			this->history = o.history;
+			this->estimate = o.estimate;
 		}
 		return *this;
 	}
@@ -129,6 +132,7 @@ public:
 		this->total = 0;
 		this->startElement = boost::optional<HistoryElement>();
 		this->history.clear();
+		this->estimate = boost::optional<boost::posix_time::time_duration>();
 		return *this;
 	}
 	
@@ -213,6 +217,30 @@ public:
 		return *this;
 	}
 	
+	/**
+	 * Sets an externally estimated remaining duration. This replaces the history based recent
+	 * ETA until it is removed by passing no value.
+	 *
+	 * @param[in] val - estimated remaining duration
+	 * @return referent to own instance for chained operations
+	 */
+	BasicProgressClock & setEstimate(const boost::optional<boost::posix_time::time_duration> & val) {
+		boost::mutex::scoped_lock lock(this->mutex);
+		this->estimate = val;
+		return *this;
+	}
+	
+	/**
+	 * Returns the externally estimated remaining duration.
+	 *
+	 * @return optional estimated remaining duration
+	 * @see setEstimate()
+	 */
+	boost::optional<boost::posix_time::time_duration> getEstimate() const {
+		boost::mutex::scoped_lock lock(this->mutex);
+		return this->estimate;
+	}
+	
 	/**
 	 * Returns the current progress state value.
 	 *
@@ -354,7 +382,7 @@ public:
 	 * Replacement prefixes:
 	 * @li %d - last update date
 	 * @li %l - last update time stamp
-	 * @li %r - recent average
+	 * @li %r - recent average (ETA as set by setEstimate() if available)
 	 * @li %g - global average
 	 * 
 	 * Direct replacements:
@@ -419,7 +447,8 @@ public:
 		const boost::optional<double> globalAvgSpeed = this->getAvgSpeed();
 		std::basic_string<CharT> avgSpeedStr, avgSpeedSize, recentAvgSpeedStr, recentAvgSpeedSize, globalAvgSpeedStr, globalAvgSpeedSize;
 		boost::optional<boost::posix_time::time_duration> eta;
-		const boost::optional<boost::posix_time::time_duration> recentEta(this->getEta(recentAvgSpeed));
+		const boost::optional<boost::posix_time::time_duration> estimatedEta(this->getEstimate());
+		const boost::optional<boost::posix_time::time_duration> recentEta(estimatedEta ? estimatedEta : this->getEta(recentAvgSpeed));
 		const boost::optional<boost::posix_time::time_duration> globalEta(this->getEta(globalAvgSpeed));
 		boost::posix_time::ptime lastDateTime;
 		enum {
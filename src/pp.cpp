@@ -3,17 +3,21 @@
  * @author Daniel Starke
  * @copyright Copyright 2015-2018 Daniel Starke
  * @date 2015-01-24
- * @version 2017-02-23
+ * @version 2026-10-17
  */
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <map>
+#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
 #include <utility>
+#include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/replace.hpp>
+#include <boost/algorithm/string/split.hpp>
 #include <boost/asio.hpp>
 /* workaround for boost::phoenix::bind and boost::bind namespace collision */
 #define BOOST_BIND_NO_PLACEHOLDERS
@@ -39,6 +43,8 @@
 #include <pcf/os/Signal.hpp>
 #include <pcf/os/Target.hpp>
 #include <pcf/string/Escape.hpp>
+#include "pp/FileWatcher.hpp"
+#include "pp/LoadController.hpp"
 #include "pp/Script.hpp"
 #include "pp/Utility.hpp"
 #include "license.hpp"
@@ -81,8 +87,13 @@ int posix_main(int argc, POSIX_ARG_TYPE ** argv, POSIX_ARG_TYPE ** enpv) {
 		po::positional_options_description descRemain;
 		bool build;
 		JobsArg jobs;
+		boost::uint64_t outputLimit;
+		boost::uint64_t timeTolerance;
+		vector<string> resourceList;
+		pp::ResourceMap resources;
 		bool printOnly;
 		string verbosity;
+		bool watch;
 		fs::path changeDir;
 		fs::path scriptFile;
 		vector<string> targetList;
@@ -110,9 +121,13 @@ int posix_main(int argc, POSIX_ARG_TYPE ** argv, POSIX_ARG_TYPE ** enpv) {
 			("help,h", "")
 			("jobs,j", po::value<JobsArg>(&jobs)->default_value(JobsArg(boost::thread::hardware_concurrency())), "")
 			("license", "")
+			("output-limit", po::value<boost::uint64_t>(&outputLimit)->default_value(1048576), "")
 			("print-only,n", po::value<bool>(&printOnly)->default_value(false)->implicit_value(true)->zero_tokens(), "")
+			("resources,r", po::value< vector<string> >(&resourceList)->composing(), "")
+			("time-tolerance", po::value<boost::uint64_t>(&timeTolerance)->default_value(1000), "")
 			("positional-parameter", po::_U(value)< vector<_U(string)> >()->multitoken()->zero_tokens(), "")
 			("verbosity,v", po::value<string>(&verbosity)->default_value(string("WARN")), "")
+			("watch,w", po::value<bool>(&watch)->default_value(false)->implicit_value(true)->zero_tokens(), "")
 		;
 		descRemain.add("positional-parameter", -1);
 		po::store(
@@ -161,6 +176,20 @@ int posix_main(int argc, POSIX_ARG_TYPE ** argv, POSIX_ARG_TYPE ** enpv) {
 			targetList.push_back("default");
 		}
 
+		/* parse resource budgets */
+		BOOST_FOREACH(const string & list, resourceList) {
+			vector<string> budgets;
+			boost::algorithm::split(budgets, list, boost::algorithm::is_any_of(","));
+			BOOST_FOREACH(const string & budget, budgets) {
+				const optional<pp::ResourceMap::value_type> resource = pp::getResourcePair(budget);
+				if ( ! resource ) {
+					cerr << "Error: Invalid resource budget \"" << budget << "\"." << endl;
+					return EXIT_FAILURE;
+				}
+				resources[resource->first] = resource->second;
+			}
+		}
+
 		/* change directory if set */
 		if ( vm.count("change-directory") ) {
 			boost::filesystem::current_path(changeDir, ec);
@@ -210,6 +239,8 @@ int posix_main(int argc, POSIX_ARG_TYPE ** argv, POSIX_ARG_TYPE ** enpv) {
 		config.removeTemporaries = true;
 		config.cleanUpIncompletes = true;
 		config.removeRemains = true;
+		config.outputLimit = outputLimit;
+		config.modificationTolerance = pt::milliseconds(static_cast<long>(timeTolerance));
 		if ( vm["verbosity"].defaulted() ) {
 			config.lockedVerbosity = false;
 		} else {
@@ -223,11 +254,19 @@ int posix_main(int argc, POSIX_ARG_TYPE ** argv, POSIX_ARG_TYPE ** enpv) {
 		script.setProgressFormat("%dY-%dM-%dD %lH:%lM:%lS: %c / %t commands executed, %p%%, ETA %re\n"); /* default format string */
 		script.read(scriptFile);
 		config.verbosity = script.getVerbosity(); /* get updated verbosity level */
-		const bool printOnlyFlag = config.printOnly;
 		bool isFirst = true;
 		volatile bool stopped = false;
 		boost::asio::io_service ioService;
 		boost::scoped_ptr<boost::asio::io_service::work> workNotifier;
+		pp::Scheduler scheduler(ioService, jobs, resources);
+		pp::LoadController loadController(scheduler, config.verbosity);
+#ifdef PCF_IS_WIN
+		/* commands block their worker thread until they finished */
+		const size_t threads = jobs;
+#else /* not Windows */
+		/* command outputs are handled asynchronously; jobs only limits the number of running commands */
+		const size_t threads = std::max<size_t>(std::min<size_t>(jobs, boost::thread::hardware_concurrency()), 1);
+#endif /* Windows */
 		pcf::os::BackgroundSignalHandler signals(
 			boost::bind(&terminate, boost::ref(ioService), boost::ref(workNotifier), boost::ref(stopped), config.verbosity >= pp::VERBOSITY_DEBUG),
 			SIGINT,
@@ -235,46 +274,89 @@ int posix_main(int argc, POSIX_ARG_TYPE ** argv, POSIX_ARG_TYPE ** enpv) {
 		);
 		signals.asyncWaitForSignal();
 		
-		/* process targets from command-line */
-		BOOST_FOREACH(const string & target, targetList) {
-			bool successfullyPrepared = true;
-			
-			/* prepare parallel tasks (might throw an exception) */
-			if ( ! script.prepare(target) ) successfullyPrepared = false;
-			
-			/* initialize workers */
-			ioService.reset();
-			workNotifier.reset(new boost::asio::io_service::work(ioService));
-			boost::thread_group workerThreads;
-			if (( ! printOnlyFlag) || successfullyPrepared) {
-				/* start execution jobs */
-				if (config.verbosity >= pp::VERBOSITY_DEBUG) cerr << "pp: starting " << jobs << " worker threads" << endl;
-				for (size_t job = 1; job <= jobs; job++) {
+		/* adapt the number of concurrently running commands to the system load */
+		if ( jobs.adaptive ) loadController.start();
+		
+		/* process targets from command-line; repeated on changes in watch mode */
+		boost::scoped_ptr<pp::FileWatcher> watcher;
+		pp::FileWatcher::PathSet watchPaths, watchOutputs, changed;
+		std::set<string> preparedTargets;
+		if ( watch ) watcher.reset(new pp::FileWatcher());
+		for (;;) {
+			pp::FileWatcher::PathSet paths, outputs;
+			BOOST_FOREACH(const string & target, targetList) {
+				bool successfullyPrepared = true;
+				
+				/* initialize workers (also used to prepare independent dependency trees in parallel) */
+				ioService.reset();
+				workNotifier.reset(new boost::asio::io_service::work(ioService));
+				boost::thread_group workerThreads;
+				if (config.verbosity >= pp::VERBOSITY_DEBUG) cerr << "pp: starting " << threads << " worker threads for " << jobs << " jobs" << endl;
+				for (size_t worker = 1; worker <= threads; worker++) {
 					workerThreads.create_thread(
 						boost::bind(&boost::asio::io_service::run, &ioService)
 					);
 				}
 				if (config.verbosity >= pp::VERBOSITY_DEBUG) cerr << "pp: finished starting worker threads" << endl;
-			}
-			
-			/* perform parallel tasks */
-			if ( successfullyPrepared ) script.execute(target, ioService);
-			
-			/* wait until workers are done */
-			workNotifier.reset();
-			if (( ! printOnlyFlag) || successfullyPrepared) {
+				
+				/* prepare parallel tasks (might throw an exception) */
+				try {
+					/* keep the prepared dependency tree if only the content of known files changed */
+					const bool updated = preparedTargets.erase(target) > 0 && script.update(target, changed, scheduler);
+					if (( ! updated ) && ( ! script.prepare(target, scheduler) )) successfullyPrepared = false;
+				} catch (...) {
+					workNotifier.reset();
+					workerThreads.join_all();
+					throw;
+				}
+				
+				/* watch before executing to catch changes made while the commands are running */
+				if ( watcher ) {
+					script.getWatchPaths(target, paths, outputs);
+					watchPaths.insert(paths.begin(), paths.end());
+					watchOutputs.insert(outputs.begin(), outputs.end());
+					watcher->setPaths(watchPaths, watchOutputs);
+					if ( successfullyPrepared ) preparedTargets.insert(target);
+				}
+				
+				/* perform parallel tasks */
+				if ( successfullyPrepared ) script.execute(target, scheduler, isFirst);
+				
+				/* wait until workers are done */
+				workNotifier.reset();
 				if (config.verbosity >= pp::VERBOSITY_DEBUG) cerr << "pp: waiting for worker threads to finish" << endl;
 				workerThreads.join_all();
 				if (config.verbosity >= pp::VERBOSITY_DEBUG) cerr << "pp: all workers finished" << endl;
 				if ( successfullyPrepared ) {
 					script.complete(target, isFirst);
 				}
+				
+				/* handle execution termination via signal */
+				if ( stopped ) break;
 			}
 			
-			/* handle execution termination via signal */
-			if ( stopped ) break;
+			if (( ! watcher ) || stopped) break;
+			
+			/* stop watching paths which are no longer needed; changes made during the execution are kept */
+			watchPaths.swap(paths);
+			watchOutputs.swap(outputs);
+			watcher->setPaths(watchPaths, watchOutputs);
+			if (config.verbosity >= pp::VERBOSITY_INFO) cout << "Watching " << watchPaths.size() << " paths for changes." << endl;
+			
+			/* wait for changes of the input and dependency files */
+			if ( ! watcher->wait(changed, stopped) ) break;
+			if (changed.find(fs::path()) != changed.end()) {
+				/* changes were lost */
+				config.fileStatus->clear();
+			} else {
+				BOOST_FOREACH(const fs::path & path, changed) {
+					config.fileStatus->invalidate(path);
+				}
+			}
+			if (config.verbosity >= pp::VERBOSITY_INFO) cout << "Detected changes in " << changed.size() << " paths." << endl;
 		}
 		
+		loadController.stop();
 		signals.cancel();
 	} catch (const pcf::exception::Script & e) {
 		if (const string * errMsg = boost::get_error_info<pcf::exception::tag::Message>(e)) {
@@ -339,7 +421,7 @@ void terminate(boost::asio::io_service & ios, boost::scoped_ptr<boost::asio::io_
  */
 void printHelp() {
 	cout <<
-	"pp -bCf?hj?nv? [<target> ...] [<variable>=<value> ...]\n"
+	"pp -bCf?hj?nr?v?w [<target> ...] [<variable>=<value> ...]\n"
 	"\n"
 	" -b, --build\n"
 	"  Forces all parts to be executed.\n"
@@ -350,17 +432,36 @@ void printHelp() {
 	"  The default value is \"process.parallel\".\n"
 	" -h, --help\n"
 	"  Prints out this description.\n"
-	" -j, --jobs <number>\n"
-	"  Execute with the given number of threads. It is possible to define this value\n"
-	"  in percent of available cores. The default is the number of virtual cores.\n"
+	" -j, --jobs <number>|auto[:<number>]\n"
+	"  Execute the given number of commands in parallel. It is possible to define this\n"
+	"  value in percent of available cores. The default is the number of virtual cores.\n"
+	"  With auto the number is adapted to the system load, pressure stall information\n"
+	"  and available memory without exceeding the given upper bound.\n"
 	" --license\n"
 	"  Displays the licenses for this program.\n"
+	" --output-limit <number>\n"
+	"  Number of output bytes per command kept in memory. Larger outputs are moved to a\n"
+	"  temporary file. The default is 1048576. Set to 0 to keep all output in memory.\n"
 	" -n, --print-only\n"
 	"  Only prints the commands that would had been executed.\n"
+	" -r, --resources <resource>=<amount>[,...]\n"
+	"  Limits the total amount of the given resources required by concurrently running\n"
+	"  commands. Processes define their requirements via @resources. Amounts may end\n"
+	"  with K, M, G or T. Example: -r cpu=16,mem=64G\n"
+	" --time-tolerance <number>\n"
+	"  Milliseconds an input file needs to be newer than its output file to be considered\n"
+	"  as modified. Values of 1000 and above compare whole seconds. The default is 1000,\n"
+	"  i.e. the input file needs to be changed in a later second than the output file.\n"
+	"  Lower values detect changes within the same second on file systems with\n"
+	"  sub-second time stamps.\n"
 	" -v, --verbosity <enumeration>\n"
 	"  Sets the verbosity level. Default is WARN. Setting this overwrites all\n"
 	"  verbosity settings in the script making this the only verbosity level.\n"
 	"  Possible values are ERROR, WARN, INFO and DEBUG.\n"
+	" -w, --watch\n"
+	"  Keeps running after the targets were executed and executes them again whenever\n"
+	"  one of their input or dependency files changes. Only transitions affected by the\n"
+	"  change are executed. Stop with Ctrl+C.\n"
 	"\n"
 	"target\n"
 	"  Execute these targets in sequence.\n"
@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2015-2018 Daniel Starke
  * @date 2015-01-24
- * @version 2016-12-30
+ * @version 2026-10-17
  */
 #ifndef __PP_HPP__
 #define __PP_HPP__
@@ -25,7 +25,6 @@
 #include <boost/optional.hpp>
 #include <boost/program_options.hpp>
 #include <boost/scoped_ptr.hpp>
-#include <boost/serialization/strong_typedef.hpp>
 /* workaround for boost::phoenix::bind and boost::bind namespace collision */
 #define BOOST_BIND_NO_PLACEHOLDERS
 #include <boost/thread/thread.hpp>
@@ -42,27 +41,57 @@ namespace fs = ::boost::filesystem;
 namespace po = ::boost::program_options;
 
 
-/* needed for template specialization of validate() */
-BOOST_STRONG_TYPEDEF(size_t, JobsArg)
+/**
+ * Number of concurrently executed commands as passed via command-line.
+ * Also needed for template specialization of validate().
+ */
+struct JobsArg {
+	size_t value; /**< Maximum number of concurrently executed commands. */
+	bool adaptive; /**< Adapt the number of concurrently executed commands to the system load. */
+	
+	/**
+	 * Default constructor.
+	 */
+	JobsArg():
+		value(1),
+		adaptive(false)
+	{}
+	
+	/**
+	 * Constructor.
+	 *
+	 * @param[in] v - maximum number of concurrently executed commands
+	 * @param[in] a - adapt the number of concurrently executed commands to the system load
+	 */
+	explicit JobsArg(const size_t v, const bool a = false):
+		value(v),
+		adaptive(a)
+	{}
+	
+	/**
+	 * Returns the maximum number of concurrently executed commands.
+	 *
+	 * @return number of jobs
+	 */
+	operator size_t() const {
+		return this->value;
+	}
+};
 
 
 /**
- * Called by boost::program_options to parse a JobsArg argument.
+ * Parses the given number of jobs. The value may be given in percent of the available cores.
  *
- * @param[in,out] v - variable storage
- * @param[in] values - input argument vector
- * @param[in] - workaround parameter for partial template specialization
- * @param[in] - workaround parameter for partial template specialization
+ * @param[in] str - string to parse
+ * @return number of jobs
+ * @throw po::validation_error on invalid input
  * @tparam CharT - character type
- * @see http://www.boost.org/doc/libs/1_54_0/doc/html/program_options/howto.html#idp123425568
  */
 template <typename CharT>
-void validate(boost::any & v, const vector< basic_string<CharT> > & values, JobsArg *, int) {
-	po::validators::check_first_occurrence(v);
-	if (values.size() != 1) throw po::validation_error(po::validation_error::invalid_option_value);
+size_t parseJobs(const basic_string<CharT> & str) {
 	bool inPercent(false), hasDecimalComma(false);
 	basic_string<CharT> valToParse;
-	BOOST_FOREACH(const CharT c, values[0]) {
+	BOOST_FOREACH(const CharT c, str) {
 		if ( ::isdigit(static_cast<int>(c)) ) {
 			if ( inPercent ) throw po::validation_error(po::validation_error::invalid_option_value);
 			valToParse.push_back(c);
@@ -80,10 +109,10 @@ void validate(boost::any & v, const vector< basic_string<CharT> > & values, Jobs
 		if ( inPercent ) {
 			const long long jobs = boost::math::llround(static_cast<float>(boost::thread::hardware_concurrency()) * boost::lexical_cast<float>(valToParse) / 100.0f);
 			if (jobs < 0) throw po::validation_error(po::validation_error::invalid_option_value);
-			v = boost::any(static_cast<JobsArg>(static_cast<size_t>(jobs < 1 ? 1 : jobs)));
+			return static_cast<size_t>(jobs < 1 ? 1 : jobs);
 		} else {
 			const size_t jobs = boost::lexical_cast<size_t>(valToParse);
-			v = boost::any(static_cast<JobsArg>(jobs < 1 ? boost::thread::hardware_concurrency() : jobs));
+			return jobs < 1 ? boost::thread::hardware_concurrency() : jobs;
 		}
 	} catch (...) {
 		throw po::validation_error(po::validation_error::invalid_option_value);
@@ -91,6 +120,41 @@ void validate(boost::any & v, const vector< basic_string<CharT> > & values, Jobs
 }
 
 
+/**
+ * Called by boost::program_options to parse a JobsArg argument.
+ * The value "auto" enables adaptive concurrency. An upper bound can be appended
+ * separated by a colon (e.g. "auto:32" or "auto:200%"). The default upper bound
+ * is the number of available cores.
+ *
+ * @param[in,out] v - variable storage
+ * @param[in] values - input argument vector
+ * @param[in] - workaround parameter for partial template specialization
+ * @param[in] - workaround parameter for partial template specialization
+ * @tparam CharT - character type
+ * @see http://www.boost.org/doc/libs/1_54_0/doc/html/program_options/howto.html#idp123425568
+ */
+template <typename CharT>
+void validate(boost::any & v, const vector< basic_string<CharT> > & values, JobsArg *, int) {
+	static const char autoStr[] = "auto";
+	po::validators::check_first_occurrence(v);
+	if (values.size() != 1) throw po::validation_error(po::validation_error::invalid_option_value);
+	const basic_string<CharT> & str = values[0];
+	size_t i = 0;
+	for (; autoStr[i] != 0 && i < str.size(); i++) {
+		if (str[i] != static_cast<CharT>(autoStr[i])) break;
+	}
+	if (autoStr[i] != 0) {
+		v = boost::any(JobsArg(parseJobs(str)));
+	} else if (i == str.size()) {
+		v = boost::any(JobsArg(boost::thread::hardware_concurrency(), true));
+	} else if (str[i] == static_cast<CharT>(':')) {
+		v = boost::any(JobsArg(parseJobs(str.substr(i + 1)), true));
+	} else {
+		throw po::validation_error(po::validation_error::invalid_option_value);
+	}
+}
+
+
 void terminate(boost::asio::io_service & ios, boost::scoped_ptr<boost::asio::io_service::work> & wn, volatile bool & stopped, const bool outputInfo);
 void printHelp();
 void printLicense();
@@ -3,36 +3,62 @@
  * @author Daniel Starke
  * @copyright Copyright 2015-2018 Daniel Starke
  * @date 2015-03-22
- * @version 2017-01-10
+ * @version 2026-10-17
  */
 #ifndef __PP_COMMAND_HPP__
 #define __PP_COMMAND_HPP__
 
 
+#include <algorithm>
+#include <cerrno>
 #include <cstdlib>
 #include <iosfwd>
 #include <sstream>
 #include <string>
-#include <boost/algorithm/cxx11/all_of.hpp>
-#include <boost/algorithm/string/classification.hpp>
+#include <boost/array.hpp>
+#include <boost/asio.hpp>
 #include <boost/config/warning_disable.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/date_time/gregorian/gregorian_types.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
 #include <boost/format.hpp>
+#include <boost/function.hpp>
+#include <boost/iostreams/device/file_descriptor.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <boost/lexical_cast.hpp>
 #include <boost/locale.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+#include <boost/phoenix/bind.hpp>
+#include <boost/phoenix/core.hpp>
+#include <boost/ref.hpp>
 #include <boost/shared_ptr.hpp>
 /* workaround for boost::phoenix::bind and boost::bind namespace collision */
 #define BOOST_BIND_NO_PLACEHOLDERS
 #include <boost/thread/thread.hpp>
 #undef BOOST_BIND_NO_PLACEHOLDERS
 #include <pcf/exception/General.hpp>
+#include <pcf/file/Stream.hpp>
 #include <pcf/os/Target.hpp>
 #include <pcf/process/Utility.hpp>
 #include "Variable.hpp"
 #include "Type.hpp"
 
 
+#ifndef PCF_IS_WIN
+extern "C" {
+#include <unistd.h>
+#include <sys/wait.h>
+#ifdef PCF_IS_LINUX
+#include <sys/syscall.h>
+#endif /* Linux */
+}
+#endif /* not Windows */
+
+
 namespace pp {
 
 
@@ -45,6 +71,8 @@ class Command {
 template <typename Iterator, typename Skipper>
 friend struct parser::Script;
 public:
+	/** Callback function type for asynchronous execution. */
+	typedef boost::function1<void, const bool> CallbackType;
 	/** Possible command states. */
 	enum State {
 		IDLE,     /**< The command was not started yet. */
@@ -53,18 +81,25 @@ public:
 		FAILED    /**< An error occurred running the command. */
 	};
 private:
+	struct OutputFile;
+	
 	boost::shared_ptr<Shell> shell; /**< Description of the used shell. */
 	StringLiteral command; /**< The command to execute. */
 	boost::posix_time::ptime startDt; /**< Start date time. */
 	boost::posix_time::ptime endDt; /**< End date time. */
-	std::string output; /**< Command output. */
+	std::string output; /**< Command output kept in memory. */
+	boost::shared_ptr<OutputFile> outputFile; /**< Temporary file with the command output if it exceeded outputLimit. */
+	boost::uint64_t outputSize; /**< Total size of the command output in bytes. */
+	boost::uint64_t outputLimit; /**< Maximum command output size in bytes kept in memory (0 for unlimited). */
 	std::string threadId; /**< Content for PP_THREAD. */
 	int exitCode; /**< Command exit code. */
 	State state; /**< Current command state. @see State */
 	mutable boost::mutex mutex; /**< Command mutex. */
 public:
 	/** Default constructor. */
-	explicit Command() {
+	explicit Command():
+		outputLimit(0)
+	{
 		this->reset();
 	}
 	
@@ -77,6 +112,8 @@ public:
 	explicit Command(const boost::shared_ptr<Shell> & sh, const StringLiteral & cmd):
 		shell(sh),
 		command(cmd),
+		outputSize(0),
+		outputLimit(0),
 		state(IDLE)
 	{
 		this->updateThreadId();
@@ -99,6 +136,9 @@ public:
 		startDt(o.startDt),
 		endDt(o.endDt),
 		output(o.output),
+		outputFile(o.outputFile),
+		outputSize(o.outputSize),
+		outputLimit(o.outputLimit),
 		threadId(o.threadId),
 		exitCode(o.exitCode),
 		state(o.state)
@@ -117,6 +157,9 @@ public:
 			this->startDt = o.startDt;
 			this->endDt = o.endDt;
 			this->output = o.output;
+			this->outputFile = o.outputFile;
+			this->outputSize = o.outputSize;
+			this->outputLimit = o.outputLimit;
 			this->threadId = o.threadId;
 			this->exitCode = o.exitCode;
 			this->state = o.state;
@@ -223,7 +266,30 @@ public:
 	 * @return command output
 	 */
 	std::string getOutput() const {
-		return this->output;
+		if ( ! this->outputFile ) return this->output;
+		std::ostringstream sout;
+		const boost::shared_ptr<std::istream> in(this->openOutput());
+		sout << in->rdbuf();
+		return sout.str();
+	}
+	
+	/**
+	 * Returns the size of the command output. This remains valid after clearOutput().
+	 *
+	 * @return command output size in bytes
+	 */
+	boost::uint64_t getOutputSize() const {
+		return this->outputSize;
+	}
+	
+	/**
+	 * Releases the memory and temporary file used for the command output.
+	 * The command output is no longer available afterwards.
+	 */
+	void clearOutput() {
+		boost::mutex::scoped_lock lock(this->mutex);
+		std::string().swap(this->output);
+		this->outputFile.reset();
 	}
 	
 	/**
@@ -243,6 +309,8 @@ public:
 		this->startDt = boost::posix_time::ptime();
 		this->endDt = boost::posix_time::ptime();
 		this->output.clear();
+		this->outputFile.reset();
+		this->outputSize = 0;
 		this->threadId.clear();
 		this->exitCode = 0;
 		this->state = IDLE;
@@ -269,17 +337,33 @@ public:
 			<< ProcessTransition::reasonMap[2][(reasonFlags & (1 << 2)) == 0 ? 0 : 1]
 			<< "] " <<  this->getFinalCommandString().getString() << '\n';
 		wroteOutput = true;
-		std::string newOutput;
+		boost::array<char, 4096> buffer;
 		char lastChar = '\n';
-		newOutput.reserve(this->output.size());
-		BOOST_FOREACH(const char c, this->output) {
-			if (c != '\r') {
-				newOutput.push_back(c);
-				lastChar = c;
+		bool hasText = false;
+		/* check whether the output contains more than white-spaces */
+		{
+			const boost::shared_ptr<std::istream> in(this->openOutput());
+			while ( ! hasText ) {
+				const std::streamsize size = in->read(buffer.data(), static_cast<std::streamsize>(buffer.size())).gcount();
+				if (size <= 0) break;
+				BOOST_FOREACH(const char c, std::make_pair(buffer.data(), buffer.data() + size)) {
+					if (c == '\r') continue;
+					lastChar = c;
+					if (c != ' ' && c != '\t' && c != '\n') hasText = true;
+				}
 			}
 		}
-		if ( ! boost::algorithm::all_of(newOutput.begin(), newOutput.end(), boost::algorithm::is_any_of(" \t\n\r")) ) {
-			out.write(newOutput.c_str(), static_cast<std::streamsize>(newOutput.size()));
+		/* write output without carriage returns */
+		if ( hasText ) {
+			const boost::shared_ptr<std::istream> in(this->openOutput());
+			for (;;) {
+				const std::streamsize size = in->read(buffer.data(), static_cast<std::streamsize>(buffer.size())).gcount();
+				if (size <= 0) break;
+				char * const end = std::remove(buffer.data(), buffer.data() + size, '\r');
+				if (end == buffer.data()) continue;
+				out.write(buffer.data(), static_cast<std::streamsize>(end - buffer.data()));
+				lastChar = *(end - 1);
+			}
 		}
 		if (lastChar != '\n') out << '\n';
 		if (this->exitCode == 0) {
@@ -313,6 +397,7 @@ public:
 		std::string unknownVariable;
 		this->reset();
 		boost::mutex::scoped_lock lock(this->mutex);
+		this->outputLimit = config.outputLimit;
 		DynamicVariableSet stillDynamic;
 		stillDynamic.insert("PP_THREAD");
 		if ( ! this->command.replaceVariables(unknownVariable, vars, stillDynamic) ) {
@@ -341,8 +426,274 @@ public:
 	 */
 	bool execute(const bool checkCommand = false) {
 		boost::mutex::scoped_lock lock(this->mutex);
-		this->state = RUNNING;
 		this->updateThreadId();
+		boost::optional<pcf::process::ProcessPipe> proc(this->start());
+		if ( ! proc ) return false;
+		lock.unlock();
+		this->readOutput(*proc);
+		lock.lock();
+		return this->finish(*proc, checkCommand);
+	}
+	
+#ifndef PCF_IS_WIN
+	/**
+	 * Starts the internal command and returns immediately. The command output is collected
+	 * and the process exit is awaited asynchronously by the given I/O service. The passed
+	 * callback is called once the command output was closed and the process has exited.
+	 *
+	 * @param[in,out] ioService - I/O service to use for the command output handling
+	 * @param[in] slot - execution slot number used as value for PP_THREAD
+	 * @param[in] checkCommand - sets the internal state to FAILED if the command returns
+	 * an exit code different from 0
+	 * @param[in] callFinished - callback function called with the return value of execute()
+	 * @remarks the command is blocked for subsequently executions until it has finished execution
+	 */
+	void executeAsync(boost::asio::io_service & ioService, const size_t slot, const bool checkCommand, const CallbackType & callFinished) {
+		boost::mutex::scoped_lock lock(this->mutex);
+		this->threadId = boost::lexical_cast<std::string>(slot);
+		boost::optional<pcf::process::ProcessPipe> proc(this->start());
+		if ( ! proc ) {
+			lock.unlock();
+			if ( callFinished ) callFinished(false);
+			return;
+		}
+		boost::shared_ptr<AsyncContext> context;
+		try {
+			context = boost::make_shared<AsyncContext>(boost::ref(ioService), *proc, checkCommand, callFinished);
+		} catch (const boost::system::system_error &) {
+			/* failed to duplicate the output pipe handle */
+			context.reset();
+		}
+		lock.unlock();
+		if ( ! context ) {
+			/* fall back to synchronous read */
+			this->readOutput(*proc);
+			lock.lock();
+			const bool result = this->finish(*proc, checkCommand);
+			lock.unlock();
+			if ( callFinished ) callFinished(result);
+			return;
+		}
+		this->readAsync(context);
+		this->waitExitAsync(context);
+	}
+#endif /* not Windows */
+private:
+	/**
+	 * Temporary file holding the command output. The file is removed on destruction.
+	 *
+	 * @internal
+	 */
+	struct OutputFile : private boost::noncopyable {
+		boost::filesystem::path filePath; /**< Path to the temporary file. */
+		pcf::file::ofstream out; /**< Output stream to the temporary file. */
+		
+		/**
+		 * Constructor. Creates a new temporary file.
+		 *
+		 * @throws std::exception if the temporary file could not be created
+		 */
+		explicit OutputFile():
+			filePath(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("pp-%%%%-%%%%-%%%%-%%%%.out")),
+			out(filePath, std::ofstream::trunc | std::ofstream::out)
+		{}
+		
+		/**
+		 * Destructor. Removes the temporary file.
+		 */
+		~OutputFile() {
+			boost::system::error_code ec;
+			try {
+				if ( this->out.is_open() ) this->out.close();
+			} catch (...) {}
+			boost::filesystem::remove(this->filePath, ec);
+		}
+	};
+	
+#ifndef PCF_IS_WIN
+	/**
+	 * Holds the states of an asynchronous command execution.
+	 *
+	 * @internal
+	 */
+	struct AsyncContext {
+		pcf::process::ProcessPipe proc; /**< Handle of the running process. */
+		boost::asio::posix::stream_descriptor pipe; /**< Asynchronous handle to the process output. */
+		boost::asio::posix::stream_descriptor exitHandle; /**< Process file descriptor which becomes readable on exit (Linux only). */
+		boost::asio::deadline_timer exitTimer; /**< Timer to poll for the process exit if no process file descriptor is available. */
+		boost::array<char, 4096> buffer; /**< Read buffer. */
+		bool checkCommand; /**< Set to true to check the command exit code. */
+		bool outputClosed; /**< Set to true once the end of the command output was reached. */
+		bool exited; /**< Set to true once the process has exited. */
+		CallbackType callFinished; /**< Callback function called after command execution. */
+		
+		/**
+		 * Constructor.
+		 *
+		 * @param[in,out] ioService - I/O service to use for the command output handling
+		 * @param[in] p - handle of the running process
+		 * @param[in] check - set to true to check the command exit code
+		 * @param[in] callback - callback function called after command execution
+		 * @throws boost::system::system_error if the output handle could not be duplicated
+		 */
+		explicit AsyncContext(boost::asio::io_service & ioService, const pcf::process::ProcessPipe & p, const bool check, const CallbackType & callback):
+			proc(p),
+			pipe(ioService),
+			exitHandle(ioService),
+			exitTimer(ioService),
+			checkCommand(check),
+			outputClosed(false),
+			exited(false),
+			callFinished(callback)
+		{
+			const int fd = dup(proc.getOutFd());
+			if (fd < 0) {
+				boost::asio::detail::throw_error(boost::system::error_code(errno, boost::system::system_category()), "dup");
+			}
+			this->pipe.assign(fd);
+#if defined(PCF_IS_LINUX) && defined(SYS_pidfd_open)
+			const long pidFd = syscall(SYS_pidfd_open, proc.getPid(), 0);
+			if (pidFd >= 0) {
+				boost::system::error_code ec;
+				this->exitHandle.assign(static_cast<int>(pidFd), ec);
+				if ( ec ) close(static_cast<int>(pidFd));
+			}
+#endif /* Linux */
+		}
+		
+		/**
+		 * Checks whether the process has exited without reaping it. The process remains
+		 * waitable for ProcessPipe::wait().
+		 *
+		 * @return true if the process has exited or can no longer be waited for, else false
+		 */
+		bool hasExited() {
+			siginfo_t info;
+			info.si_pid = 0;
+			int res;
+			do {
+				res = waitid(P_PID, static_cast<id_t>(this->proc.getPid()), &info, WEXITED | WNOHANG | WNOWAIT);
+			} while (res < 0 && errno == EINTR);
+			return res < 0 || info.si_pid != 0;
+		}
+	};
+	
+	/**
+	 * Queues the next asynchronous read operation on the command output.
+	 *
+	 * @param[in,out] context - asynchronous execution context
+	 */
+	void readAsync(const boost::shared_ptr<AsyncContext> & context) {
+		context->pipe.async_read_some(
+			boost::asio::buffer(context->buffer),
+			boost::phoenix::bind(
+				&Command::handleRead,
+				this,
+				context,
+				boost::phoenix::placeholders::arg1,
+				boost::phoenix::placeholders::arg2
+			)
+		);
+	}
+	
+	/**
+	 * Handles the result of an asynchronous read operation on the command output.
+	 *
+	 * @param[in,out] context - asynchronous execution context
+	 * @param[in] ec - error code of the read operation
+	 * @param[in] size - number of bytes read
+	 */
+	void handleRead(const boost::shared_ptr<AsyncContext> & context, const boost::system::error_code & ec, const size_t size) {
+		if (size > 0) this->appendOutput(context->buffer.data(), size);
+		if ( ! ec ) {
+			this->readAsync(context);
+			return;
+		}
+		/* end of output or broken pipe */
+		context->pipe.close();
+		boost::mutex::scoped_lock lock(this->mutex);
+		context->outputClosed = true;
+		this->finishAsync(context, lock);
+	}
+	
+	/**
+	 * Queues the next asynchronous wait operation for the process exit. The process file
+	 * descriptor is used if available, else the process state is polled periodically.
+	 *
+	 * @param[in,out] context - asynchronous execution context
+	 */
+	void waitExitAsync(const boost::shared_ptr<AsyncContext> & context) {
+		if ( context->exitHandle.is_open() ) {
+			context->exitHandle.async_wait(
+				boost::asio::posix::stream_descriptor::wait_read,
+				boost::phoenix::bind(
+					&Command::handleExit,
+					this,
+					context,
+					boost::phoenix::placeholders::arg1
+				)
+			);
+		} else {
+			context->exitTimer.expires_from_now(boost::posix_time::milliseconds(10));
+			context->exitTimer.async_wait(
+				boost::phoenix::bind(
+					&Command::handleExit,
+					this,
+					context,
+					boost::phoenix::placeholders::arg1
+				)
+			);
+		}
+	}
+	
+	/**
+	 * Handles the result of an asynchronous wait operation for the process exit.
+	 *
+	 * @param[in,out] context - asynchronous execution context
+	 * @param[in] ec - error code of the wait operation
+	 */
+	void handleExit(const boost::shared_ptr<AsyncContext> & context, const boost::system::error_code & ec) {
+		if (ec && context->exitHandle.is_open()) {
+			/* fall back to polling */
+			boost::system::error_code closeEc;
+			context->exitHandle.close(closeEc);
+		}
+		if ( ! context->hasExited() ) {
+			this->waitExitAsync(context);
+			return;
+		}
+		if ( context->exitHandle.is_open() ) {
+			boost::system::error_code closeEc;
+			context->exitHandle.close(closeEc);
+		}
+		boost::mutex::scoped_lock lock(this->mutex);
+		context->exited = true;
+		this->finishAsync(context, lock);
+	}
+	
+	/**
+	 * Finishes the asynchronous command execution once the end of the command output was
+	 * reached and the process has exited. The process is reaped without blocking in this case.
+	 * The callback function is called without holding the internal mutex.
+	 *
+	 * @param[in,out] context - asynchronous execution context
+	 * @param[in,out] lock - lock of the internal mutex
+	 */
+	void finishAsync(const boost::shared_ptr<AsyncContext> & context, boost::mutex::scoped_lock & lock) {
+		if ( ! (context->outputClosed && context->exited) ) return;
+		const bool result = this->finish(context->proc, context->checkCommand);
+		lock.unlock();
+		if ( context->callFinished ) context->callFinished(result);
+	}
+#endif /* not Windows */
+	
+	/**
+	 * Starts the internal command. The internal mutex needs to be locked by the caller.
+	 *
+	 * @return process handle on success, else nothing and the internal state is set to FAILED
+	 */
+	boost::optional<pcf::process::ProcessPipe> start() {
+		this->state = RUNNING;
 		/* execute and fill class attributes */
 		boost::optional<pcf::process::ProcessPipe> proc;
 		std::ostringstream sout;
@@ -382,22 +733,94 @@ public:
 		if ( ( ! proc ) || ( ! (*proc) ) ) {
 			this->endDt = this->startDt;
 			this->output = sout.str();
+			this->outputSize = static_cast<boost::uint64_t>(this->output.size());
 			this->exitCode = -1;
 			this->state = FAILED;
-			return false;
+			return boost::optional<pcf::process::ProcessPipe>();
 		}
-		lock.unlock();
-		{
-			boost::iostreams::stream_buffer<boost::iostreams::file_descriptor_source> in(
-				proc->getOutFd(),
-				boost::iostreams::never_close_handle
-			);
-			/* write program output to this->output */
-			sout << static_cast<std::streambuf *>(&in);
+		return proc;
+	}
+	
+	/**
+	 * Reads the whole output of the given process within the current thread.
+	 *
+	 * @param[in,out] proc - handle of the started process
+	 */
+	void readOutput(pcf::process::ProcessPipe & proc) {
+		boost::iostreams::stream_buffer<boost::iostreams::file_descriptor_source> in(
+			proc.getOutFd(),
+			boost::iostreams::never_close_handle
+		);
+		boost::array<char, 4096> buffer;
+		try {
+			for (;;) {
+				const std::streamsize size = in.sgetn(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+				if (size <= 0) break;
+				this->appendOutput(buffer.data(), static_cast<size_t>(size));
+			}
+		} catch (const std::exception &) {
+			/* broken pipe */
 		}
-		lock.lock();
-		this->output = sout.str();
-		this->exitCode = proc->wait();
+	}
+	
+	/**
+	 * Adds the given data to the command output. The output is moved to a temporary file once
+	 * it exceeds the configured output limit.
+	 *
+	 * @param[in] data - pointer to the output data
+	 * @param[in] size - number of bytes to add
+	 */
+	void appendOutput(const char * data, const size_t size) {
+		boost::mutex::scoped_lock lock(this->mutex);
+		this->outputSize += static_cast<boost::uint64_t>(size);
+		if ( this->outputFile ) {
+			this->outputFile->out.write(data, static_cast<std::streamsize>(size));
+			return;
+		}
+		this->output.append(data, size);
+		if (this->outputLimit <= 0 || static_cast<boost::uint64_t>(this->output.size()) <= this->outputLimit) return;
+		/* spill output to a temporary file */
+		try {
+			const boost::shared_ptr<OutputFile> file(boost::make_shared<OutputFile>());
+			file->out.write(this->output.c_str(), static_cast<std::streamsize>(this->output.size()));
+			if ( file->out ) {
+				this->outputFile = file;
+				std::string().swap(this->output);
+				return;
+			}
+		} catch (const std::exception &) {}
+		/* keep the output in memory if no temporary file could be written */
+		this->outputLimit = 0;
+	}
+	
+	/**
+	 * Opens the command output for reading.
+	 *
+	 * @return input stream with the command output
+	 */
+	boost::shared_ptr<std::istream> openOutput() const {
+		if ( this->outputFile ) {
+			try {
+				return boost::make_shared<pcf::file::ifstream>(this->outputFile->filePath);
+			} catch (const std::exception &) {
+				/* failed to open the temporary file */
+			}
+		}
+		return boost::make_shared<std::istringstream>(this->output);
+	}
+	
+	/**
+	 * Waits for the started command to finish and updates the internal states. The internal
+	 * mutex needs to be locked by the caller.
+	 *
+	 * @param[in,out] proc - handle of the started process
+	 * @param[in] checkCommand - sets the internal state to FAILED if the command returns
+	 * an exit code different from 0
+	 * @return true on success (state == FINISHED), else false
+	 */
+	bool finish(pcf::process::ProcessPipe & proc, const bool checkCommand) {
+		if ( this->outputFile ) this->outputFile->out.flush();
+		this->exitCode = proc.wait();
 		this->endDt = boost::posix_time::microsec_clock::universal_time();
 		if (this->exitCode < 0) this->exitCode = 1;
 		if (checkCommand && this->exitCode != 0) {
@@ -405,8 +828,8 @@ public:
 		} else {
 			this->state = FINISHED;
 		}
-		/* convert UTF-16 output to UTF-8 (if possible) */
-		if (this->shell->outputEncoding == Shell::UTF16 && (this->output.size() % sizeof(wchar_t)) == 0) {
+		/* convert UTF-16 output to UTF-8 (if possible and kept in memory) */
+		if (this->shell->outputEncoding == Shell::UTF16 && ( ! this->outputFile ) && (this->output.size() % sizeof(wchar_t)) == 0) {
 			try {
 				const std::wstring wstr(
 					reinterpret_cast<const wchar_t *>(&(this->output[0])),
@@ -417,7 +840,7 @@ public:
 		}
 		return (this->state == FINISHED);
 	}
-private:
+	
 	/**
 	 * Internal helper function to convert a date time stamp to string.
 	 *
@@ -0,0 +1,139 @@
+/**
+ * @file ContentHashStore.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#include <boost/filesystem/operations.hpp>
+#include <boost/foreach.hpp>
+#include <pcf/data/Hash.hpp>
+#include <pcf/path/Utility.hpp>
+#include "ContentHashStore.hpp"
+
+
+namespace pp {
+
+
+/**
+ * Removes all known content hash records and activates the store. The stored records are loaded
+ * with the given callback once the first content change is requested.
+ *
+ * @param[in] aLoader - loads the content hash records from the database
+ */
+void ContentHashStore::open(const Loader & aLoader) {
+	boost::mutex::scoped_lock lock(this->mutex);
+	this->records.clear();
+	this->used.clear();
+	this->pending.clear();
+	this->loader = aLoader;
+	this->active = true;
+	this->loaded = false;
+}
+
+
+/**
+ * Removes all known content hash records and deactivates the store.
+ */
+void ContentHashStore::unload() {
+	boost::mutex::scoped_lock lock(this->mutex);
+	this->records.clear();
+	this->used.clear();
+	this->pending.clear();
+	this->loader.clear();
+	this->active = false;
+	this->loaded = false;
+}
+
+
+/**
+ * Returns the last modification date time at which the content of the given file changed.
+ * The hash of the file content is only calculated if size or modification time differ from the
+ * stored record. New or changed records are queued for storage.
+ *
+ * @param[in] path - file path
+ * @param[in] status - current meta data of the file
+ * @return last content change or the modification time of status if unknown
+ */
+boost::posix_time::ptime ContentHashStore::getLastChange(const boost::filesystem::path & path, const FileStatus & status) {
+	if (( ! status.isRegularFile() ) || status.lastChange.is_not_a_date_time()) return status.lastChange;
+	const boost::filesystem::path::string_type key(pcf::path::normalize(path, true).native());
+	ContentHash record;
+	bool known;
+	{
+		boost::mutex::scoped_lock lock(this->mutex);
+		if ( ! this->active ) return status.lastChange;
+		if ( ! this->loaded ) {
+			/* load the stored records only if content hashes are actually used */
+			std::vector<ContentHash> list;
+			if (this->loader && this->loader(list)) {
+				BOOST_FOREACH(const ContentHash & stored, list) {
+					this->records[pcf::path::normalize(stored.path, true).native()] = stored;
+				}
+			}
+			this->loaded = true;
+		}
+		const RecordMap::const_iterator it = this->records.find(key);
+		known = (it != this->records.end());
+		if ( known ) {
+			if (it->second.size == status.size && it->second.lastModified == status.lastChange) {
+				this->used.insert(key);
+				return it->second.contentChanged;
+			}
+			record = it->second;
+		}
+	}
+	/* calculate the content hash without holding the lock */
+	boost::uint64_t hash;
+	if ( ! pcf::data::hashFile(hash, path) ) return status.lastChange;
+	if ( ! (known && record.size == status.size && record.hash == hash) ) {
+		record.path = path;
+		record.contentChanged = status.lastChange;
+	}
+	record.size = status.size;
+	record.lastModified = status.lastChange;
+	record.hash = hash;
+	{
+		boost::mutex::scoped_lock lock(this->mutex);
+		this->records[key] = record;
+		this->used.insert(key);
+		this->pending.push_back(record);
+	}
+	return record.contentChanged;
+}
+
+
+/**
+ * Moves all records queued for storage to the given list.
+ *
+ * @param[out] list - receives the pending records
+ */
+void ContentHashStore::takePending(std::vector<ContentHash> & list) {
+	boost::mutex::scoped_lock lock(this->mutex);
+	list.clear();
+	list.swap(this->pending);
+}
+
+
+/**
+ * Removes the known records of files which no longer exist and moves their paths to the given
+ * list. Only records which were not requested since opening the store are checked.
+ *
+ * @param[out] list - receives the paths of the removed records
+ */
+void ContentHashStore::takeRemoved(std::vector<boost::filesystem::path> & list) {
+	boost::mutex::scoped_lock lock(this->mutex);
+	list.clear();
+	for (RecordMap::iterator it = this->records.begin(), endIt = this->records.end(); it != endIt; ) {
+		boost::system::error_code ec;
+		if (this->used.find(it->first) == this->used.end() && boost::filesystem::status(it->second.path, ec).type() == boost::filesystem::file_not_found) {
+			list.push_back(it->second.path);
+			this->records.erase(it++);
+		} else {
+			++it;
+		}
+	}
+}
+
+
+} /* namespace pp */
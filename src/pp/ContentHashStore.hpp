@@ -0,0 +1,78 @@
+/**
+ * @file ContentHashStore.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#ifndef __PP_CONTENTHASHSTORE_HPP__
+#define __PP_CONTENTHASHSTORE_HPP__
+
+
+#include <map>
+#include <set>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+#include "FileStatusCache.hpp"
+
+
+namespace pp {
+
+
+/**
+ * This structure holds the information of a content hash record in the database.
+ */
+struct ContentHash {
+	boost::filesystem::path path; /**< Path to the file. */
+	boost::uint64_t size; /**< File size in bytes at the time the hash was verified. */
+	boost::posix_time::ptime lastModified; /**< Last modification date time at the time the hash was verified. */
+	boost::posix_time::ptime contentChanged; /**< Last modification date time at which the content hash changed. */
+	boost::uint64_t hash; /**< Hash value of the file content. */
+};
+
+
+/**
+ * Class to derive the last content change of input files from stored content hashes. A file which
+ * was only touched reports the modification time at which its content was last seen changing.
+ * Hashes are only calculated if the size or modification time differs from the stored record.
+ * The store is inactive until it was opened. The records are loaded on first use. All methods are
+ * thread-safe.
+ */
+class ContentHashStore : private boost::noncopyable {
+public:
+	/** Callback function type to load the stored content hash records. */
+	typedef boost::function1<bool, std::vector<ContentHash> &> Loader;
+private:
+	/** Map type of the content hash records by native path. */
+	typedef std::map<boost::filesystem::path::string_type, ContentHash> RecordMap;
+	RecordMap records; /**< Known content hash records. */
+	std::set<boost::filesystem::path::string_type> used; /**< Keys of the records requested since opening the store. */
+	std::vector<ContentHash> pending; /**< Changed records not written to the database yet. */
+	Loader loader; /**< Loads the stored records on first use. */
+	bool active; /**< True if the store was opened. */
+	bool loaded; /**< True if the stored records were loaded. */
+	mutable boost::mutex mutex; /**< Mutex object for parallel execution. */
+public:
+	/** Default constructor. */
+	explicit ContentHashStore():
+		active(false),
+		loaded(false)
+	{}
+	
+	void open(const Loader & aLoader);
+	void unload();
+	boost::posix_time::ptime getLastChange(const boost::filesystem::path & path, const FileStatus & status);
+	void takePending(std::vector<ContentHash> & list);
+	void takeRemoved(std::vector<boost::filesystem::path> & list);
+};
+
+
+} /* namespace pp */
+
+
+#endif /* __PP_CONTENTHASHSTORE_HPP__ */
@@ -3,19 +3,19 @@
  * @author Daniel Starke
  * @copyright Copyright 2015-2018 Daniel Starke
  * @date 2015-10-01
- * @version 2016-10-29
- * @remarks This implementation requires SQLite3 to be build with SQLITE_ENABLE_UPDATE_DELETE_LIMIT.
+ * @version 2026-10-17
  */
-#include <ctime>
-#include <string>
-#include <vector>
+#include <map>
+#include <boost/filesystem/operations.hpp>
 #include <boost/make_shared.hpp>
-#include <boost/utility.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/weak_ptr.hpp>
 #include <pcf/exception/General.hpp>
-#include <pcf/os/Target.hpp>
 #include <pcf/path/Utility.hpp>
-#include <pcf/time/Utility.hpp>
 #include "Database.hpp"
+#include "DatabaseBackend.hpp"
+#include "LogDatabase.hpp"
+#include "SqliteDatabase.hpp"
 
 
 namespace pp {
@@ -24,208 +24,15 @@ namespace pp {
 namespace {
 
 
-/**
- * Local helper function to convert a given path into a generalized representation
- * for string comparison.
- *
- * @param[in] path - path to normalize
- * @return normalized path
- */
-static boost::filesystem::path convertPath(const boost::filesystem::path & path) {
-	return pcf::path::normalize(path, true);
-}
-
-
-} /* namespace */
-
-
-/**
- * Internal structure with a database handle with its prepared SQL statements.
- */
-struct Database::Handle {
-	mutable boost::mutex mutex; /**< Database access mutex. */
-	pcf::data::SQLite3 database; /**< SQLite3 database handle. */
-	bool initializedDatabase; /**< True if the database was already initialized, else false. */
-	pcf::data::SQLite3::Statement & updateFile; /**< Insert/update file. */
-	pcf::data::SQLite3::Statement & getFile; /**< Get file information from path. */
-	pcf::data::SQLite3::Statement & setFileFlags; /**< Set specific flags for single file by path. */
-	pcf::data::SQLite3::Statement & setAllFileFlags; /**< Set specific flags for all files. */
-	pcf::data::SQLite3::Statement & addFileFlags; /**< Add specific file flags for single file by path. */
-	pcf::data::SQLite3::Statement & deleteFile; /**< Delete single file by path. */
-	pcf::data::SQLite3::Statement & getFilesByFlag; /**< Returns a list of files with a specific flag set. */
-	pcf::data::SQLite3::Statement & deleteFilesByFlag; /**< Delete all file with a specific flag set. */
-	pcf::data::SQLite3::Statement & deleteUnusedDirectories; /**< Delete unreferenced directory paths. */
-	pcf::data::SQLite3::Statement & deleteAllDirectories; /**< Delete all directory and file entries (propagated). */
-	pcf::data::SQLite3::Statement & deleteAllFiles; /**< Delete all file entries. */
-	pcf::data::SQLite3::Statement & getDirectoryId; /**< Get directory index by path. */
-	pcf::data::SQLite3::Statement & addDirectory; /**< Add single directory by path. */
-	/**
-	 * Constructor.
-	 * 
-	 * @param[in] db - path to database
-	 */
-	Handle(const boost::filesystem::path & db) :
-		database(db),
-		/* initialize database before preparing needed SQL statements */
-		initializedDatabase(this->initDatabase()),
-		/* prepared statements */
-		updateFile             (this->database.prepare("INSERT OR REPLACE INTO file (path, file, size, lastModified, flags) VALUES (?, ?, ?, ?, ?)")),
-		getFile                (this->database.prepare("SELECT size, lastModified, flags FROM file WHERE path = ? AND file = ? LIMIT 1")),
-		setFileFlags           (this->database.prepare("UPDATE OR FAIL file SET flags = ? WHERE path = ? AND file = ? LIMIT 1")),
-		setAllFileFlags        (this->database.prepare("UPDATE OR FAIL file SET flags = ?")),
-		addFileFlags           (this->database.prepare("UPDATE OR FAIL file SET flags = (flags | ?) WHERE path = ? AND file = ? LIMIT 1")),
-		deleteFile             (this->database.prepare("DELETE FROM file WHERE path = ? AND file = ?")),
-		getFilesByFlag         (this->database.prepare("SELECT (directory.path || file.file) AS path, file.size, file.lastModified, file.flags FROM file JOIN directory ON directory.id == file.path WHERE ((?001 == 0 AND flags == 0) OR (?001 != 0 AND (flags & ?001) == ?001))")),
-		deleteFilesByFlag      (this->database.prepare("DELETE FROM file WHERE ((?001 == 0 AND flags == 0) OR (?001 != 0 AND (flags & ?001) == ?001))")),
-		deleteUnusedDirectories(this->database.prepare("DELETE FROM directory WHERE id NOT IN (SELECT path FROM file)")),
-		deleteAllDirectories   (this->database.prepare("DELETE FROM directory")),
-		deleteAllFiles         (this->database.prepare("DELETE FROM file")),
-		getDirectoryId         (this->database.prepare("SELECT id FROM directory WHERE path = ? LIMIT 1")),
-		addDirectory           (this->database.prepare("INSERT INTO directory (path) VALUES (?)"))
-	{};
-private:
-	/**
-	 * Initialize the database structure as needed.
-	 */
-	bool initDatabase() {
-		/* version and type of the database */
-		const int databaseVersion(1);
-		const std::string databaseType("parallelProcessor");
-		/* helper variables */
-		bool result;
-		bool hasPreferenceTable = false;
-		bool needsDatabaseRecreation = false;
-		std::string prefKey;
-		boost::mutex::scoped_lock lock(this->mutex);
-		/* set database modes */
-		result = this->database.query("PRAGMA foreign_keys = ON");
-		if ( ! result ) {
-			BOOST_THROW_EXCEPTION(
-				pcf::exception::Database()
-				<< pcf::exception::tag::Message("Failed to enforce foreign key constraints in database.")
-			);
-			return false;
-		}
-		result = this->database.query(std::string("PRAGMA synchronous = OFF"));
-		if ( ! result ) {
-			BOOST_THROW_EXCEPTION(
-				pcf::exception::Database()
-				<< pcf::exception::tag::Message("Failed to disable synchronous transaction mode for the database.")
-			);
-			return false;
-		}
-		result = this->database.query(std::string("PRAGMA journal_mode = MEMORY"));
-		if ( ! result ) {
-			BOOST_THROW_EXCEPTION(
-				pcf::exception::Database()
-				<< pcf::exception::tag::Message("Failed to set journal mode to memory for the database.")
-			);
-			return false;
-		}
-		/* add database tables */
-		/* preference table */
-		if ( this->database.query("SELECT 1 FROM preference LIMIT 1") ) {
-			hasPreferenceTable = true;
-		} else {
-			result = this->database.query(
-				"CREATE TABLE IF NOT EXISTS preference (key TEXT PRIMARY KEY UNIQUE NOT NULL, value)"
-			);
-			if ( ! result ) {
-				BOOST_THROW_EXCEPTION(
-					pcf::exception::Database()
-					<< pcf::exception::tag::Message("Failed to create initial database structure for preferences.")
-				);
-				return false;
-			}
-		}
-		pcf::data::SQLite3::ScopedStatement stmtGetPreferenceByKey(this->database, "SELECT key, value FROM preference WHERE key = ? LIMIT 1");
-		pcf::data::SQLite3::ScopedStatement stmtSetPreferenceByKey(this->database, "INSERT OR REPLACE INTO preference (key, value) VALUES (?, ?)");
-		/* check database type */
-		stmtGetPreferenceByKey.reset();
-		prefKey = "databaseType";
-		stmtGetPreferenceByKey.bind(prefKey);
-		if ( stmtGetPreferenceByKey.next() ) {
-			const std::string realDatabaseType(stmtGetPreferenceByKey.getColumn<std::string>(1));
-			if (realDatabaseType != databaseType) {
-				BOOST_THROW_EXCEPTION(
-					pcf::exception::Database()
-					<< pcf::exception::tag::Message("Invalid database type \"" + realDatabaseType + "\".")
-				);
-				return false;
-			}
-		}
-		/* check database version */
-		stmtGetPreferenceByKey.reset();
-		prefKey = "databaseVersion";
-		stmtGetPreferenceByKey.bind(prefKey);
-		if ( stmtGetPreferenceByKey.next() ) {
-			if (stmtGetPreferenceByKey.getColumn<boost::int64_t>(1) != databaseVersion) {
-				needsDatabaseRecreation = true;
-			}
-		} else if ( hasPreferenceTable ) {
-			needsDatabaseRecreation = true;
-		} else {
-			stmtSetPreferenceByKey.reset();
-			stmtSetPreferenceByKey.bind(prefKey);
-			stmtSetPreferenceByKey.bind(static_cast<boost::int64_t>(databaseVersion));
-			if ( ! stmtSetPreferenceByKey() ) {
-				BOOST_THROW_EXCEPTION(
-					pcf::exception::Database()
-					<< pcf::exception::tag::Message("Failed to set database preference value for \"" + prefKey + "\".")
-				);
-				return false;
-			}
-		}
-		if ( needsDatabaseRecreation ) {
-			/* database version does not match -> recreate database */
-			if ( ! this->database.clear() ) {
-				BOOST_THROW_EXCEPTION(
-					pcf::exception::Database()
-					<< pcf::exception::tag::Message("Failed clear database.")
-				);
-				return false;
-			}
-			lock.unlock();
-			return this->initDatabase();
-		}
-		/* directory table */
-		result = this->database.query(
-			"CREATE TABLE IF NOT EXISTS directory (id INTEGER PRIMARY KEY AUTOINCREMENT, path TEXT"
-#ifdef PCF_IS_WIN
-			" COLLATE NOCASE"
-#endif /* PCF_IS_WIN */
-			" UNIQUE NOT NULL)"
-		);
-		if ( ! result ) {
-			BOOST_THROW_EXCEPTION(
-				pcf::exception::Database()
-				<< pcf::exception::tag::Message("Failed to create initial database structure for directories.")
-			);
-			return false;
-		}
-		/* file table */
-		result = this->database.query(
-			"CREATE TABLE IF NOT EXISTS file (id INTEGER PRIMARY KEY AUTOINCREMENT, path INTEGER NOT NULL, file TEXT"
-#ifdef PCF_IS_WIN
-			" COLLATE NOCASE"
-#endif /* PCF_IS_WIN */
-			" NOT NULL, size UNSIGNED BIG INT NOT NULL, lastModified DATETIME, flags UNSIGNED BIG INT NOT NULL,"
-			" FOREIGN KEY(path) REFERENCES directory(id)"
-			" ON DELETE CASCADE ON UPDATE CASCADE,"
-			" UNIQUE(path, file) ON CONFLICT REPLACE"
-			")"
-		);
-		if ( ! result ) {
-			BOOST_THROW_EXCEPTION(
-				pcf::exception::Database()
-				<< pcf::exception::tag::Message("Failed to create initial database structure for files.")
-			);
-			return false;
-		}
-		return true;
-	}
-};
+/** Map type of the open log databases by normalized absolute path. */
+typedef std::map<boost::filesystem::path::string_type, boost::weak_ptr<DatabaseBackend> > LogDatabaseMap;
+/** Open log databases shared by all Database objects of this process. */
+static LogDatabaseMap logDatabases;
+/** Mutex object for logDatabases. */
+static boost::mutex logDatabasesMutex;
+
 
+} /* anonymous namespace */
 
 
 /**
@@ -239,9 +46,10 @@ Database::Database() {}
  * Use database at given location.
  *
  * @param[in] db - path to database
+ * @param[in] format - storage format of the database
  */
-Database::Database(const boost::filesystem::path & db) {
-	this->open(db);
+Database::Database(const boost::filesystem::path & db, const Format format) {
+	this->open(db, format);
 }
 
 
@@ -252,7 +60,7 @@ Database::Database(const boost::filesystem::path & db) {
  */
 Database::Database(const Database & o) :
 	path(o.path),
-	handle(o.handle)
+	backend(o.backend)
 {}
 
 
@@ -275,7 +83,7 @@ Database::~Database() {
 Database & Database::operator= (const Database & o) {
 	if (this != (&o)) {
 		this->path = o.path;
-		this->handle = o.handle;
+		this->backend = o.backend;
 	}
 	return *this;
 }
@@ -288,13 +96,13 @@ Database & Database::operator= (const Database & o) {
  * @throws pcf::exception::NullPointer if no database is open
  */
 boost::mutex & Database::getMutex() const {
-	if ( ! this->handle ) {
+	if ( ! this->backend ) {
 		BOOST_THROW_EXCEPTION(
 			pcf::exception::NullPointer()
 			<< pcf::exception::tag::Message("The database was not opened.")
 		);
 	}
-	return this->handle->mutex;
+	return this->backend->getMutex();
 }
 
 
@@ -309,13 +117,33 @@ boost::filesystem::path Database::getPath() const {
 
 
 /**
- * Opens the database at the given location.
+ * Opens the database at the given location. Log databases of the same file share a single
+ * backend within this process.
  *
  * @param[in] db - path to database
+ * @param[in] format - storage format of the database
  */
-void Database::open(const boost::filesystem::path & db) {
+void Database::open(const boost::filesystem::path & db, const Format format) {
 	/* open and initialize database; throws an exception on error */
-	this->handle = boost::make_shared<Database::Handle>(db);
+	switch (format) {
+	case LOG:
+		{
+			/* the records are held in memory and the log file is locked -> share one instance per file */
+			const boost::filesystem::path::string_type key(pcf::path::normalize(boost::filesystem::absolute(db), true).native());
+			boost::mutex::scoped_lock lock(logDatabasesMutex);
+			boost::shared_ptr<DatabaseBackend> shared(logDatabases[key].lock());
+			if ( ! shared ) {
+				shared = boost::make_shared<LogDatabase>(db);
+				logDatabases[key] = shared;
+			}
+			this->backend = shared;
+		}
+		break;
+	case SQLITE:
+	default:
+		this->backend = boost::make_shared<SqliteDatabase>(db);
+		break;
+	}
 	/* only set if database initialization was successful */
 	this->path = db;
 }
@@ -326,7 +154,7 @@ void Database::open(const boost::filesystem::path & db) {
  */
 void Database::close() {
 	this->path = boost::filesystem::path();
-	this->handle.reset();
+	this->backend.reset();
 }
 
 
@@ -337,9 +165,8 @@ void Database::close() {
  */
 bool Database::isOpen() const {
 	if ( this->path.empty() ) return false;
-	if ( ! this->handle ) return false;
-	if ( this->handle->database.getHandle() == NULL ) return false;
-	return true;
+	if ( ! this->backend ) return false;
+	return this->backend->isOpen();
 }
 
 
@@ -353,22 +180,31 @@ bool Database::isOpen() const {
  * @throws pcf::exception::NullPointer if no database is open
  */
 bool Database::updateFile(const boost::filesystem::path & file, const boost::uint64_t flags) {
-	if ( ! this->isOpen() ) {
-		BOOST_THROW_EXCEPTION(
-			pcf::exception::NullPointer()
-			<< pcf::exception::tag::Message("The database was not opened.")
-		);
-	}
+	return this->updateFile(file, FileStatus::read(file), flags);
+}
+
+
+/**
+ * Updates the database entry for the given file by using the passed file
+ * system meta data. Sets the given file flags.
+ *
+ * @param[in] file - path to file
+ * @param[in] status - file system meta data of the file
+ * @param[in] flags - file flags
+ * @return true if the update was successful, else false
+ * @throws pcf::exception::NullPointer if no database is open
+ */
+bool Database::updateFile(const boost::filesystem::path & file, const FileStatus & status, const boost::uint64_t flags) {
 	FileInformation fileInfo;
 	fileInfo.path = file;
-	if (boost::filesystem::exists(file) && boost::filesystem::is_regular_file(file)) {
+	if ( status.isRegularFile() ) {
 		/* passed file does exist; get file meta data */
-		fileInfo.size = static_cast<boost::uint64_t>(boost::filesystem::file_size(file));
-		fileInfo.lastChange = boost::posix_time::from_time_t(boost::filesystem::last_write_time(file));
+		fileInfo.size = status.size;
+		fileInfo.lastChange = status.lastChange;
 	} else {
 		/* passed file does not exist */
 		fileInfo.size = 0;
-		fileInfo.lastChange = pcf::time::fromSqlTime(0);
+		fileInfo.lastChange = boost::posix_time::ptime(boost::gregorian::date(1970, 1, 1));
 	}
 	fileInfo.flags = flags;
 	return this->updateFile(fileInfo);
@@ -383,32 +219,21 @@ bool Database::updateFile(const boost::filesystem::path & file, const boost::uin
  * @throws pcf::exception::NullPointer if no database is open
  */
 bool Database::updateFile(const FileInformation & file) {
-	if ( ! this->isOpen() ) {
-		BOOST_THROW_EXCEPTION(
-			pcf::exception::NullPointer()
-			<< pcf::exception::tag::Message("The database was not opened.")
-		);
-	}
-	boost::mutex::scoped_lock lock(this->handle->mutex);
-	const int directoryId = this->getDirectoryIdInternal(file.path.parent_path(), true);
-	if (directoryId == -1) return false;
-	/* update database */
-	const std::string origFileStr(convertPath(file.path).filename().generic_string(pcf::path::utf8));
-	/* automatically end transaction at the end of scope */
-	pcf::data::SQLite3::ScopedRollback transaction(this->handle->database);
-	/* add file information to database */
-	this->handle->updateFile.reset();
-	this->handle->updateFile.bind(directoryId);
-	this->handle->updateFile.bind(origFileStr);
-	this->handle->updateFile.bind(static_cast<boost::int64_t>(file.size));
-	this->handle->updateFile.bind(static_cast<boost::int64_t>(pcf::time::toSqlTime(file.lastChange)));
-	this->handle->updateFile.bind(static_cast<boost::int64_t>(file.flags));
-	if ( ! this->handle->updateFile() ) {
-		return false;
-	}
-	/* save changes to the database */
-	transaction.commit();
-	return true;
+	return this->getBackend().updateFile(file);
+}
+
+
+/**
+ * Updates the database entries for the given files by using the passed meta data within a
+ * single transaction.
+ *
+ * @param[in] files - file information for database update
+ * @param[in] flags - file flags to set instead of those of the passed file information (optional)
+ * @return true if all updates were successful, else false
+ * @throws pcf::exception::NullPointer if no database is open
+ */
+bool Database::updateFiles(const std::vector<FileInformation> & files, const boost::optional<boost::uint64_t> & flags) {
+	return this->getBackend().updateFiles(files, flags);
 }
 
 
@@ -421,30 +246,19 @@ bool Database::updateFile(const FileInformation & file) {
  * @throws pcf::exception::NullPointer if no database is open
  */
 bool Database::getFile(FileInformation & result, const boost::filesystem::path & file) {
-	if ( ! this->isOpen() ) {
-		BOOST_THROW_EXCEPTION(
-			pcf::exception::NullPointer()
-			<< pcf::exception::tag::Message("The database was not opened.")
-		);
-	}
-	boost::mutex::scoped_lock lock(this->handle->mutex);
-	const int directoryId = this->getDirectoryIdInternal(file.parent_path(), true);
-	if (directoryId == -1) return false;
-	const std::string origFileStr(convertPath(file).filename().generic_string(pcf::path::utf8));
-	/* get file information from database */
-	this->handle->getFile.reset();
-	this->handle->getFile.bind(directoryId);
-	this->handle->getFile.bind(origFileStr);
-	if ( this->handle->getFile.next() ) {
-		/* file exists */
-		result.path = file;
-		result.size = static_cast<boost::uint64_t>(this->handle->getFile.getColumn<boost::int64_t>(0));
-		result.lastChange = pcf::time::fromSqlTime(static_cast<boost::uint64_t>(this->handle->getFile.getColumn<boost::int64_t>(1)));
-		result.flags = static_cast<boost::uint64_t>(this->handle->getFile.getColumn<boost::int64_t>(2));
-		return true;
-	}
-	/* file not found in database */
-	return false;
+	return this->getBackend().getFile(result, file);
+}
+
+
+/**
+ * Returns the meta data of all files within a single sequential scan.
+ * 
+ * @param[out] result - output variable for the meta data
+ * @return true on success, else false
+ * @throws pcf::exception::NullPointer if no database is open
+ */
+bool Database::getFiles(std::vector<FileInformation> & result) {
+	return this->getBackend().getFiles(result);
 }
 
 
@@ -457,30 +271,21 @@ bool Database::getFile(FileInformation & result, const boost::filesystem::path &
  * @throws pcf::exception::NullPointer if no database is open
  */
 bool Database::setFlags(const boost::filesystem::path & file, const boost::uint64_t flags) {
-	if ( ! this->isOpen() ) {
-		BOOST_THROW_EXCEPTION(
-			pcf::exception::NullPointer()
-			<< pcf::exception::tag::Message("The database was not opened.")
-		);
-	}
-	boost::mutex::scoped_lock lock(this->handle->mutex);
-	const int directoryId = this->getDirectoryIdInternal(file.parent_path(), false);
-	if (directoryId == -1) return false;
-	/* update database */
-	const std::string origFileStr(convertPath(file).filename().generic_string(pcf::path::utf8));
-	/* automatically end transaction at the end of scope */
-	pcf::data::SQLite3::ScopedRollback transaction(this->handle->database);
-	/* add file information to database */
-	this->handle->setFileFlags.reset();
-	this->handle->setFileFlags.bind(static_cast<boost::int64_t>(flags));
-	this->handle->setFileFlags.bind(directoryId);
-	this->handle->setFileFlags.bind(origFileStr);
-	if ( ! this->handle->setFileFlags() ) {
-		return false;
-	}
-	/* save changes to the database */
-	transaction.commit();
-	return true;
+	return this->getBackend().setFlags(file, flags);
+}
+
+
+/**
+ * Sets the flags for the given files within a single transaction. Files which are not in the
+ * database are skipped and reported.
+ *
+ * @param[in] files - set the flags of the file information for these files
+ * @param[out] failed - output variable for the files which are not in the database
+ * @return true if all existing files were updated, else false
+ * @throws pcf::exception::NullPointer if no database is open
+ */
+bool Database::setFlags(const std::vector<FileInformation> & files, std::vector<boost::filesystem::path> & failed) {
+	return this->getBackend().setFlags(files, failed);
 }
 
 
@@ -492,25 +297,7 @@ bool Database::setFlags(const boost::filesystem::path & file, const boost::uint6
  * @throws pcf::exception::NullPointer if no database is open
  */
 bool Database::setAllFlags(const boost::uint64_t flags) {
-	if ( ! this->isOpen() ) {
-		BOOST_THROW_EXCEPTION(
-			pcf::exception::NullPointer()
-			<< pcf::exception::tag::Message("The database was not opened.")
-		);
-	}
-	boost::mutex::scoped_lock lock(this->handle->mutex);
-	/* update database */
-	/* automatically end transaction at the end of scope */
-	pcf::data::SQLite3::ScopedRollback transaction(this->handle->database);
-	/* add file information to database */
-	this->handle->setAllFileFlags.reset();
-	this->handle->setAllFileFlags.bind(static_cast<boost::int64_t>(flags));
-	if ( ! this->handle->setAllFileFlags() ) {
-		return false;
-	}
-	/* save changes to the database */
-	transaction.commit();
-	return true;
+	return this->getBackend().setAllFlags(flags);
 }
 
 
@@ -523,30 +310,7 @@ bool Database::setAllFlags(const boost::uint64_t flags) {
  * @throws pcf::exception::NullPointer if no database is open
  */
 bool Database::addFlags(const boost::filesystem::path & file, const boost::uint64_t flags) {
-	if ( ! this->isOpen() ) {
-		BOOST_THROW_EXCEPTION(
-			pcf::exception::NullPointer()
-			<< pcf::exception::tag::Message("The database was not opened.")
-		);
-	}
-	boost::mutex::scoped_lock lock(this->handle->mutex);
-	const int directoryId = this->getDirectoryIdInternal(file.parent_path(), false);
-	if (directoryId == -1) return false;
-	/* update database */
-	const std::string origFileStr(convertPath(file).filename().generic_string(pcf::path::utf8));
-	/* automatically end transaction at the end of scope */
-	pcf::data::SQLite3::ScopedRollback transaction(this->handle->database);
-	/* add file information to database */
-	this->handle->addFileFlags.reset();
-	this->handle->addFileFlags.bind(static_cast<boost::int64_t>(flags));
-	this->handle->addFileFlags.bind(directoryId);
-	this->handle->addFileFlags.bind(origFileStr);
-	if ( ! this->handle->addFileFlags() ) {
-		return false;
-	}
-	/* save changes to the database */
-	transaction.commit();
-	return true;
+	return this->getBackend().addFlags(file, flags);
 }
 
 
@@ -558,24 +322,20 @@ bool Database::addFlags(const boost::filesystem::path & file, const boost::uint6
  * @throws pcf::exception::NullPointer if no database is open
  */
 bool Database::deleteFile(const boost::filesystem::path & file) {
-	if ( ! this->isOpen() ) {
-		BOOST_THROW_EXCEPTION(
-			pcf::exception::NullPointer()
-			<< pcf::exception::tag::Message("The database was not opened.")
-		);
-	}
-	boost::mutex::scoped_lock lock(this->handle->mutex);
-	const int directoryId = this->getDirectoryIdInternal(file.parent_path(), true);
-	if (directoryId == -1) return false;
-	const std::string origFileStr(convertPath(file).filename().generic_string(pcf::path::utf8));
-	/* delete file from database */
-	this->handle->deleteFile.reset();
-	this->handle->deleteFile.bind(directoryId);
-	this->handle->deleteFile.bind(origFileStr);
-	if ( this->handle->deleteFile() ) {
-		return true;
-	}
-	return false;
+	return this->getBackend().deleteFile(file);
+}
+
+
+/**
+ * Delete the given files from the database within a single transaction. Files which are not in
+ * the database are ignored.
+ * 
+ * @param[in] files - files to remove from database
+ * @return true on success, else false
+ * @throws pcf::exception::NullPointer if no database is open
+ */
+bool Database::deleteFiles(const std::vector<boost::filesystem::path> & files) {
+	return this->getBackend().deleteFiles(files);
 }
 
 
@@ -590,27 +350,7 @@ bool Database::deleteFile(const boost::filesystem::path & file) {
  * @throws pcf::exception::NullPointer if no database is open
  */
 bool Database::forEachFileByFlag(const Callback & call, const boost::uint64_t flags) {
-	FileInformation fileInfo;
-	if ( ! this->isOpen() ) {
-		BOOST_THROW_EXCEPTION(
-			pcf::exception::NullPointer()
-			<< pcf::exception::tag::Message("The database was not opened.")
-		);
-	}
-	if ( ! call ) return true;
-	boost::mutex::scoped_lock lock(this->handle->mutex);
-	this->handle->getFilesByFlag.reset();
-	this->handle->getFilesByFlag.bind(static_cast<boost::int64_t>(flags));
-	while ( this->handle->getFilesByFlag.next() ) {
-		fileInfo.path = boost::filesystem::path(this->handle->getFilesByFlag.getColumn<std::string>(0), pcf::path::utf8);
-		fileInfo.size = static_cast<boost::uint64_t>(this->handle->getFilesByFlag.getColumn<boost::int64_t>(1));
-		fileInfo.lastChange = pcf::time::fromSqlTime(static_cast<boost::uint64_t>(this->handle->getFilesByFlag.getColumn<boost::int64_t>(2)));
-		fileInfo.flags = static_cast<boost::uint64_t>(this->handle->getFilesByFlag.getColumn<boost::int64_t>(3));
-		lock.unlock(); /* return access to the database */
-		if ( ! call(fileInfo) ) return false;
-		lock.lock(); /* take access of the database back again */
-	}
-	return true;
+	return this->getBackend().forEachFileByFlag(call, flags);
 }
 
 
@@ -622,19 +362,96 @@ bool Database::forEachFileByFlag(const Callback & call, const boost::uint64_t fl
  * @throws pcf::exception::NullPointer if no database is open
  */
 bool Database::deleteFilesByFlag(const boost::uint64_t flags) {
-	if ( ! this->isOpen() ) {
-		BOOST_THROW_EXCEPTION(
-			pcf::exception::NullPointer()
-			<< pcf::exception::tag::Message("The database was not opened.")
-		);
-	}
-	boost::mutex::scoped_lock lock(this->handle->mutex);
-	this->handle->deleteFilesByFlag.reset();
-	this->handle->deleteFilesByFlag.bind(static_cast<boost::int64_t>(flags));
-	if ( this->handle->deleteFilesByFlag() ) {
-		return true;
-	}
-	return false;
+	return this->getBackend().deleteFilesByFlag(flags);
+}
+
+
+/**
+ * Adds the given transition runtime records within a single transaction. Only the last
+ * Database::runtimeHistorySize records are kept per transition.
+ *
+ * @param[in] records - transition runtime records to add
+ * @return true on success, else false
+ * @throws pcf::exception::NullPointer if no database is open
+ */
+bool Database::addRuntimes(const TransitionRuntimeVector & records) {
+	return this->getBackend().addRuntimes(records);
+}
+
+
+/**
+ * Returns the runtime records of the given transition starting with the most recent one.
+ *
+ * @param[out] result - output variable for the runtime records
+ * @param[in] process - ID of the process of the transition
+ * @param[in] transition - unique key of the transition within its process
+ * @return true if at least one record was found, else false
+ * @throws pcf::exception::NullPointer if no database is open
+ */
+bool Database::getRuntimes(RuntimeInformationVector & result, const std::string & process, const std::string & transition) {
+	return this->getBackend().getRuntimes(result, process, transition);
+}
+
+
+/**
+ * Returns the stored listing of the given directory.
+ *
+ * @param[out] result - output variable for the directory listing
+ * @param[in] directory - absolute path to the requested directory
+ * @return true if a valid listing for the directory is in the database, else false
+ * @throws pcf::exception::NullPointer if no database is open
+ */
+bool Database::getListing(DirectoryListing & result, const boost::filesystem::path & directory) {
+	return this->getBackend().getListing(result, directory);
+}
+
+
+/**
+ * Inserts or updates the passed directory listings within a single transaction.
+ *
+ * @param[in] listings - directory listings to store
+ * @return true on success, else false
+ * @throws pcf::exception::NullPointer if no database is open
+ */
+bool Database::updateListings(const std::vector<DirectoryListing> & listings) {
+	return this->getBackend().updateListings(listings);
+}
+
+
+/**
+ * Returns all stored content hash records.
+ *
+ * @param[out] result - output variable for the content hash records
+ * @return true on success, else false
+ * @throws pcf::exception::NullPointer if no database is open
+ */
+bool Database::getHashes(std::vector<ContentHash> & result) {
+	return this->getBackend().getHashes(result);
+}
+
+
+/**
+ * Inserts or updates the passed content hash records within a single transaction.
+ *
+ * @param[in] records - content hash records to store
+ * @return true on success, else false
+ * @throws pcf::exception::NullPointer if no database is open
+ */
+bool Database::updateHashes(const std::vector<ContentHash> & records) {
+	return this->getBackend().updateHashes(records);
+}
+
+
+/**
+ * Deletes the content hash records of the given files within a single transaction. Files
+ * without content hash record are ignored.
+ *
+ * @param[in] files - remove the content hash records of these files
+ * @return true on success, else false
+ * @throws pcf::exception::NullPointer if no database is open
+ */
+bool Database::deleteHashes(const std::vector<boost::filesystem::path> & files) {
+	return this->getBackend().deleteHashes(files);
 }
 
 
@@ -645,17 +462,7 @@ bool Database::deleteFilesByFlag(const boost::uint64_t flags) {
  * @throws pcf::exception::NullPointer if no database is open
  */
 bool Database::cleanUp() {
-	if ( ! this->isOpen() ) {
-		BOOST_THROW_EXCEPTION(
-			pcf::exception::NullPointer()
-			<< pcf::exception::tag::Message("The database was not opened.")
-		);
-	}
-	boost::mutex::scoped_lock lock(this->handle->mutex);
-	if ( this->handle->deleteUnusedDirectories() ) {
-		return true;
-	}
-	return false;
+	return this->getBackend().cleanUp();
 }
 
 
@@ -666,52 +473,24 @@ bool Database::cleanUp() {
  * @throws pcf::exception::NullPointer if no database is open
  */
 bool Database::clear() {
-	if ( ! this->isOpen() ) {
-		BOOST_THROW_EXCEPTION(
-			pcf::exception::NullPointer()
-			<< pcf::exception::tag::Message("The database was not opened.")
-		);
-	}
-	boost::mutex::scoped_lock lock(this->handle->mutex);
-	if (this->handle->deleteAllDirectories() && this->handle->deleteAllFiles()) {
-		return true;
-	}
-	return false;
+	return this->getBackend().clear();
 }
 
 
 /**
- * Returns the index of the given directory path.
+ * Returns the backend of the open database.
  *
- * @param[in] directory - return database index to this directory path
- * @param[in] aine - add passed directory to database if not already there (add if not exist)
- * @return directory database index or -1 on error
+ * @return database backend
  * @throws pcf::exception::NullPointer if no database is open
  */
-int Database::getDirectoryIdInternal(const boost::filesystem::path & directory, const bool aine) {
-	std::string origDirectoryStr(convertPath(directory).generic_string(pcf::path::utf8));
-	if ( origDirectoryStr.empty() ) origDirectoryStr.push_back('/');
-	if (origDirectoryStr[origDirectoryStr.size() - 1] != '/') origDirectoryStr.push_back('/');
-	this->handle->getDirectoryId.reset();
-	this->handle->getDirectoryId.bind(origDirectoryStr);
-	if ( this->handle->getDirectoryId.next() ) {
-		/* directory found in database */
-		return this->handle->getDirectoryId.getColumn<int>(0);
-	}
-	if ( ! aine ) return -1;
-	this->handle->addDirectory.reset();
-	this->handle->addDirectory.bind(origDirectoryStr);
-	if ( ! this->handle->addDirectory() ) {
-		return -1;
-	}
-	this->handle->getDirectoryId.reset();
-	this->handle->getDirectoryId.bind(origDirectoryStr);
-	if ( this->handle->getDirectoryId.next() ) {
-		/* directory found in database */
-		return this->handle->getDirectoryId.getColumn<int>(0);
+DatabaseBackend & Database::getBackend() const {
+	if ( ! this->isOpen() ) {
+		BOOST_THROW_EXCEPTION(
+			pcf::exception::NullPointer()
+			<< pcf::exception::tag::Message("The database was not opened.")
+		);
 	}
-	/* no entry found and failed to add an entry */
-	return -1;
+	return *(this->backend);
 }
 
 
@@ -3,12 +3,14 @@
  * @author Daniel Starke
  * @copyright Copyright 2015-2018 Daniel Starke
  * @date 2015-10-01
- * @version 2016-05-01
+ * @version 2026-10-17
  */
 #ifndef __PP_DATABASE_HPP__
 #define __PP_DATABASE_HPP__
 
 
+#include <string>
+#include <vector>
 #include <boost/cstdint.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/filesystem/path.hpp>
@@ -16,48 +18,70 @@
 #include <boost/optional.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/thread/mutex.hpp>
-#include <pcf/data/SQLite3.hpp>
+#include "FileStatusCache.hpp"
 #include "Type.hpp"
 
 
 namespace pp {
 
 
+/* forward declaration */
+class DatabaseBackend;
+
+
 /**
- * Class to handle database access.
+ * Class to handle database access. The records are stored by the backend selected on open().
  */
 class Database {
 public:
 	/** Callback function type for forEachFileByFlag(). */
 	typedef boost::function1<bool, const FileInformation &> Callback;
+	/** Maximum number of runtime records kept per transition. */
+	static const size_t runtimeHistorySize = 5;
+	/** Possible database storage formats. */
+	enum Format {
+		SQLITE, /**< SQLite3 database. */
+		LOG /**< Memory-mapped append-only log file. */
+	};
 private:
-	struct Handle; /**< Forward declaration of internal database structure. */
 	boost::filesystem::path path; /**< Path to used database. */
-	boost::shared_ptr<Handle> handle; /**< Internal database handle and statements. */
+	boost::shared_ptr<DatabaseBackend> backend; /**< Storage backend of the open database. */
 public:
 	explicit Database();
-	explicit Database(const boost::filesystem::path & db);
+	explicit Database(const boost::filesystem::path & db, const Format format = SQLITE);
 	Database(const Database & o);
 	~Database();
 	Database & operator= (const Database & o);
 	boost::mutex & getMutex() const;
 	boost::filesystem::path getPath() const;
-	void open(const boost::filesystem::path & db);
+	void open(const boost::filesystem::path & db, const Format format = SQLITE);
 	void close();
 	bool isOpen() const;
 	bool updateFile(const boost::filesystem::path & file, const boost::uint64_t flags = 0);
+	bool updateFile(const boost::filesystem::path & file, const FileStatus & status, const boost::uint64_t flags = 0);
 	bool updateFile(const FileInformation & file);
+	bool updateFiles(const std::vector<FileInformation> & files, const boost::optional<boost::uint64_t> & flags = boost::optional<boost::uint64_t>());
 	bool getFile(FileInformation & result, const boost::filesystem::path & file);
+	bool getFiles(std::vector<FileInformation> & result);
 	bool setFlags(const boost::filesystem::path & file, const boost::uint64_t flags);
+	bool setFlags(const std::vector<FileInformation> & files, std::vector<boost::filesystem::path> & failed);
 	bool setAllFlags(const boost::uint64_t flags);
 	bool addFlags(const boost::filesystem::path & file, const boost::uint64_t flags);
 	bool deleteFile(const boost::filesystem::path & file);
+	bool deleteFiles(const std::vector<boost::filesystem::path> & files);
 	bool forEachFileByFlag(const Callback & call, const boost::uint64_t flags);
 	bool deleteFilesByFlag(const boost::uint64_t flags);
+	bool addRuntimes(const TransitionRuntimeVector & records);
+	bool getRuntimes(RuntimeInformationVector & result, const std::string & process, const std::string & transition);
+	bool getListing(DirectoryListing & result, const boost::filesystem::path & directory);
+	bool updateListings(const std::vector<DirectoryListing> & listings);
+	bool getHashes(std::vector<ContentHash> & result);
+	bool updateHashes(const std::vector<ContentHash> & records);
+	bool deleteHashes(const std::vector<boost::filesystem::path> & files);
 	bool cleanUp();
 	bool clear();
 private:
-	int getDirectoryIdInternal(const boost::filesystem::path & directory, const bool aine = false);
+	DatabaseBackend & getBackend() const;
 };
 
 
@@ -0,0 +1,128 @@
+/**
+ * @file DatabaseBackend.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#include <algorithm>
+#include <boost/foreach.hpp>
+#include <pcf/os/Target.hpp>
+#include "DatabaseBackend.hpp"
+
+
+namespace pp {
+
+
+#ifdef PCF_IS_WIN
+/**
+ * Local helper function to compare two characters without regard to ASCII case.
+ *
+ * @param[in] lhs - left-hand statement
+ * @param[in] rhs - right-hand statement
+ * @return true if lhs is less than rhs, else false
+ */
+static bool lessNoCase(const char lhs, const char rhs) {
+	const char l = (lhs >= 'A' && lhs <= 'Z') ? static_cast<char>(lhs - 'A' + 'a') : lhs;
+	const char r = (rhs >= 'A' && rhs <= 'Z') ? static_cast<char>(rhs - 'A' + 'a') : rhs;
+	return static_cast<unsigned char>(l) < static_cast<unsigned char>(r);
+}
+#endif /* PCF_IS_WIN */
+
+
+/**
+ * Compares the two paths. The comparison ignores the ASCII case on Windows.
+ *
+ * @param[in] lhs - left-hand statement
+ * @param[in] rhs - right-hand statement
+ * @return true if lhs is less than rhs, else false
+ */
+bool DatabaseBackend::PathLess::operator() (const std::string & lhs, const std::string & rhs) const {
+#ifdef PCF_IS_WIN
+	return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), lessNoCase);
+#else /* not PCF_IS_WIN */
+	return lhs < rhs;
+#endif /* not PCF_IS_WIN */
+}
+
+
+/**
+ * Helper function to convert a given path into a generalized representation
+ * for string comparison.
+ *
+ * @param[in] path - path to normalize
+ * @return normalized path
+ */
+boost::filesystem::path DatabaseBackend::convertPath(const boost::filesystem::path & path) {
+	return pcf::path::normalize(path, true);
+}
+
+
+/**
+ * Helper function to convert the given time into its database representation in
+ * microseconds since 1970-01-01.
+ *
+ * @param[in] t - time to convert
+ * @return database time
+ */
+boost::int64_t DatabaseBackend::toDatabaseTime(const boost::posix_time::ptime & t) {
+	return static_cast<boost::int64_t>((t - boost::posix_time::ptime(boost::gregorian::date(1970, 1, 1))).total_microseconds());
+}
+
+
+/**
+ * Helper function to convert the given database time into a Posix time value.
+ *
+ * @param[in] t - database time in microseconds since 1970-01-01
+ * @return Posix time representation
+ * @see toDatabaseTime()
+ */
+boost::posix_time::ptime DatabaseBackend::fromDatabaseTime(const boost::int64_t t) {
+	return boost::posix_time::ptime(boost::gregorian::date(1970, 1, 1)) + boost::posix_time::microseconds(t);
+}
+
+
+/**
+ * Helper function to encode the given directory entries into a single string. Each entry
+ * is stored as type character followed by the UTF-8 file name and a terminating slash.
+ *
+ * @param[in] entries - directory entries to encode
+ * @return encoded directory entries
+ */
+std::string DatabaseBackend::encodeEntries(const std::vector<pcf::path::DirectoryEntry> & entries) {
+	std::string result;
+	BOOST_FOREACH(const pcf::path::DirectoryEntry & entry, entries) {
+		result.push_back(static_cast<char>('0' + static_cast<int>(entry.type)));
+		result.append(entry.name.generic_string(pcf::path::utf8));
+		result.push_back('/');
+	}
+	return result;
+}
+
+
+/**
+ * Helper function to decode the given string into directory entries.
+ *
+ * @param[out] entries - append decoded directory entries here
+ * @param[in] str - encoded directory entries
+ * @return true on success, false if the string is malformed
+ * @see encodeEntries()
+ */
+bool DatabaseBackend::decodeEntries(std::vector<pcf::path::DirectoryEntry> & entries, const std::string & str) {
+	std::string::size_type start = 0;
+	while (start < str.size()) {
+		const std::string::size_type end = str.find('/', start);
+		if (end == std::string::npos || (end - start) < 2) return false;
+		const int type = str[start] - '0';
+		if (type < static_cast<int>(pcf::path::ENTRY_UNKNOWN) || type > static_cast<int>(pcf::path::ENTRY_OTHER)) return false;
+		entries.push_back(pcf::path::DirectoryEntry(
+			boost::filesystem::path(str.substr(start + 1, end - start - 1), pcf::path::utf8),
+			static_cast<pcf::path::EntryType>(type)
+		));
+		start = end + 1;
+	}
+	return true;
+}
+
+
+} /* namespace pp */
@@ -0,0 +1,95 @@
+/**
+ * @file DatabaseBackend.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#ifndef __PP_DATABASEBACKEND_HPP__
+#define __PP_DATABASEBACKEND_HPP__
+
+
+#include <string>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+#include <boost/thread/mutex.hpp>
+#include <pcf/path/Utility.hpp>
+#include "Database.hpp"
+#include "Type.hpp"
+
+
+namespace pp {
+
+
+/**
+ * Interface of a storage format for the database. Database forwards its operations to an
+ * instance of this class after checking that the database is open. All methods need to be
+ * thread-safe.
+ *
+ * @see Database
+ */
+class DatabaseBackend : private boost::noncopyable {
+public:
+	/**
+	 * Path comparison predicate which matches the path collation of the SQLite database. Used
+	 * for all in-memory maps of database paths.
+	 */
+	struct PathLess {
+		bool operator() (const std::string & lhs, const std::string & rhs) const;
+	};
+	
+	/** Destructor. */
+	virtual ~DatabaseBackend() {}
+	
+	/**
+	 * Returns the mutex which guards the database access.
+	 *
+	 * @return database access mutex
+	 */
+	virtual boost::mutex & getMutex() = 0;
+	
+	/**
+	 * Checks whether the underlying storage is usable.
+	 *
+	 * @return true if open, else false
+	 */
+	virtual bool isOpen() const = 0;
+	
+	virtual bool updateFile(const FileInformation & file) = 0;
+	virtual bool updateFiles(const std::vector<FileInformation> & files, const boost::optional<boost::uint64_t> & flags) = 0;
+	virtual bool getFile(FileInformation & result, const boost::filesystem::path & file) = 0;
+	virtual bool getFiles(std::vector<FileInformation> & result) = 0;
+	virtual bool setFlags(const boost::filesystem::path & file, const boost::uint64_t flags) = 0;
+	virtual bool setFlags(const std::vector<FileInformation> & files, std::vector<boost::filesystem::path> & failed) = 0;
+	virtual bool setAllFlags(const boost::uint64_t flags) = 0;
+	virtual bool addFlags(const boost::filesystem::path & file, const boost::uint64_t flags) = 0;
+	virtual bool deleteFile(const boost::filesystem::path & file) = 0;
+	virtual bool deleteFiles(const std::vector<boost::filesystem::path> & files) = 0;
+	virtual bool forEachFileByFlag(const Database::Callback & call, const boost::uint64_t flags) = 0;
+	virtual bool deleteFilesByFlag(const boost::uint64_t flags) = 0;
+	virtual bool addRuntimes(const TransitionRuntimeVector & records) = 0;
+	virtual bool getRuntimes(RuntimeInformationVector & result, const std::string & process, const std::string & transition) = 0;
+	virtual bool getListing(DirectoryListing & result, const boost::filesystem::path & directory) = 0;
+	virtual bool updateListings(const std::vector<DirectoryListing> & listings) = 0;
+	virtual bool getHashes(std::vector<ContentHash> & result) = 0;
+	virtual bool updateHashes(const std::vector<ContentHash> & records) = 0;
+	virtual bool deleteHashes(const std::vector<boost::filesystem::path> & files) = 0;
+	virtual bool cleanUp() = 0;
+	virtual bool clear() = 0;
+protected:
+	static boost::filesystem::path convertPath(const boost::filesystem::path & path);
+	static boost::int64_t toDatabaseTime(const boost::posix_time::ptime & t);
+	static boost::posix_time::ptime fromDatabaseTime(const boost::int64_t t);
+	static std::string encodeEntries(const std::vector<pcf::path::DirectoryEntry> & entries);
+	static bool decodeEntries(std::vector<pcf::path::DirectoryEntry> & entries, const std::string & str);
+};
+
+
+} /* namespace pp */
+
+
+#endif /* __PP_DATABASEBACKEND_HPP__ */
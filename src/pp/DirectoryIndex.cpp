@@ -0,0 +1,145 @@
+/**
+ * @file DirectoryIndex.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#include <algorithm>
+#include <ctime>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/filesystem.hpp>
+#include <pcf/os/Target.hpp>
+#include "DirectoryIndex.hpp"
+
+
+#if ! defined(PCF_IS_WIN)
+extern "C" {
+#include <sys/stat.h>
+#include <sys/types.h>
+}
+#endif /* ! PCF_IS_WIN */
+
+
+namespace pp {
+
+
+namespace {
+
+
+/** Number of nanoseconds per second. */
+static const boost::int64_t nanoseconds = 1000000000;
+
+
+/**
+ * Reads the inode, last modification time and last status change time of the given directory.
+ * The times have nanosecond resolution where supported by the system.
+ *
+ * @param[out] listing - set the directory stamp of this listing
+ * @param[in] dir - directory to query
+ * @return true on success, false if the path is not a readable directory
+ */
+static bool readStamp(DirectoryListing & listing, const boost::filesystem::path & dir) {
+#if defined(PCF_IS_WIN)
+	boost::system::error_code ec;
+	if ( ! boost::filesystem::is_directory(dir, ec) ) return false;
+	const std::time_t lastChange = boost::filesystem::last_write_time(dir, ec);
+	if ( ec ) return false;
+	/* no inode and status change time available; directory entry changes update the modification time */
+	listing.inode = 0;
+	listing.modified = static_cast<boost::int64_t>(lastChange) * nanoseconds;
+	listing.changed = listing.modified;
+#else /* ! PCF_IS_WIN */
+	struct stat st;
+	if (stat(dir.c_str(), &st) != 0 || ( ! S_ISDIR(st.st_mode) )) return false;
+	listing.inode = static_cast<boost::int64_t>(st.st_ino);
+#if defined(PCF_IS_LINUX)
+	listing.modified = (static_cast<boost::int64_t>(st.st_mtim.tv_sec) * nanoseconds) + static_cast<boost::int64_t>(st.st_mtim.tv_nsec);
+	listing.changed = (static_cast<boost::int64_t>(st.st_ctim.tv_sec) * nanoseconds) + static_cast<boost::int64_t>(st.st_ctim.tv_nsec);
+#else /* ! PCF_IS_LINUX */
+	listing.modified = static_cast<boost::int64_t>(st.st_mtime) * nanoseconds;
+	listing.changed = static_cast<boost::int64_t>(st.st_ctime) * nanoseconds;
+#endif /* ! PCF_IS_LINUX */
+#endif /* ! PCF_IS_WIN */
+	return true;
+}
+
+
+} /* namespace */
+
+
+/**
+ * Constructor.
+ *
+ * @param[in] d - open database to store the directory listings in
+ */
+DirectoryIndex::DirectoryIndex(const Database & d):
+	db(d)
+{}
+
+
+/**
+ * Destructor. Writes all pending listings to the database.
+ */
+DirectoryIndex::~DirectoryIndex() {
+	try {
+		this->flush();
+	} catch (...) {
+		/* ignore */
+	}
+}
+
+
+/**
+ * Reads all entries of the given directory. The entries are taken from the database if the
+ * directory did not change since its listing was stored. Otherwise, the directory is read from
+ * the file system and its listing is queued for storage. Listings of recently changed directories
+ * are not stored as further changes within the time stamp resolution of the file system could not
+ * be detected.
+ *
+ * @param[in,out] entries - append directory entries to this vector
+ * @param[in] dir - directory to read (empty for the current working directory)
+ * @throws boost::filesystem::filesystem_error if the directory could not be read
+ * @see pcf::path::ReadDirectoryCallback
+ */
+void DirectoryIndex::read(std::vector<pcf::path::DirectoryEntry> & entries, const boost::filesystem::path & dir) {
+	DirectoryListing listing;
+	listing.path = boost::filesystem::absolute(dir);
+	/* the stamp needs to be taken before reading to detect concurrent changes on the next run */
+	if ( ( ! this->db.isOpen() ) || ( ! readStamp(listing, listing.path) ) ) {
+		pcf::path::readDirectory(entries, dir);
+		return;
+	}
+	DirectoryListing stored;
+	if (this->db.getListing(stored, listing.path) && stored.inode == listing.inode && stored.modified == listing.modified && stored.changed == listing.changed) {
+		entries.insert(entries.end(), stored.entries.begin(), stored.entries.end());
+		return;
+	}
+	pcf::path::readDirectory(listing.entries, dir);
+	entries.insert(entries.end(), listing.entries.begin(), listing.entries.end());
+	const boost::posix_time::time_duration sinceEpoch(boost::posix_time::microsec_clock::universal_time() - boost::posix_time::ptime(boost::gregorian::date(1970, 1, 1)));
+	const boost::int64_t now = static_cast<boost::int64_t>(sinceEpoch.total_microseconds()) * 1000;
+	if ((now - std::max(listing.modified, listing.changed)) >= (DirectoryIndex::minAge * nanoseconds)) {
+		boost::mutex::scoped_lock lock(this->mutex);
+		this->pending.push_back(listing);
+	}
+}
+
+
+/**
+ * Writes all pending listings to the database within a single transaction.
+ *
+ * @return true on success, else false
+ */
+bool DirectoryIndex::flush() {
+	std::vector<DirectoryListing> listings;
+	{
+		boost::mutex::scoped_lock lock(this->mutex);
+		listings.swap(this->pending);
+	}
+	if ( listings.empty() || ( ! this->db.isOpen() ) ) return true;
+	return this->db.updateListings(listings);
+}
+
+
+} /* namespace pp */
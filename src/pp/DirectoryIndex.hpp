@@ -0,0 +1,49 @@
+/**
+ * @file DirectoryIndex.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#ifndef __PP_DIRECTORYINDEX_HPP__
+#define __PP_DIRECTORYINDEX_HPP__
+
+
+#include <vector>
+#include <boost/filesystem/path.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <pcf/path/Utility.hpp>
+#include "Database.hpp"
+#include "Type.hpp"
+
+
+namespace pp {
+
+
+/**
+ * Class to serve directory listings from the database instead of reading them from the file
+ * system. A stored listing is only used if the inode, last modification time and last status
+ * change time of the directory are unchanged. Listings read from the file system are buffered
+ * and written back to the database with flush(). All methods are thread-safe.
+ */
+class DirectoryIndex : private boost::noncopyable {
+public:
+	/** Listings of directories changed more recently than this are not stored (in seconds). */
+	static const boost::int64_t minAge = 2;
+private:
+	Database db; /**< Database with the stored directory listings. */
+	std::vector<DirectoryListing> pending; /**< Listings not written to the database yet. */
+	boost::mutex mutex; /**< Mutex object for parallel execution. */
+public:
+	explicit DirectoryIndex(const Database & d);
+	~DirectoryIndex();
+	void read(std::vector<pcf::path::DirectoryEntry> & entries, const boost::filesystem::path & dir);
+	bool flush();
+};
+
+
+} /* namespace pp */
+
+
+#endif /* __PP_DIRECTORYINDEX_HPP__ */
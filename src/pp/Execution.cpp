@@ -3,15 +3,19 @@
  * @author Daniel Starke
  * @copyright Copyright 2015-2018 Daniel Starke
  * @date 2015-03-22
- * @version 2017-09-16
+ * @version 2026-10-17
  */
 #include <fstream>
 #include <sstream>
 #include <boost/config/warning_disable.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/phoenix/bind.hpp>
 #include <boost/phoenix/core.hpp>
+#include <boost/scoped_ptr.hpp>
+#include "DirectoryIndex.hpp"
 #include "Execution.hpp"
+#include "TaskGroup.hpp"
 #include "Utility.hpp"
 
 
@@ -24,10 +28,11 @@ namespace {
 /**
  * Local function to update the temporary creation flags.
  *
- * @param[in] verbosity - verbosity level
  * @param[in] temporaryFileInfoMap - update all entries in this map
+ * @param[in] tolerance - minimal time difference for a file to count as modified
+ * @param[in] verbosity - verbosity level
  */
-static void updateTemporaryCreationFlags(const TemporaryFileInfoMap & temporaryFileInfoMap, const Verbosity verbosity) {
+static void updateTemporaryCreationFlags(const TemporaryFileInfoMap & temporaryFileInfoMap, const boost::posix_time::time_duration & tolerance, const Verbosity verbosity) {
 	/* update PathLiteral::FORCED flag for each temporary within the provided map */
 	BOOST_FOREACH(const TemporaryFileInfoMap::value_type & keyValue, temporaryFileInfoMap) {
 		/* early out if already set for creation */
@@ -42,7 +47,7 @@ static void updateTemporaryCreationFlags(const TemporaryFileInfoMap & temporaryF
 				std::cerr << keyValue.first->getLineInfo() << ": Non-existing temporary target file will be created: " << keyValue.first->getString() << std::endl;
 			}
 			continue;
-		} else if ( pathElementWasModified(keyValue.second.mostRecentInputChange, keyValue.second.oldestOutputChange) ) {
+		} else if ( pathElementWasModified(keyValue.second.mostRecentInputChange, keyValue.second.oldestOutputChange, tolerance) ) {
 			/* input/output files all exist but input is younger than output */
 			keyValue.first->addFlags(PathLiteral::FORCED | PathLiteral::MODIFIED);
 			if (verbosity >= VERBOSITY_DEBUG) {
@@ -68,6 +73,51 @@ static void updateTemporaryCreationFlags(const TemporaryFileInfoMap & temporaryF
 }
 
 
+/**
+ * Local function to call the given function for each dependency tree in parallel.
+ *
+ * @param[in,out] processes - dependency trees to process
+ * @param[in,out] ios - I/O service to dispatch the function calls to
+ * @param[in] func - function to call with each dependency tree and its index
+ */
+static void forEachProcessNode(ProcessNodeVector & processes, boost::asio::io_service & ios, const boost::function2<void, ProcessNode &, const size_t> & func) {
+	TaskGroup tasks(processes.size() > 1 ? &ios : NULL);
+	for (size_t i = 0; i < processes.size(); i++) {
+		tasks.run(boost::phoenix::bind(func, boost::phoenix::ref(processes[i]), i));
+	}
+	tasks.wait();
+}
+
+
+/**
+ * Internal callback functor to load the content hash records from
+ * the database on first use.
+ */
+class LoadHashesCallback {
+private:
+	Database db; /**< Used database handle. */
+public:
+	/**
+	 * Constructor.
+	 * 
+	 * @param[in] aDb - database to load the records from
+	 */
+	explicit LoadHashesCallback(const Database & aDb) :
+		db(aDb)
+	{}
+	
+	/**
+	 * Functor to load all content hash records.
+	 *
+	 * @param[out] hashes - output variable for the content hash records
+	 * @return true on success, else false
+	 */
+	bool operator() (std::vector<ContentHash> & hashes) {
+		return this->db.getHashes(hashes);
+	}
+};
+
+
 /**
  * Internal callback functor to delete remaining files from previous
  * executions which got invalid.
@@ -75,16 +125,19 @@ static void updateTemporaryCreationFlags(const TemporaryFileInfoMap & temporaryF
 class DeleteRemainCallback {
 private:
 	Database & db; /**< Referred database handle. */
+	FileStatusCache & fileStatus; /**< Referred file meta data cache. */
 	std::ostream & out; /**< Referred output stream object. */
 public:
 	/**
 	 * Constructor.
 	 * 
 	 * @param[in,out] aDb - reference the used database
+	 * @param[in,out] aFileStatus - reference the used file meta data cache
 	 * @param[in,out] aOut - reference to the desired output stream
 	 */
-	explicit DeleteRemainCallback(Database & aDb, std::ostream & aOut) :
+	explicit DeleteRemainCallback(Database & aDb, FileStatusCache & aFileStatus, std::ostream & aOut) :
 		db(aDb),
+		fileStatus(aFileStatus),
 		out(aOut)
 	{}
 	
@@ -96,7 +149,7 @@ public:
 	 * @return true to continue (no other return value)
 	 */
 	bool operator() (const FileInformation & fileInfo) {
-		if ( boost::filesystem::exists(fileInfo.path) ) {
+		if ( this->fileStatus.get(fileInfo.path).exists() ) {
 			this->out << "deleting \"" << fileInfo.path.string(pcf::path::utf8) << "\": ";
 			if ( boost::filesystem::remove(fileInfo.path) ) {
 				this->out << "ok\n";
@@ -104,6 +157,7 @@ public:
 				this->out << "failed\n";
 				this->db.setFlags(fileInfo.path, 0); /* try again next time */
 			}
+			this->fileStatus.invalidate(fileInfo.path);
 		}
 		return true;
 	}
@@ -148,15 +202,17 @@ public:
 
 /**
  * Executes all prepare operations on the dependency tree. This needs to be called before
- * calling Execution::execute().
+ * calling Execution::execute(). Independent dependency trees and parallel nodes are
+ * prepared in parallel on the worker threads of the given scheduler.
  *
+ * @param[in,out] scheduler - reference to the scheduler instance for work dispatching
  * @param[in] callProgress - callback function called to show the current progress
  * @return true on success, else false
  */
-bool Execution::prepare(const ProgressCallback & callProgress) {
+bool Execution::prepare(Scheduler & scheduler, const ProgressCallback & callProgress) {
 	using namespace boost::phoenix::placeholders;
-	PathLiteralPtrVector output;
-	PathLiteralPtrVector duplicates;
+	boost::asio::io_service & ios(scheduler.getIoService());
+	const size_t treeCount = this->processes.size();
 	this->flatDependentMap.clear();
 	this->temporaryFileInfoMap.clear();
 	
@@ -175,28 +231,47 @@ bool Execution::prepare(const ProgressCallback & callProgress) {
 			node.traverseTopDown(boost::phoenix::bind<bool>(&Execution::resetProcessNode, _1, _2));
 		}
 	}
+	/* load all file records of the database at once */
+	this->loadFileSnapshot();
 	/* resolve dependencies */
 	{
 		const RuntimeCheck count(this->config.verbosity, "resolved dependencies");
-		BOOST_FOREACH(ProcessNode & node, this->processes) {
-			node.traverseDependencies(
-				boost::phoenix::bind<bool>(&Execution::solveDependencies, _1, _2),
-				output
-			);
+		/* serve unchanged directories from the directory listings stored in the database */
+		pcf::path::ReadDirectoryCallback indexReadDir;
+		boost::scoped_ptr<DirectoryIndex> index;
+		if ( this->db.isOpen() ) {
+			index.reset(new DirectoryIndex(this->db));
+			indexReadDir = boost::phoenix::bind(&DirectoryIndex::read, index.get(), _1, _2);
 		}
-	}
-	/* create flat dependent map */
-	{
-		const RuntimeCheck count(this->config.verbosity, "created flat dependent map");
-		BOOST_FOREACH(ProcessNode & node, this->processes) {
-			node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::createFlatDependentMap, this, _1, _2));
+		/* derive the last content change of input files from the content hashes stored in the database */
+		if ( this->db.isOpen() ) {
+			this->config.contentHashes->open(LoadHashesCallback(this->db));
+		} else {
+			this->config.contentHashes->unload();
+		}
+		/* record the read directories for watch mode */
+		boost::mutex inputDirectoriesMutex;
+		this->inputDirectories.clear();
+		const pcf::path::ReadDirectoryCallback readDir(boost::phoenix::bind(&Execution::readInputDirectory, _1, _2, boost::phoenix::cref(indexReadDir), boost::phoenix::ref(this->inputDirectories), boost::phoenix::ref(inputDirectoriesMutex)));
+		forEachProcessNode(this->processes, ios, boost::phoenix::bind(&Execution::solveTreeDependencies, _1, _2, &ios, boost::phoenix::cref(readDir)));
+		if ( index ) index->flush();
+		if ( this->db.isOpen() ) {
+			std::vector<ContentHash> hashes;
+			std::vector<boost::filesystem::path> removed;
+			this->config.contentHashes->takePending(hashes);
+			this->config.contentHashes->takeRemoved(removed);
+			this->db.updateHashes(hashes);
+			this->db.deleteHashes(removed);
 		}
 	}
+	/* create flat dependent map */
+	this->prepareFlatDependentMap(ios);
 	/* check for duplicates in outputs and abort with an error in such case */
 	{
 		const RuntimeCheck count(this->config.verbosity, "checked for duplicates in outputs");
-		BOOST_FOREACH(ProcessNode & node, this->processes) {
-			node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::checkDuplicates, _1, _2, boost::phoenix::ref(duplicates)));
+		std::vector<PathLiteralPtrVector> treeDuplicates(treeCount);
+		forEachProcessNode(this->processes, ios, boost::phoenix::bind(&Execution::checkTreeDuplicates, _1, _2, boost::phoenix::ref(treeDuplicates)));
+		BOOST_FOREACH(const PathLiteralPtrVector & duplicates, treeDuplicates) {
 			if ( ! duplicates.empty() ) {
 				std::cerr << "Error: Same destination path for different inputs. Destination paths (reduced list):" << std::endl;
 				const std::set<boost::shared_ptr<PathLiteral>, LessPathLiteralPtrValueLocation> dups(duplicates.begin(), duplicates.end());
@@ -210,63 +285,203 @@ bool Execution::prepare(const ProgressCallback & callProgress) {
 	/* create helper map to decide which temporaries need to be created and which not */
 	{
 		const RuntimeCheck count(this->config.verbosity, "updated creation flag for temporary transitions");
-		BOOST_FOREACH(ProcessNode & node, this->processes) {
-			/* remark: overlapping between different process nodes cannot happen due to the reference via pointer within the map keys */
-			node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::createTemporaryInputFileInfoMap, this, _1, _2));
+		/* remark: overlapping between different process nodes cannot happen due to the reference via pointer within the map keys */
+		std::vector<TemporaryFileInfoMap> infoMaps(treeCount);
+		forEachProcessNode(this->processes, ios, boost::phoenix::bind(&Execution::createTreeTemporaryFileInfoMap, _1, _2, boost::phoenix::ref(infoMaps)));
+		BOOST_FOREACH(const TemporaryFileInfoMap & infoMap, infoMaps) {
+			this->temporaryFileInfoMap.insert(infoMap.begin(), infoMap.end());
 		}
 		if ( ! this->temporaryFileInfoMap.empty() ) {
-			BOOST_FOREACH(ProcessNode & node, this->processes) {
-				node.traverseTopDown(boost::phoenix::bind<bool>(&Execution::createTemporaryOutputFileInfoMap, this, _1, _2));
-			}
 			/* update temporary creation flag based on just created helper map */
-			updateTemporaryCreationFlags(this->temporaryFileInfoMap, this->config.verbosity);
+			updateTemporaryCreationFlags(this->temporaryFileInfoMap, this->config.modificationTolerance, this->config.verbosity);
 			/* propagate PathLiteral::FORCED flag (set due to temporary creation check) */
-			BOOST_FOREACH(ProcessNode & node, this->processes) {
-				node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::propagateForcedFlag, this, _1, _2));
-			}
+			forEachProcessNode(this->processes, ios, boost::phoenix::bind(&Execution::propagateTreeForcedFlag, _1, _2));
 		}
 	}
 	/* prepare */
+	this->prepareCommands(callProgress);
+	return true;
+}
+
+
+/**
+ * Updates the prepared dependency tree after the given paths changed. The dependency tree is
+ * kept if only the content of known input or dependency files changed. Only the build flags are
+ * updated in this case. Execution::execute() then runs the transitions affected by the change
+ * and their dependents. New, removed or renamed input files, changed input file lists and
+ * dependency trees with temporary files require to call Execution::prepare() instead.
+ *
+ * @param[in] changed - normalized paths which changed since the last execution
+ * @param[in,out] scheduler - reference to the scheduler instance for work dispatching
+ * @param[in] callProgress - callback function called to show the current progress
+ * @return true if the dependency tree was updated, false if it needs to be prepared again
+ * @see FileWatcher::wait()
+ */
+bool Execution::update(const std::set<boost::filesystem::path> & changed, Scheduler & scheduler, const ProgressCallback & callProgress) {
+	using namespace boost::phoenix::placeholders;
+	/* temporary files are created depending on the whole dependency tree */
+	if ( ! this->temporaryFileInfoMap.empty() ) return false;
+	/* changes were lost */
+	if (changed.find(boost::filesystem::path()) != changed.end()) return false;
 	{
-		const RuntimeCheck count(this->config.verbosity, "counted needed command executions");
-		if ( ! this->config.printOnly ) {
-			/* count commands that need to be executed */
-			BOOST_FOREACH(ProcessNode & node, this->processes) {
-				node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::countCommands, _1, _2, callProgress));
+		const RuntimeCheck count(this->config.verbosity, "checked changed paths");
+		std::set<boost::filesystem::path> inputs, files;
+		BOOST_FOREACH(const boost::filesystem::path & dir, this->inputDirectories) {
+			inputs.insert(FileWatcher::normalizePath(dir));
+		}
+		BOOST_FOREACH(ProcessNode & node, this->processes) {
+			node.traverseTopDown(boost::phoenix::bind<bool>(&Execution::addInputLists, _1, _2, boost::phoenix::ref(inputs)));
+			node.traverseTopDown(boost::phoenix::bind<bool>(&Execution::addDependencyFiles, _1, _2, boost::phoenix::ref(files)));
+		}
+		BOOST_FOREACH(const boost::filesystem::path & path, changed) {
+			/* changed input directory or input file list */
+			if (inputs.find(path) != inputs.end()) return false;
+			if (files.find(path) == files.end()) {
+				/* new files within input directories may be new input files */
+				if (inputs.find(FileWatcher::normalizePath(path.parent_path())) != inputs.end()) return false;
+				continue;
 			}
+			/* removed input or dependency file */
+			if ( ! this->config.fileStatus->get(path).exists() ) return false;
 		}
 	}
+	/* update build flags */
+	{
+		const RuntimeCheck count(this->config.verbosity, "updated build flags");
+		BOOST_FOREACH(ProcessNode & node, this->processes) {
+			node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::updateProcessNode, _1, _2, boost::phoenix::cref(changed)));
+		}
+		if ( this->db.isOpen() ) {
+			std::vector<ContentHash> hashes;
+			this->config.contentHashes->takePending(hashes);
+			this->db.updateHashes(hashes);
+		}
+	}
+	/* load all file records of the database at once */
+	this->loadFileSnapshot();
+	/* create flat dependent map */
+	this->flatDependentMap.clear();
+	this->prepareFlatDependentMap(scheduler.getIoService());
+	/* prepare */
+	this->prepareCommands(callProgress);
 	return true;
 }
 
 
+/**
+ * Loads all file records of the database at once if enabled by the configuration.
+ */
+void Execution::loadFileSnapshot() {
+	this->fileSnapshot.reset();
+	if (this->config.removeRemains && this->config.databaseSnapshot && this->db.isOpen()) {
+		const RuntimeCheck count(this->config.verbosity, "loaded file records of the database");
+		this->fileSnapshot = boost::make_shared<FileSnapshot>(this->db);
+		if ( ! this->fileSnapshot->load() ) this->fileSnapshot.reset();
+	}
+}
+
+
+/**
+ * Creates the flat dependent map from the prepared transitions. Independent dependency trees
+ * are processed in parallel on the given I/O service.
+ *
+ * @param[in,out] ios - I/O service to dispatch the dependency trees to
+ */
+void Execution::prepareFlatDependentMap(boost::asio::io_service & ios) {
+	using namespace boost::phoenix::placeholders;
+	const RuntimeCheck count(this->config.verbosity, "created flat dependent map");
+	std::vector<PathLiteralPtrDependentMap> flatMaps(this->processes.size());
+	forEachProcessNode(this->processes, ios, boost::phoenix::bind(&Execution::createTreeFlatDependentMap, _1, _2, boost::phoenix::ref(flatMaps)));
+	/* merge in order of the dependency trees to keep the first added path literal as key */
+	BOOST_FOREACH(const PathLiteralPtrDependentMap & flatMap, flatMaps) {
+		BOOST_FOREACH(const PathLiteralPtrDependentMap::value_type & keyValue, flatMap) {
+			this->flatDependentMap[keyValue.first].insert(keyValue.second.begin(), keyValue.second.end());
+		}
+	}
+}
+
+
+/**
+ * Estimates the runtimes of the prepared transitions and counts the commands which need to be
+ * executed for progress visualization.
+ *
+ * @param[in] callProgress - callback function called to count the commands to be executed
+ */
+void Execution::prepareCommands(const ProgressCallback & callProgress) {
+	using namespace boost::phoenix::placeholders;
+	const RuntimeCheck count(this->config.verbosity, "counted needed command executions");
+	if ( this->config.printOnly ) return;
+	/* estimate runtimes from previous executions */
+	if ( this->db.isOpen() ) {
+		BOOST_FOREACH(ProcessNode & node, this->processes) {
+			node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::loadRuntimes, this, _1, _2));
+		}
+	}
+	/* count commands that need to be executed */
+	BOOST_FOREACH(ProcessNode & node, this->processes) {
+		node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::countCommands, _1, _2, callProgress));
+	}
+}
+
+
 /**
  * Executes the command within the dependency tree in order and parallel.
  * Execution::prepare() needs to be called beforehand and Execution::complete()
  * afterwards.
  * 
- * @param[in,out] ioService - reference to the I/O service instance for work dispatching
+ * @param[in,out] scheduler - reference to the scheduler instance for work dispatching
  * @param[in] callProgress - callback function called to show the current progress
  * @param[in] callFinally - callback function to be executed if all tasks have been done
+ * @param[in,out] isFirst - needs to be set to true beforehand for internal functions
  * @return true on success, else false
+ * @remarks The results of each process are logged as soon as the process has finished.
  */
-bool Execution::execute(boost::asio::io_service & ioService, const ProgressCallback & callProgress, const ExecutionCallback & callFinally) {
+bool Execution::execute(Scheduler & scheduler, const ProgressCallback & callProgress, const ExecutionCallback & callFinally, bool & isFirst) {
 	using namespace boost::phoenix::placeholders;
 	const RuntimeCheck count(this->config.verbosity, "queued commands for execution");
+	this->logIsFirst = &isFirst;
+	this->loggedProcesses.clear();
 	
 	/* execute */
 	if ( this->config.printOnly ) {
 		BOOST_FOREACH(ProcessNode & node, this->processes) {
 			node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::printCallback, this, _1, _2));
 		}
+	} else if ( this->config.pipelinedExecution ) {
+		/* link transitions to the transitions producing their input dependencies */
+		ProcessTransitionProducerMap producers;
+		BOOST_FOREACH(ProcessNode & node, this->processes) {
+			node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::addPipelineProducers, _1, _2, boost::phoenix::ref(producers)));
+		}
+		BOOST_FOREACH(ProcessNode & node, this->processes) {
+			node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::linkPipelineInputs, _1, _2, boost::phoenix::cref(producers)));
+		}
+		/* prefer transitions on the longest remaining path */
+		BOOST_FOREACH(ProcessNode & node, this->processes) {
+			node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::updatePipelinePriorities, _1, _2));
+		}
+		boost::mutex::scoped_lock lock(this->mutex);
+		this->processesInQueue = this->processes.size();
+		lock.unlock();
+		/* execute commands */
+		BOOST_FOREACH(ProcessNode & node, this->processes) {
+			node.executePipelined(
+				boost::phoenix::bind(&Execution::executeProcess, this, boost::phoenix::ref(scheduler), callProgress, _1, _2),
+				boost::phoenix::bind(&Execution::finished, this, callFinally)
+			);
+		}
 	} else {
+		/* prefer transitions on the longest remaining path */
+		BOOST_FOREACH(ProcessNode & node, this->processes) {
+			node.updatePriorities();
+		}
 		boost::mutex::scoped_lock lock(this->mutex);
 		this->processesInQueue = this->processes.size();
 		lock.unlock();
 		/* execute commands */
 		BOOST_FOREACH(ProcessNode & node, this->processes) {
 			node.executeChain(
-				boost::phoenix::bind(&Execution::executeProcess, boost::phoenix::ref(ioService), callProgress, _1, _2),
+				boost::phoenix::bind(&Execution::executeProcess, this, boost::phoenix::ref(scheduler), callProgress, _1, _2),
 				boost::phoenix::bind(&Execution::finished, this, callFinally)
 			);
 		}
@@ -307,12 +522,14 @@ bool Execution::complete(bool & isFirst) {
 			BOOST_FOREACH(const PathLiteralPtrDependentMap::value_type & flatDependent, this->flatDependentMap) {
 				if (flatDependent.first->hasFlags(PathLiteral::TEMPORARY) && flatDependent.second.empty()) {
 					/* is temporary and has no remaining dependent */
+					const boost::filesystem::path path(flatDependent.first->getString(), pcf::path::utf8);
 					sout << "deleting \"" << flatDependent.first->getString() << "\": ";
-					if ( boost::filesystem::remove(boost::filesystem::path(flatDependent.first->getString(), pcf::path::utf8)) ) {
+					if ( boost::filesystem::remove(path) ) {
 						sout << "ok\n";
 					} else {
 						sout << "failed\n";
 					}
+					this->config.fileStatus->invalidate(path);
 				}
 			}
 			const std::string output(sout.str());
@@ -342,21 +559,57 @@ bool Execution::complete(bool & isFirst) {
 				lout << "clean-up-incompletes {\n" << output << "}" << std::endl;
 			}
 		}
+		/* record runtimes of executed transitions */
+		if ( this->db.isOpen() ) {
+			const RuntimeCheck count(this->config.verbosity, "recorded runtimes of executed transitions");
+			TransitionRuntimeVector runtimes;
+			BOOST_FOREACH(ProcessNode & node, this->processes) {
+				node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::addRuntimes, _1, _2, boost::phoenix::ref(runtimes)));
+			}
+			if ( ! this->db.addRuntimes(runtimes) ) {
+				if (this->config.verbosity >= VERBOSITY_WARN) std::cerr << "Warning: Failed to update runtime information in database." << std::endl;
+			}
+		}
 		/* delete old remains and update database */
 		if (this->config.removeRemains && this->db.isOpen()) {
 			const RuntimeCheck count(this->config.verbosity, "deleted old remains and updated database");
-			this->db.setAllFlags(1); /* reset marks */
-			/* mark all output files */
+			std::vector<FileInformation> outputs;
 			BOOST_FOREACH(ProcessNode & node, this->processes) {
-				node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::markOutputFilesInDatabase, this, _1, _2));
+				node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::addOutputFiles, _1, _2, boost::phoenix::ref(outputs)));
 			}
 			std::ostringstream sout;
-			/* file delete callback */
-			this->db.forEachFileByFlag(DeleteRemainCallback(this->db, sout), 1);
-			this->db.deleteFilesByFlag(1);
-			/* set real flags */
-			BOOST_FOREACH(ProcessNode & node, this->processes) {
-				node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::setFlagsInDatabase, this, _1, _2));
+			if ( this->fileSnapshot && this->fileSnapshot->isLoaded() ) {
+				/* write back only the difference to the file records loaded during preparation */
+				std::vector<FileInformation> changed, remains;
+				std::vector<boost::filesystem::path> deleted;
+				this->fileSnapshot->getDelta(changed, remains, outputs);
+				this->fileSnapshot.reset();
+				DeleteRemainCallback deleteRemain(this->db, *(this->config.fileStatus), sout);
+				BOOST_FOREACH(const FileInformation & remain, remains) {
+					deleteRemain(remain);
+					/* keep the records of files which could not be deleted */
+					if ( ! this->config.fileStatus->get(remain.path).exists() ) deleted.push_back(remain.path);
+				}
+				if ( ! (this->db.deleteFiles(deleted) && this->db.updateFiles(changed)) ) {
+					if (this->config.verbosity >= VERBOSITY_WARN) std::cerr << "Warning: Failed to update database." << std::endl;
+				}
+			} else {
+				this->db.setAllFlags(1); /* reset marks */
+				/* mark all output files */
+				this->db.updateFiles(outputs, static_cast<boost::uint64_t>(0));
+				/* file delete callback */
+				this->db.forEachFileByFlag(DeleteRemainCallback(this->db, *(this->config.fileStatus), sout), 1);
+				this->db.deleteFilesByFlag(1);
+				/* set real flags */
+				std::vector<boost::filesystem::path> failed;
+				if ( ! this->db.setFlags(outputs, failed) ) {
+					if (this->config.verbosity >= VERBOSITY_WARN) std::cerr << "Warning: Failed to update database flags." << std::endl;
+				}
+				if (this->config.verbosity >= VERBOSITY_WARN) {
+					BOOST_FOREACH(const boost::filesystem::path & path, failed) {
+						std::cerr << "Warning: Failed to update database flags for \"" << path << "\"." << std::endl;
+					}
+				}
 			}
 			const std::string output(sout.str());
 			if ( ! output.empty() ) {
@@ -373,4 +626,32 @@ bool Execution::complete(bool & isFirst) {
 }
 
 
+/**
+ * Collects the paths which affect the result of the last prepared execution. These are the
+ * directories read while resolving the initial input files, the input and dependency files of
+ * all transitions and the input file list files. The output files and the database files are
+ * returned separately to distinguish changes made by pp and the executed commands.
+ *
+ * @param[in,out] paths - add the paths to watch for changes here
+ * @param[in,out] outputs - add the output files here
+ */
+void Execution::getWatchPaths(std::set<boost::filesystem::path> & paths, std::set<boost::filesystem::path> & outputs) {
+	using namespace boost::phoenix::placeholders;
+	paths.insert(this->inputDirectories.begin(), this->inputDirectories.end());
+	BOOST_FOREACH(ProcessNode & node, this->processes) {
+		node.traverseTopDown(boost::phoenix::bind<bool>(&Execution::addWatchPaths, _1, _2, boost::phoenix::ref(paths), boost::phoenix::ref(outputs)));
+	}
+	/* files written by the database backends */
+	if ( this->db.isOpen() ) {
+		const boost::filesystem::path dbPath(this->db.getPath());
+		static const char * const suffixes[] = {"", "-journal", "-wal", "-shm", ".tmp", ".lock"};
+		BOOST_FOREACH(const char * const suffix, suffixes) {
+			boost::filesystem::path path(dbPath);
+			path += suffix;
+			outputs.insert(path);
+		}
+	}
+}
+
+
 } /* namespace pp */
@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2015-2018 Daniel Starke
  * @date 2015-03-22
- * @version 2016-12-29
+ * @version 2026-10-17
  */
 #ifndef __PP_EXECUTION_HPP__
 #define __PP_EXECUTION_HPP__
@@ -14,11 +14,14 @@
 #include <iosfwd>
 #include <set>
 #include <string>
+#include <vector>
 #include <boost/asio.hpp>
 #include <boost/config/warning_disable.hpp>
 #include <boost/filesystem/path.hpp>
 #include <boost/foreach.hpp>
 #include <boost/optional.hpp>
+#include <boost/phoenix/bind.hpp>
+#include <boost/phoenix/core.hpp>
 #include <boost/range/algorithm_ext/push_back.hpp>
 #include <boost/shared_ptr.hpp>
 /* workaround for boost::phoenix::bind and boost::bind namespace collision */
@@ -29,7 +32,10 @@
 #include <pcf/file/Stream.hpp>
 #include <pcf/path/Utility.hpp>
 #include "Database.hpp"
+#include "FileSnapshot.hpp"
 #include "ProcessNode.hpp"
+#include "Scheduler.hpp"
+#include "Utility.hpp"
 #include "Variable.hpp"
 #include "Type.hpp"
 
@@ -52,16 +58,21 @@ private:
 	boost::shared_ptr<pcf::file::ofstream> logFile; /**< Logging file. */
 	boost::optional<std::ostream &> log; /**< Optional output stream for logging. */
 	Database db; /**< Internal database handle. */
+	boost::shared_ptr<FileSnapshot> fileSnapshot; /**< File records of the database loaded during preparation. */
 	PathLiteralPtrDependentMap flatDependentMap; /**< Flat dependency map for temporary file handling. */
 	TemporaryFileInfoMap temporaryFileInfoMap; /**< Information map for temporary file handling. */
 	size_t processesInQueue; /**< Number of remaining processes within the execution queue. */
+	bool * logIsFirst; /**< Output formatting state of the log output during execution. */
+	std::set<const Process *> loggedProcesses; /**< Processes whose results were already logged during execution. */
+	std::set<boost::filesystem::path> inputDirectories; /**< Directories read while resolving the initial input files. */
 	mutable boost::mutex mutex; /**< Mutex object for parallel execution. */
 public:
 	/** Default constructor. */
 	explicit Execution():
 		processes(),
 		config(),
-		db()
+		db(),
+		logIsFirst(NULL)
 	{};
 	
 	/**
@@ -73,7 +84,8 @@ public:
 	explicit Execution(const ProcessNodeVector & p, const Configuration & c = Configuration()):
 		processes(p),
 		config(c),
-		db()
+		db(),
+		logIsFirst(NULL)
 	{}
 	
 	/**
@@ -89,9 +101,13 @@ public:
 		logFile(o.logFile),
 		log(o.log),
 		db(o.db),
+		fileSnapshot(o.fileSnapshot),
 		flatDependentMap(o.flatDependentMap),
 		temporaryFileInfoMap(o.temporaryFileInfoMap),
-		processesInQueue(o.processesInQueue)
+		processesInQueue(o.processesInQueue),
+		logIsFirst(o.logIsFirst),
+		loggedProcesses(o.loggedProcesses),
+		inputDirectories(o.inputDirectories)
 	{}
 	
 	/**
@@ -109,9 +125,13 @@ public:
 			this->logFile = o.logFile;
 			this->log = o.log;
 			this->db = o.db;
+			this->fileSnapshot = o.fileSnapshot;
 			this->flatDependentMap = o.flatDependentMap;
 			this->temporaryFileInfoMap = o.temporaryFileInfoMap;
 			this->processesInQueue = o.processesInQueue;
+			this->logIsFirst = o.logIsFirst;
+			this->loggedProcesses = o.loggedProcesses;
+			this->inputDirectories = o.inputDirectories;
 		}
 		return *this;
 	}
@@ -219,10 +239,11 @@ public:
 	 * Opens the database at the given location for internal operations.
 	 *
 	 * @param[in] path - database location
+	 * @param[in] format - storage format of the database
 	 * @return reference to this object for chained operations
 	 */
-	Execution & setDatabase(const boost::filesystem::path & path) {
-		this->db.open(path);
+	Execution & setDatabase(const boost::filesystem::path & path, const Database::Format format = Database::SQLITE) {
+		this->db.open(path, format);
 		if ( ! this->db.isOpen() ) {
 			/* failed to open database */
 			BOOST_THROW_EXCEPTION(
@@ -233,10 +254,16 @@ public:
 		return *this;
 	}
 	
-	bool prepare(const ProgressCallback & callProgress);
-	bool execute(boost::asio::io_service & ioService, const ProgressCallback & callProgress, const ExecutionCallback & callFinally);
+	bool prepare(Scheduler & scheduler, const ProgressCallback & callProgress);
+	bool update(const std::set<boost::filesystem::path> & changed, Scheduler & scheduler, const ProgressCallback & callProgress);
+	bool execute(Scheduler & scheduler, const ProgressCallback & callProgress, const ExecutionCallback & callFinally, bool & isFirst);
 	bool complete(bool & isFirst);
+	void getWatchPaths(std::set<boost::filesystem::path> & paths, std::set<boost::filesystem::path> & outputs);
 private:
+	void loadFileSnapshot();
+	void prepareFlatDependentMap(boost::asio::io_service & ios);
+	void prepareCommands(const ProgressCallback & callProgress);
+	
 	/**
 	 * Callback function to print out the process tree.
 	 * 
@@ -261,18 +288,46 @@ private:
 		element.process.reset();
 		return true;
 	}
+	/**
+	 * Callback function to read the entries of a directory while resolving the initial input
+	 * files. The directory and its sub-directories are recorded to be watched for changes. The
+	 * sub-directories are needed to catch new input files within directories which did not
+	 * contain any matching path before.
+	 *
+	 * @param[in,out] entries - append directory entries to this vector
+	 * @param[in] dir - directory to read
+	 * @param[in] readDir - callback function to read the directory (optional)
+	 * @param[in,out] dirs - add the directory to this set
+	 * @param[in,out] mutex - mutex to protect the directory set
+	 */
+	static void readInputDirectory(std::vector<pcf::path::DirectoryEntry> & entries, const boost::filesystem::path & dir, const pcf::path::ReadDirectoryCallback & readDir, std::set<boost::filesystem::path> & dirs, boost::mutex & mutex) {
+		const size_t first = entries.size();
+		if ( readDir ) {
+			readDir(entries, dir);
+		} else {
+			pcf::path::readDirectory(entries, dir);
+		}
+		boost::mutex::scoped_lock lock(mutex);
+		dirs.insert(dir.empty() ? boost::filesystem::path(".") : dir);
+		for (size_t i = first; i < entries.size(); i++) {
+			if (entries[i].type != pcf::path::ENTRY_REGULAR && entries[i].type != pcf::path::ENTRY_OTHER) dirs.insert(dir / entries[i].name);
+		}
+	}
+	
 	/**
 	 * Callback function to resolve the dependencies of a given process node.
 	 *
 	 * @param[in,out] element - resolve dependencies of this node
 	 * @param[out] output - write list of output files to this variable
+	 * @param[in] readDir - callback function to read the entries of a directory
+	 * @param[in,out] ios - I/O service to read input directories in parallel on
 	 * @return true on success, else false
 	 */
-	static bool solveDependencies(ProcessNode::ValueType & element, PathLiteralPtrVector & output) {
+	static bool solveDependencies(ProcessNode::ValueType & element, PathLiteralPtrVector & output, const pcf::path::ReadDirectoryCallback & readDir, boost::asio::io_service * ios) {
 		bool result;
 		if ( ! element.initialInput.empty() ) {
 			BOOST_FOREACH(const StringLiteral & literal, element.initialInput) {
-				if ( ! element.process.createInitialInputList(literal, element.input) ) {
+				if ( ! element.process.createInitialInputList(literal, element.input, readDir, ios) ) {
 					return false;
 				}
 			}
@@ -283,53 +338,168 @@ private:
 	}
 	
 	/**
-	 * Callback method to create the flat dependency map.
+	 * Resolves the dependencies of the given dependency tree.
+	 *
+	 * @param[in,out] node - dependency tree to process
+	 * @param[in] index - index of the dependency tree
+	 * @param[in,out] ios - I/O service to traverse parallel nodes and read input directories on
+	 * @param[in] readDir - callback function to read the entries of a directory
+	 */
+	static void solveTreeDependencies(ProcessNode & node, const size_t /* index */, boost::asio::io_service * ios, const pcf::path::ReadDirectoryCallback & readDir) {
+		using namespace boost::phoenix::placeholders;
+		PathLiteralPtrVector output;
+		node.traverseDependencies(boost::phoenix::bind<bool>(&Execution::solveDependencies, _1, _2, boost::phoenix::cref(readDir), ios), output, ios);
+	}
+	
+	/**
+	 * Callback function to collect the paths which affect the given process node.
+	 *
+	 * @param[in] element - collect paths of this process node
+	 * @param[in] level - hierarchical level of the given process node with the dependency tree
+	 * @param[in,out] paths - add input and dependency files here
+	 * @param[in,out] outputs - add output files here
+	 * @return true
+	 */
+	static bool addWatchPaths(ProcessNode::ValueType & element, const size_t level, std::set<boost::filesystem::path> & paths, std::set<boost::filesystem::path> & outputs) {
+		Execution::addInputLists(element, level, paths);
+		element.process.addWatchPaths(paths, outputs);
+		return true;
+	}
+	
+	/**
+	 * Callback function to collect the input file lists of the given process node.
+	 *
+	 * @param[in] element - collect input file lists of this process node
+	 * @param[in] level - hierarchical level of the given process node with the dependency tree
+	 * @param[in,out] paths - add the normalized paths of the input file lists here
+	 * @return true
+	 */
+	static bool addInputLists(ProcessNode::ValueType & element, const size_t /* level */, std::set<boost::filesystem::path> & paths) {
+		BOOST_FOREACH(const StringLiteral & literal, element.initialInput) {
+			const std::string str(literal.getString());
+			if (( ! str.empty() ) && str[0] == '@') paths.insert(FileWatcher::normalizePath(boost::filesystem::path(str.substr(1), pcf::path::utf8)));
+		}
+		return true;
+	}
+	
+	/**
+	 * Callback function to collect the input and dependency files of the given process node.
+	 *
+	 * @param[in] element - collect files of this process node
+	 * @param[in] level - hierarchical level of the given process node with the dependency tree
+	 * @param[in,out] files - add the normalized paths here
+	 * @return true
+	 */
+	static bool addDependencyFiles(ProcessNode::ValueType & element, const size_t /* level */, std::set<boost::filesystem::path> & files) {
+		element.process.addDependencyFiles(files);
+		return true;
+	}
+	
+	/**
+	 * Callback function to prepare the given process node for another execution after the given
+	 * files changed.
+	 *
+	 * @param[in,out] element - update this process node
+	 * @param[in] level - hierarchical level of the given process node with the dependency tree
+	 * @param[in] changed - normalized paths of the changed files
+	 * @return true
+	 * @see update()
+	 */
+	static bool updateProcessNode(ProcessNode::ValueType & element, const size_t /* level */, const std::set<boost::filesystem::path> & changed) {
+		element.process.resetExecution();
+		element.process.updateBuildFlags(changed);
+		return true;
+	}
+	
+	/**
+	 * Callback function to create the flat dependency map.
 	 * 
-	 * @param[in,out] element - add dependencies of this process node to the internal flat dependency map
+	 * @param[in,out] element - add dependencies of this process node to the given flat dependency map
 	 * @param[in] level - hierarchical level of the given process node with the dependency tree
+	 * @param[in,out] flatMap - update this map
 	 * @return true
 	 */
-	bool createFlatDependentMap(ProcessNode::ValueType & element, const size_t /* level */) {
-		element.process.createFlatDependentMap(this->flatDependentMap);
+	static bool createFlatDependentMap(ProcessNode::ValueType & element, const size_t /* level */, PathLiteralPtrDependentMap & flatMap) {
+		element.process.createFlatDependentMap(flatMap);
 		return true;
 	}
 	
 	/**
-	 * Callback method to create the temporary input files.
+	 * Creates the flat dependency map of the given dependency tree.
+	 *
+	 * @param[in,out] node - dependency tree to process
+	 * @param[in] index - index of the dependency tree
+	 * @param[in,out] flatMaps - update the map with the given index
+	 */
+	static void createTreeFlatDependentMap(ProcessNode & node, const size_t index, std::vector<PathLiteralPtrDependentMap> & flatMaps) {
+		using namespace boost::phoenix::placeholders;
+		node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::createFlatDependentMap, _1, _2, boost::phoenix::ref(flatMaps[index])));
+	}
+	
+	/**
+	 * Callback function to create the temporary input files.
 	 *
-	 * @param[in,out] element - add temporary input file details of this process node to the internal map
+	 * @param[in,out] element - add temporary input file details of this process node to the given map
 	 * @param[in] level - hierarchical level of the given process node with the dependency tree
+	 * @param[in,out] infoMap - update this map
 	 * @return true
 	 */
-	bool createTemporaryInputFileInfoMap(ProcessNode::ValueType & element, const size_t /* level */) {
-		element.process.createTemporaryInputFileInfoMap(this->temporaryFileInfoMap);
+	static bool createTemporaryInputFileInfoMap(ProcessNode::ValueType & element, const size_t /* level */, TemporaryFileInfoMap & infoMap) {
+		element.process.createTemporaryInputFileInfoMap(infoMap);
 		return true;
 	}
 	
 	/**
-	 * Callback method to create the temporary output files.
+	 * Callback function to create the temporary output files.
 	 *
-	 * @param[in,out] element - add temporary output file details of this process node to the internal map
+	 * @param[in,out] element - add temporary output file details of this process node to the given map
 	 * @param[in] level - hierarchical level of the given process node with the dependency tree
+	 * @param[in,out] infoMap - update this map
 	 * @return true
 	 */
-	bool createTemporaryOutputFileInfoMap(ProcessNode::ValueType & element, const size_t /* level */) {
-		element.process.createTemporaryOutputFileInfoMap(this->temporaryFileInfoMap);
+	static bool createTemporaryOutputFileInfoMap(ProcessNode::ValueType & element, const size_t /* level */, TemporaryFileInfoMap & infoMap) {
+		element.process.createTemporaryOutputFileInfoMap(infoMap);
 		return true;
 	}
 	
 	/**
-	 * Callback method to propagate the forced flag to all dependent process nodes.
+	 * Creates the temporary file information map of the given dependency tree.
+	 *
+	 * @param[in,out] node - dependency tree to process
+	 * @param[in] index - index of the dependency tree
+	 * @param[in,out] infoMaps - update the map with the given index
+	 */
+	static void createTreeTemporaryFileInfoMap(ProcessNode & node, const size_t index, std::vector<TemporaryFileInfoMap> & infoMaps) {
+		using namespace boost::phoenix::placeholders;
+		node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::createTemporaryInputFileInfoMap, _1, _2, boost::phoenix::ref(infoMaps[index])));
+		if ( ! infoMaps[index].empty() ) {
+			node.traverseTopDown(boost::phoenix::bind<bool>(&Execution::createTemporaryOutputFileInfoMap, _1, _2, boost::phoenix::ref(infoMaps[index])));
+		}
+	}
+	
+	/**
+	 * Callback function to propagate the forced flag to all dependent process nodes.
 	 *
 	 * @param[in,out] element - element to process
 	 * @param[in] level - hierarchical level of the given process node with the dependency tree
 	 * @return true
 	 */
-	bool propagateForcedFlag(ProcessNode::ValueType & element, const size_t /* level */) {
+	static bool propagateForcedFlag(ProcessNode::ValueType & element, const size_t /* level */) {
 		element.process.propagateForcedFlag();
 		return true;
 	}
 	
+	/**
+	 * Propagates the forced flag within the given dependency tree.
+	 *
+	 * @param[in,out] node - dependency tree to process
+	 * @param[in] index - index of the dependency tree
+	 */
+	static void propagateTreeForcedFlag(ProcessNode & node, const size_t /* index */) {
+		using namespace boost::phoenix::placeholders;
+		node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::propagateForcedFlag, _1, _2));
+	}
+	
 	/**
 	 * Callback function to check if the given process node creates the same output files like
 	 * another one.
@@ -360,6 +530,18 @@ private:
 		return duplicates.empty();
 	}
 	
+	/**
+	 * Checks the given dependency tree for duplicate outputs.
+	 *
+	 * @param[in,out] node - dependency tree to process
+	 * @param[in] index - index of the dependency tree
+	 * @param[out] duplicates - add the duplicates to the list with the given index
+	 */
+	static void checkTreeDuplicates(ProcessNode & node, const size_t index, std::vector<PathLiteralPtrVector> & duplicates) {
+		using namespace boost::phoenix::placeholders;
+		node.traverseBottomUp(boost::phoenix::bind<bool>(&Execution::checkDuplicates, _1, _2, boost::phoenix::ref(duplicates[index])));
+	}
+	
 	/**
 	 * Callback method to print the commands that would be executed.
 	 *
@@ -381,6 +563,7 @@ private:
 	 * @return true
 	 */
 	bool logCallback(ProcessNode::ValueType & element, const size_t /* level */, bool & isFirst) {
+		if (this->loggedProcesses.count(&(element.process)) > 0) return true; /* already logged during execution */
 		if ( this->log ) element.process.print(*(this->log), isFirst);
 		else element.process.print(std::cout, isFirst);
 		return true;
@@ -395,24 +578,97 @@ private:
 	 * @return true
 	 */
 	static bool countCommands(ProcessNode::ValueType & element, const size_t /* level */, const ProgressCallback & callProgress) {
-		if ( callProgress ) callProgress(false, element.process.countCommands());
+		element.process.countCommands(callProgress);
+		return true;
+	}
+	
+	/**
+	 * Callback method to estimate the runtime of the given process node from previous executions.
+	 *
+	 * @param[in,out] element - element to process
+	 * @param[in] level - hierarchical level of the given process node with the dependency tree
+	 * @return true
+	 */
+	bool loadRuntimes(ProcessNode::ValueType & element, const size_t /* level */) {
+		element.process.loadRuntimes(this->db);
 		return true;
 	}
 	
 	/**
-	 * Callback function to execute the commands of the given process node.
+	 * Callback function to add the outputs of the given process node to the producer map.
 	 *
-	 * @param[in,out] ioService - dispatch operations to the I/O service
+	 * @param[in,out] element - element to process
+	 * @param[in] level - hierarchical level of the given process node with the dependency tree
+	 * @param[in,out] producers - update this map
+	 * @return true
+	 */
+	static bool addPipelineProducers(ProcessNode::ValueType & element, const size_t /* level */, ProcessTransitionProducerMap & producers) {
+		element.process.addPipelineProducers(producers);
+		return true;
+	}
+	
+	/**
+	 * Callback function to link the transitions of the given process node to their producers.
+	 *
+	 * @param[in,out] element - element to process
+	 * @param[in] level - hierarchical level of the given process node with the dependency tree
+	 * @param[in] producers - producer map to use
+	 * @return true
+	 */
+	static bool linkPipelineInputs(ProcessNode::ValueType & element, const size_t /* level */, const ProcessTransitionProducerMap & producers) {
+		element.process.linkPipelineInputs(producers, element.input);
+		return true;
+	}
+	
+	/**
+	 * Callback function to update the pipelined execution priorities of the given process node.
+	 *
+	 * @param[in,out] element - element to process
+	 * @param[in] level - hierarchical level of the given process node with the dependency tree
+	 * @return true
+	 */
+	static bool updatePipelinePriorities(ProcessNode::ValueType & element, const size_t /* level */) {
+		element.process.updatePipelinePriorities();
+		return true;
+	}
+	
+	/**
+	 * Callback method to execute the commands of the given process node.
+	 *
+	 * @param[in,out] scheduler - dispatch operations to this scheduler
 	 * @param[in] callProgress - callback function to handle the execution progress
 	 * @param[in,out] element - element to process
 	 * @param[in] callNext - callback function to be called if the execution has finished
 	 * @return true
 	 */
-	static bool executeProcess(boost::asio::io_service & ioService, const ProgressCallback & callProgress, ProcessNode::ValueType & element, const ExecutionCallback & callNext) {
-		element.process.execute(ioService, callProgress, callNext);
+	bool executeProcess(Scheduler & scheduler, const ProgressCallback & callProgress, ProcessNode::ValueType & element, const ExecutionCallback & callNext) {
+		element.process.execute(
+			scheduler,
+			callProgress,
+			boost::phoenix::bind(&Execution::finishedProcess, this, boost::phoenix::ref(element), callNext)
+		);
 		return true;
 	}
 	
+	/**
+	 * Callback method called after the given process node has been executed. The command results
+	 * are written to the log output and their buffers are released.
+	 *
+	 * @param[in,out] element - executed element
+	 * @param[in] callNext - callback function to be called afterwards
+	 */
+	void finishedProcess(ProcessNode::ValueType & element, const ExecutionCallback & callNext) {
+		{
+			boost::mutex::scoped_lock lock(this->mutex);
+			if (this->logIsFirst != NULL && this->loggedProcesses.insert(&(element.process)).second) {
+				if ( this->log ) element.process.print(*(this->log), *(this->logIsFirst));
+				else element.process.print(std::cout, *(this->logIsFirst));
+				element.process.clearOutputs();
+			}
+		}
+		if ( callNext ) callNext();
+	}
+	
 	/**
 	 * Callback method to update the flat dependency map after execution has been done
 	 * to decide which temporary files need to be deleted.
@@ -427,27 +683,29 @@ private:
 	}
 	
 	/**
-	 * Callback method to mark all files in the database that were created to distinguish those
-	 * from the remaining files of previous program executions.
+	 * Callback method to collect the database file information of all created files to
+	 * distinguish those from the remaining files of previous program executions.
 	 *
 	 * @param[in,out] element - element to process
 	 * @param[in] level - hierarchical level of the given process node with the dependency tree
+	 * @param[in,out] files - add the file information here
 	 * @return true
 	 */
-	bool markOutputFilesInDatabase(ProcessNode::ValueType & element, const size_t /* level */) {
-		element.process.markOutputFilesInDatabase(this->db);
+	static bool addOutputFiles(ProcessNode::ValueType & element, const size_t /* level */, std::vector<FileInformation> & files) {
+		element.process.addOutputFiles(files);
 		return true;
 	}
 	
 	/**
-	 * Callback method to update created files in the database.
+	 * Callback method to collect the runtime records of the executed transitions.
 	 * 
 	 * @param[in,out] element - element to process
 	 * @param[in] level - hierarchical level of the given process node with the dependency tree
+	 * @param[in,out] records - add the transition runtime records here
 	 * @return true
 	 */
-	bool setFlagsInDatabase(ProcessNode::ValueType & element, const size_t /* level */) {
-		element.process.setFlagsInDatabase(this->db);
+	static bool addRuntimes(ProcessNode::ValueType & element, const size_t /* level */, TransitionRuntimeVector & records) {
+		element.process.addRuntimes(records);
 		return true;
 	}
 	
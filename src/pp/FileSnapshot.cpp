@@ -0,0 +1,97 @@
+/**
+ * @file FileSnapshot.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#include <boost/foreach.hpp>
+#include <pcf/path/Utility.hpp>
+#include "FileSnapshot.hpp"
+
+
+namespace pp {
+
+
+/**
+ * Constructor.
+ *
+ * @param[in] d - open database with the stored file records
+ */
+FileSnapshot::FileSnapshot(const Database & d):
+	db(d),
+	loaded(false)
+{}
+
+
+/**
+ * Loads all file records of the database into memory. Previously loaded records are replaced.
+ *
+ * @return true on success, else false
+ */
+bool FileSnapshot::load() {
+	std::vector<FileInformation> records;
+	if ( ( ! this->db.isOpen() ) || ( ! this->db.getFiles(records) ) ) return false;
+	FileMap map;
+	BOOST_FOREACH(const FileInformation & record, records) {
+		map[FileSnapshot::convertKey(record.path)] = record;
+	}
+	boost::mutex::scoped_lock lock(this->mutex);
+	this->files.swap(map);
+	this->loaded = true;
+	return true;
+}
+
+
+/**
+ * Checks whether the file records were loaded.
+ *
+ * @return true if loaded, else false
+ */
+bool FileSnapshot::isLoaded() const {
+	boost::mutex::scoped_lock lock(this->mutex);
+	return this->loaded;
+}
+
+
+/**
+ * Compares the passed current file records with the loaded ones.
+ *
+ * @param[out] changed - append current file records which are new or differ from the loaded ones here
+ * @param[out] remains - append loaded file records without a current file record here
+ * @param[in] current - current file records
+ */
+void FileSnapshot::getDelta(std::vector<FileInformation> & changed, std::vector<FileInformation> & remains, const std::vector<FileInformation> & current) const {
+	PathSet seen;
+	boost::mutex::scoped_lock lock(this->mutex);
+	BOOST_FOREACH(const FileInformation & file, current) {
+		const std::string key(FileSnapshot::convertKey(file.path));
+		seen.insert(key);
+		const FileMap::const_iterator it = this->files.find(key);
+		if (it != this->files.end() && it->second.size == file.size && it->second.lastChange == file.lastChange && it->second.flags == file.flags) continue;
+		changed.push_back(file);
+	}
+	for (FileMap::const_iterator it = this->files.begin(), endIt = this->files.end(); it != endIt; ++it) {
+		if (seen.find(it->first) == seen.end()) remains.push_back(it->second);
+	}
+}
+
+
+/**
+ * Converts the given path into the key used for the file record map. The key is composed of
+ * directory and file name the same way the database does. The ASCII case is ignored by the map
+ * on Windows like in the log database.
+ *
+ * @param[in] path - path to convert
+ * @return normalized UTF-8 path
+ */
+std::string FileSnapshot::convertKey(const boost::filesystem::path & path) {
+	const boost::filesystem::path normalized(pcf::path::normalize(path, true));
+	std::string result(normalized.parent_path().generic_string(pcf::path::utf8));
+	if (result.empty() || result[result.size() - 1] != '/') result.push_back('/');
+	result.append(normalized.filename().generic_string(pcf::path::utf8));
+	return result;
+}
+
+
+} /* namespace pp */
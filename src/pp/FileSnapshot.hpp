@@ -0,0 +1,55 @@
+/**
+ * @file FileSnapshot.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#ifndef __PP_FILESNAPSHOT_HPP__
+#define __PP_FILESNAPSHOT_HPP__
+
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <boost/filesystem/path.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+#include "Database.hpp"
+#include "DatabaseBackend.hpp"
+#include "Type.hpp"
+
+
+namespace pp {
+
+
+/**
+ * Class to hold the file records of the database in memory. All file records are loaded with a
+ * single sequential scan by load(). getDelta() determines the records which need to be written
+ * back to the database. All methods are thread-safe.
+ */
+class FileSnapshot : private boost::noncopyable {
+private:
+	/** Set type of normalized paths. */
+	typedef std::set<std::string, DatabaseBackend::PathLess> PathSet;
+	/** Map type of file records by normalized path. */
+	typedef std::map<std::string, FileInformation, DatabaseBackend::PathLess> FileMap;
+	Database db; /**< Database with the stored file records. */
+	FileMap files; /**< Loaded file records. */
+	bool loaded; /**< True if the file records were loaded, else false. */
+	mutable boost::mutex mutex; /**< Mutex object for parallel execution. */
+public:
+	explicit FileSnapshot(const Database & d);
+	bool load();
+	bool isLoaded() const;
+	void getDelta(std::vector<FileInformation> & changed, std::vector<FileInformation> & remains, const std::vector<FileInformation> & current) const;
+private:
+	static std::string convertKey(const boost::filesystem::path & path);
+};
+
+
+} /* namespace pp */
+
+
+#endif /* __PP_FILESNAPSHOT_HPP__ */
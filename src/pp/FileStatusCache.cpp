@@ -0,0 +1,188 @@
+/**
+ * @file FileStatusCache.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#include <ctime>
+#include <boost/filesystem.hpp>
+#include <boost/foreach.hpp>
+#include <pcf/os/Target.hpp>
+#include "FileStatusCache.hpp"
+
+
+#if ! defined(PCF_IS_WIN)
+extern "C" {
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+}
+#endif /* ! PCF_IS_WIN */
+
+
+namespace pp {
+
+
+/**
+ * Reads the meta data of the given path from the file system. Symbolic links are followed.
+ * A single statx() call is used on Linux to request only the needed fields. The modification
+ * time keeps its sub-second part on Linux with microsecond resolution.
+ *
+ * @param[in] path - path to query
+ * @return file meta data
+ */
+FileStatus FileStatus::read(const boost::filesystem::path & path) {
+	FileStatus result;
+#if defined(PCF_IS_WIN)
+	boost::system::error_code ec;
+	const boost::filesystem::file_status status(boost::filesystem::status(path, ec));
+	if (ec || ( ! boost::filesystem::exists(status) )) return result;
+	if ( boost::filesystem::is_regular_file(status) ) {
+		result.type = REGULAR;
+		result.size = static_cast<boost::uint64_t>(boost::filesystem::file_size(path, ec));
+		if ( ec ) result.size = 0;
+	} else if ( boost::filesystem::is_directory(status) ) {
+		result.type = DIRECTORY;
+	} else {
+		result.type = OTHER;
+	}
+	const std::time_t lastChange = boost::filesystem::last_write_time(path, ec);
+	if ( ! ec ) result.lastChange = boost::posix_time::from_time_t(lastChange);
+#else /* ! PCF_IS_WIN */
+	mode_t mode;
+	off_t size;
+	std::time_t lastChange;
+	long lastChangeNs = 0;
+#if defined(PCF_IS_LINUX) && defined(STATX_BASIC_STATS)
+	struct statx sx;
+	if (statx(AT_FDCWD, path.c_str(), 0, STATX_TYPE | STATX_SIZE | STATX_MTIME, &sx) == 0) {
+		mode = static_cast<mode_t>(sx.stx_mode);
+		size = static_cast<off_t>(sx.stx_size);
+		lastChange = static_cast<std::time_t>(sx.stx_mtime.tv_sec);
+		lastChangeNs = static_cast<long>(sx.stx_mtime.tv_nsec);
+	} else if (errno != ENOSYS) {
+		return result;
+	} else
+#endif /* PCF_IS_LINUX and STATX_BASIC_STATS */
+	{
+		struct stat st;
+		if (stat(path.c_str(), &st) != 0) return result;
+		mode = st.st_mode;
+		size = st.st_size;
+		lastChange = st.st_mtime;
+#if defined(PCF_IS_LINUX)
+		lastChangeNs = static_cast<long>(st.st_mtim.tv_nsec);
+#endif /* PCF_IS_LINUX */
+	}
+	if ( S_ISREG(mode) ) {
+		result.type = REGULAR;
+		result.size = static_cast<boost::uint64_t>(size);
+	} else if ( S_ISDIR(mode) ) {
+		result.type = DIRECTORY;
+	} else {
+		result.type = OTHER;
+	}
+	result.lastChange = boost::posix_time::from_time_t(lastChange) + boost::posix_time::microseconds(lastChangeNs / 1000);
+#endif /* ! PCF_IS_WIN */
+	return result;
+}
+
+
+/**
+ * Returns the meta data of the given path. The file system is only queried if the path was not
+ * cached before.
+ *
+ * @param[in] path - path to query
+ * @return file meta data
+ */
+FileStatus FileStatusCache::get(const boost::filesystem::path & path) {
+	boost::uint64_t gen;
+	{
+		boost::mutex::scoped_lock lock(this->mutex);
+		const EntryMap::const_iterator it = this->entries.find(path.native());
+		if (it != this->entries.end()) return it->second;
+		gen = this->generation;
+	}
+	/* query the file system without holding the lock to allow parallel requests */
+	const FileStatus result(FileStatus::read(path));
+	boost::mutex::scoped_lock lock(this->mutex);
+	/* do not cache results which may have been outdated by a concurrent invalidation */
+	if (gen == this->generation) this->entries.insert(std::make_pair(path.native(), result));
+	return result;
+}
+
+
+/**
+ * Returns the meta data of the given paths. Paths which were not cached before are queried from
+ * the file system in order without holding the lock. The cache is locked only twice per call.
+ *
+ * @param[out] result - meta data in the order of paths
+ * @param[in] paths - paths to query
+ */
+void FileStatusCache::get(std::vector<FileStatus> & result, const std::vector<boost::filesystem::path> & paths) {
+	std::vector<size_t> missing;
+	boost::uint64_t gen;
+	result.assign(paths.size(), FileStatus());
+	{
+		boost::mutex::scoped_lock lock(this->mutex);
+		for (size_t i = 0; i < paths.size(); i++) {
+			const EntryMap::const_iterator it = this->entries.find(paths[i].native());
+			if (it != this->entries.end()) {
+				result[i] = it->second;
+			} else {
+				missing.push_back(i);
+			}
+		}
+		gen = this->generation;
+	}
+	if ( missing.empty() ) return;
+	BOOST_FOREACH(const size_t i, missing) {
+		result[i] = FileStatus::read(paths[i]);
+	}
+	boost::mutex::scoped_lock lock(this->mutex);
+	/* do not cache results which may have been outdated by a concurrent invalidation */
+	if (gen != this->generation) return;
+	BOOST_FOREACH(const size_t i, missing) {
+		this->entries.insert(std::make_pair(paths[i].native(), result[i]));
+	}
+}
+
+
+/**
+ * Sets the meta data of the given path. This can be used to add information which was already
+ * obtained by other means, like from a directory scan.
+ *
+ * @param[in] path - path to set
+ * @param[in] status - file meta data
+ */
+void FileStatusCache::set(const boost::filesystem::path & path, const FileStatus & status) {
+	boost::mutex::scoped_lock lock(this->mutex);
+	this->entries[path.native()] = status;
+}
+
+
+/**
+ * Removes the given path from the cache. The next request for this path queries the file system
+ * again. This needs to be called for each path which was written or removed.
+ *
+ * @param[in] path - path to invalidate
+ */
+void FileStatusCache::invalidate(const boost::filesystem::path & path) {
+	boost::mutex::scoped_lock lock(this->mutex);
+	this->entries.erase(path.native());
+	this->generation++;
+}
+
+
+/**
+ * Removes all paths from the cache.
+ */
+void FileStatusCache::clear() {
+	boost::mutex::scoped_lock lock(this->mutex);
+	this->entries.clear();
+	this->generation++;
+}
+
+
+} /* namespace pp */
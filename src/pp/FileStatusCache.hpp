@@ -0,0 +1,107 @@
+/**
+ * @file FileStatusCache.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#ifndef __PP_FILESTATUSCACHE_HPP__
+#define __PP_FILESTATUSCACHE_HPP__
+
+
+#include <map>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+
+
+namespace pp {
+
+
+/**
+ * Structure to hold the file system meta data of a single path.
+ */
+struct FileStatus {
+	/** Possible file types. */
+	enum Type {
+		MISSING, /**< Path does not exist. */
+		REGULAR, /**< Path is a regular file. */
+		DIRECTORY, /**< Path is a directory. */
+		OTHER /**< Path exists but is neither a regular file nor a directory. */
+	};
+	
+	Type type; /**< File type. */
+	boost::uint64_t size; /**< File size in bytes (only for regular files). */
+	boost::posix_time::ptime lastChange; /**< Last modification date time (not a date time if missing). */
+	
+	/** Default constructor. */
+	explicit FileStatus():
+		type(MISSING),
+		size(0),
+		lastChange(boost::posix_time::not_a_date_time)
+	{}
+	
+	/**
+	 * Checks whether the path exists.
+	 *
+	 * @return true if it exists, else false
+	 */
+	bool exists() const {
+		return this->type != MISSING;
+	}
+	
+	/**
+	 * Checks whether the path is a regular file.
+	 *
+	 * @return true if it is a regular file, else false
+	 */
+	bool isRegularFile() const {
+		return this->type == REGULAR;
+	}
+	
+	/**
+	 * Checks whether the path is a directory.
+	 *
+	 * @return true if it is a directory, else false
+	 */
+	bool isDirectory() const {
+		return this->type == DIRECTORY;
+	}
+	
+	static FileStatus read(const boost::filesystem::path & path);
+};
+
+
+/**
+ * Class to cache the file system meta data of paths for the whole run. Each path is queried only
+ * once from the file system until its entry is invalidated. The entries of files written or
+ * removed by pp need to be invalidated explicitly. All methods are thread-safe.
+ */
+class FileStatusCache : private boost::noncopyable {
+private:
+	/** Map type of the cached meta data by native path. */
+	typedef std::map<boost::filesystem::path::string_type, FileStatus> EntryMap;
+	EntryMap entries; /**< Cached meta data. */
+	boost::uint64_t generation; /**< Incremented on each invalidation. */
+	mutable boost::mutex mutex; /**< Mutex object for parallel execution. */
+public:
+	/** Default constructor. */
+	explicit FileStatusCache():
+		generation(0)
+	{}
+	
+	FileStatus get(const boost::filesystem::path & path);
+	void get(std::vector<FileStatus> & result, const std::vector<boost::filesystem::path> & paths);
+	void set(const boost::filesystem::path & path, const FileStatus & status);
+	void invalidate(const boost::filesystem::path & path);
+	void clear();
+};
+
+
+} /* namespace pp */
+
+
+#endif /* __PP_FILESTATUSCACHE_HPP__ */
@@ -0,0 +1,286 @@
+/**
+ * @file FileWatcher.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <boost/foreach.hpp>
+/* workaround for boost::phoenix::bind and boost::bind namespace collision */
+#define BOOST_BIND_NO_PLACEHOLDERS
+#include <boost/thread/thread.hpp>
+#undef BOOST_BIND_NO_PLACEHOLDERS
+#include <pcf/exception/General.hpp>
+#include <pcf/path/Utility.hpp>
+#include "FileWatcher.hpp"
+
+
+#if defined(PCF_IS_LINUX)
+extern "C" {
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+}
+#endif /* PCF_IS_LINUX */
+
+
+namespace pp {
+
+
+namespace {
+
+
+/**
+ * Local helper function to return the directory to watch for the given path. This is the path
+ * itself for directories or the parent directory for anything else. The nearest existing
+ * ancestor is used if the directory does not exist.
+ *
+ * @param[in] path - normalized path
+ * @return directory to watch
+ */
+static boost::filesystem::path getWatchDirectory(const boost::filesystem::path & path) {
+	if ( FileStatus::read(path).isDirectory() ) return path;
+	boost::filesystem::path dir(path.parent_path());
+	while (( ! dir.empty() ) && ( ! FileStatus::read(dir).isDirectory() )) dir = dir.parent_path();
+	if ( dir.empty() ) dir = ".";
+	return dir;
+}
+
+
+} /* namespace */
+
+
+/**
+ * Constructor.
+ *
+ * @throws pcf::exception::SystemError if the inotify handle could not be created
+ */
+FileWatcher::FileWatcher():
+	interval(boost::posix_time::milliseconds(250)),
+	latency(boost::posix_time::milliseconds(200))
+#if defined(PCF_IS_LINUX)
+	,
+	handle(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+#endif /* PCF_IS_LINUX */
+{
+#if defined(PCF_IS_LINUX)
+	if (this->handle < 0) {
+		BOOST_THROW_EXCEPTION(
+			pcf::exception::SystemError()
+			<< pcf::exception::tag::Message(std::string("Failed to initialize inotify: ") + strerror(errno))
+		);
+	}
+#endif /* PCF_IS_LINUX */
+}
+
+
+/**
+ * Destructor.
+ */
+FileWatcher::~FileWatcher() {
+#if defined(PCF_IS_LINUX)
+	close(this->handle);
+#endif /* PCF_IS_LINUX */
+}
+
+
+/**
+ * Sets the paths to watch. Previously watched paths which are not part of the new set are
+ * no longer watched. Paths which were already watched keep their state. Changes made since
+ * they were watched first are therefore reported by the next call to wait(), even if this
+ * function was called in between.
+ *
+ * @param[in] paths - files and directories to watch
+ * @param[in] ignore - ignore changes of these files (e.g. files written by pp itself)
+ */
+void FileWatcher::setPaths(const PathSet & paths, const PathSet & ignore) {
+	PathSet files, dirs;
+	this->ignored.clear();
+	BOOST_FOREACH(const boost::filesystem::path & path, ignore) {
+		this->ignored.insert(normalizePath(path));
+	}
+	BOOST_FOREACH(const boost::filesystem::path & path, paths) {
+		const boost::filesystem::path normalized(normalizePath(path));
+		const boost::filesystem::path dir(getWatchDirectory(normalized));
+		dirs.insert(dir);
+		if (dir != normalized) files.insert(normalized);
+	}
+#if defined(PCF_IS_LINUX)
+	/* remove outdated watches */
+	for (std::map<int, boost::filesystem::path>::iterator it = this->watches.begin(); it != this->watches.end(); ) {
+		if (dirs.find(it->second) == dirs.end()) {
+			inotify_rm_watch(this->handle, it->first);
+			this->watches.erase(it++);
+		} else {
+			dirs.erase(it->second);
+			++it;
+		}
+	}
+	/* add new watches */
+	const uint32_t mask = IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_DELETE_SELF | IN_MOVE_SELF | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+	BOOST_FOREACH(const boost::filesystem::path & dir, dirs) {
+		const int wd = inotify_add_watch(this->handle, dir.c_str(), mask);
+		/* directories which cannot be watched are ignored; the same directory may be reached via different paths */
+		if (wd >= 0) this->watches[wd] = dir;
+	}
+#else /* ! PCF_IS_LINUX */
+	/* remove outdated snapshots */
+	for (StatusMap::iterator it = this->snapshot.begin(); it != this->snapshot.end(); ) {
+		if (files.find(it->first) == files.end()) {
+			this->snapshot.erase(it++);
+		} else {
+			files.erase(it->first);
+			++it;
+		}
+	}
+	for (ListingMap::iterator it = this->listings.begin(); it != this->listings.end(); ) {
+		if (dirs.find(it->first) == dirs.end()) {
+			this->listings.erase(it++);
+		} else {
+			dirs.erase(it->first);
+			++it;
+		}
+	}
+	/* add new snapshots */
+	BOOST_FOREACH(const boost::filesystem::path & file, files) {
+		this->snapshot[file] = FileStatus::read(file);
+	}
+	BOOST_FOREACH(const boost::filesystem::path & dir, dirs) {
+		this->readListing(this->listings[dir], dir);
+	}
+#endif /* ! PCF_IS_LINUX */
+}
+
+
+/**
+ * Waits until at least one of the watched paths changed or a stop was requested. Changes which
+ * follow within a short time are collected as well.
+ *
+ * @param[out] changed - set of changed paths; contains an empty path if the changes could not be
+ * tracked completely
+ * @param[in] stopped - the function returns as soon as this is set to true
+ * @return true if paths changed, false if stopped
+ */
+bool FileWatcher::wait(PathSet & changed, const volatile bool & stopped) {
+	changed.clear();
+#if defined(PCF_IS_LINUX)
+	std::vector<char> buffer(64 * (sizeof(struct inotify_event) + NAME_MAX + 1));
+	while ( ! stopped ) {
+		struct pollfd pfd;
+		pfd.fd = this->handle;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+		const boost::posix_time::time_duration & timeout = changed.empty() ? this->interval : this->latency;
+		const int res = poll(&pfd, 1, static_cast<int>(timeout.total_milliseconds()));
+		if (res < 0 && errno != EINTR) {
+			BOOST_THROW_EXCEPTION(
+				pcf::exception::SystemError()
+				<< pcf::exception::tag::Message(std::string("Failed to wait for file system changes: ") + strerror(errno))
+			);
+		}
+		if (res <= 0) {
+			/* no further changes within the latency */
+			if ( ! changed.empty() ) return true;
+			continue;
+		}
+		for (;;) {
+			const ssize_t len = read(this->handle, &(buffer.front()), buffer.size());
+			if (len <= 0) break;
+			for (ssize_t offset = 0; offset < len; ) {
+				const struct inotify_event * event = reinterpret_cast<const struct inotify_event *>(&(buffer.front()) + offset);
+				offset += static_cast<ssize_t>(sizeof(struct inotify_event) + event->len);
+				if ((event->mask & IN_Q_OVERFLOW) != 0) {
+					changed.insert(boost::filesystem::path());
+					continue;
+				}
+				const std::map<int, boost::filesystem::path>::iterator watch = this->watches.find(event->wd);
+				if (watch == this->watches.end()) continue;
+				if ((event->mask & IN_IGNORED) != 0) {
+					/* watched directory was removed */
+					changed.insert(watch->second);
+					this->watches.erase(watch);
+					continue;
+				}
+				const boost::filesystem::path path((event->len > 0) ? (watch->second / event->name) : watch->second);
+				const boost::filesystem::path normalized(normalizePath(path));
+				if (this->ignored.find(normalized) == this->ignored.end()) changed.insert(normalized);
+			}
+		}
+	}
+#else /* ! PCF_IS_LINUX */
+	while ( ! stopped ) {
+		BOOST_FOREACH(StatusMap::value_type & entry, this->snapshot) {
+			const FileStatus status(FileStatus::read(entry.first));
+			if (status.type != entry.second.type || status.size != entry.second.size || status.lastChange != entry.second.lastChange) {
+				if (this->ignored.find(entry.first) == this->ignored.end()) changed.insert(entry.first);
+				entry.second = status;
+			}
+		}
+		/* compare the directory entries instead of the directory meta data to skip files written by pp itself */
+		BOOST_FOREACH(ListingMap::value_type & entry, this->listings) {
+			PathSet listing;
+			this->readListing(listing, entry.first);
+			std::set_symmetric_difference(listing.begin(), listing.end(), entry.second.begin(), entry.second.end(), std::inserter(changed, changed.end()));
+			entry.second.swap(listing);
+		}
+		if ( ! changed.empty() ) {
+			boost::this_thread::sleep(this->latency);
+			return true;
+		}
+		boost::this_thread::sleep(this->interval * 4);
+	}
+#endif /* ! PCF_IS_LINUX */
+	return false;
+}
+
+
+/**
+ * Converts the given path into the representation used to compare the paths reported by the
+ * file watcher with the paths of the dependency tree. Relative path elements are resolved
+ * lexically. The current directory is returned as ".".
+ *
+ * @param[in] path - path to convert
+ * @return normalized path
+ */
+boost::filesystem::path FileWatcher::normalizePath(const boost::filesystem::path & path) {
+	boost::filesystem::path result;
+	try {
+		result = pcf::path::normalize(path);
+	} catch (...) {
+		result = path;
+	}
+	if ( result.empty() ) result = ".";
+	return result;
+}
+
+
+#if ! defined(PCF_IS_LINUX)
+/**
+ * Reads the entries of the given directory. Ignored paths are skipped.
+ *
+ * @param[out] listing - set of normalized entry paths
+ * @param[in] dir - directory to read
+ */
+void FileWatcher::readListing(PathSet & listing, const boost::filesystem::path & dir) const {
+	std::vector<pcf::path::DirectoryEntry> entries;
+	listing.clear();
+	try {
+		pcf::path::readDirectory(entries, dir);
+	} catch (...) {
+		/* removed directories have no entries */
+		return;
+	}
+	BOOST_FOREACH(const pcf::path::DirectoryEntry & entry, entries) {
+		const boost::filesystem::path path(normalizePath(dir / entry.name));
+		if (this->ignored.find(path) == this->ignored.end()) listing.insert(path);
+	}
+}
+#endif /* ! PCF_IS_LINUX */
+
+
+} /* namespace pp */
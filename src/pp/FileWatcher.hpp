@@ -0,0 +1,63 @@
+/**
+ * @file FileWatcher.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#ifndef __PP_FILEWATCHER_HPP__
+#define __PP_FILEWATCHER_HPP__
+
+
+#include <map>
+#include <set>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/noncopyable.hpp>
+#include <pcf/os/Target.hpp>
+#include "FileStatusCache.hpp"
+
+
+namespace pp {
+
+
+/**
+ * Class to wait for changes of a set of files and directories. The parent directories of the
+ * watched files are monitored to catch files which are replaced or newly created. inotify is used
+ * on Linux. Other systems poll the file meta data and the directory entries periodically.
+ */
+class FileWatcher : private boost::noncopyable {
+public:
+	/** Set of paths. */
+	typedef std::set<boost::filesystem::path> PathSet;
+private:
+	/** Map type of the file meta data by path. */
+	typedef std::map<boost::filesystem::path, FileStatus> StatusMap;
+	/** Map type of the directory entries by directory path. */
+	typedef std::map<boost::filesystem::path, PathSet> ListingMap;
+	PathSet ignored; /**< Changes of these paths are ignored. */
+	StatusMap snapshot; /**< Last known meta data of the watched files (polling only). */
+	ListingMap listings; /**< Last known entries of the watched directories (polling only). */
+	boost::posix_time::time_duration interval; /**< Time between two checks for the stop request. */
+	boost::posix_time::time_duration latency; /**< Time to wait for further changes after the first one. */
+#if defined(PCF_IS_LINUX)
+	int handle; /**< inotify handle. */
+	std::map<int, boost::filesystem::path> watches; /**< Watched directories by watch descriptor. */
+#endif /* PCF_IS_LINUX */
+public:
+	explicit FileWatcher();
+	~FileWatcher();
+	void setPaths(const PathSet & paths, const PathSet & ignore = PathSet());
+	bool wait(PathSet & changed, const volatile bool & stopped);
+	static boost::filesystem::path normalizePath(const boost::filesystem::path & path);
+private:
+#if ! defined(PCF_IS_LINUX)
+	void readListing(PathSet & listing, const boost::filesystem::path & dir) const;
+#endif /* ! PCF_IS_LINUX */
+};
+
+
+} /* namespace pp */
+
+
+#endif /* __PP_FILEWATCHER_HPP__ */
@@ -0,0 +1,218 @@
+/**
+ * @file LoadController.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <boost/bind.hpp>
+#include "LoadController.hpp"
+
+
+namespace pp {
+
+
+namespace {
+
+
+/** Lower the limit if the load average exceeds the number of cores by this factor. */
+static const double maxLoadFactor = 1.25;
+/** Lower the limit if CPU or I/O stalled more than this percentage of time. */
+static const double maxPressure = 40.0;
+/** Lower the limit if memory stalled more than this percentage of time. */
+static const double maxMemoryPressure = 10.0;
+/** Halve the limit if memory stalled more than this percentage of time. */
+static const double criticalMemoryPressure = 25.0;
+/** Lower the limit if less than this fraction of the total memory is available. */
+static const double minMemoryAvailable = 0.1;
+/** Halve the limit if less than this fraction of the total memory is available. */
+static const double criticalMemoryAvailable = 0.05;
+
+
+/**
+ * Reads the system load average of the last minute.
+ *
+ * @return load average or nothing if not available
+ */
+static boost::optional<double> readLoadAverage() {
+	std::ifstream in("/proc/loadavg");
+	double value;
+	if ( in >> value ) return boost::optional<double>(value);
+	return boost::optional<double>();
+}
+
+
+/**
+ * Reads the pressure stall information for the given resource.
+ *
+ * @param[in] resource - cpu, io or memory
+ * @return percentage of time some tasks stalled on this resource over the last 10 seconds or
+ * nothing if not available
+ */
+static boost::optional<double> readPressure(const char * resource) {
+	std::ifstream in((std::string("/proc/pressure/") + resource).c_str());
+	std::string kind, field;
+	while (in >> kind >> field) {
+		if (kind == "some" && field.compare(0, 6, "avg10=") == 0) {
+			char * endPtr;
+			const double value = strtod(field.c_str() + 6, &endPtr);
+			if (*endPtr == 0) return boost::optional<double>(value);
+			break;
+		}
+		in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+	}
+	return boost::optional<double>();
+}
+
+
+/**
+ * Reads the fraction of the total memory available for new processes.
+ *
+ * @return available memory fraction or nothing if not available
+ */
+static boost::optional<double> readMemoryAvailable() {
+	std::ifstream in("/proc/meminfo");
+	std::string key;
+	double value, total = 0.0, available = -1.0;
+	while (in >> key >> value) {
+		if (key == "MemTotal:") {
+			total = value;
+		} else if (key == "MemAvailable:") {
+			available = value;
+		}
+		if (total > 0.0 && available >= 0.0) return boost::optional<double>(available / total);
+		in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+	}
+	return boost::optional<double>();
+}
+
+
+} /* namespace */
+
+
+/**
+ * Samples the current system load.
+ *
+ * @return system load sample
+ */
+LoadSample LoadSample::current() {
+	LoadSample result;
+	result.loadAverage = readLoadAverage();
+	result.cpuPressure = readPressure("cpu");
+	result.ioPressure = readPressure("io");
+	result.memoryPressure = readPressure("memory");
+	result.memoryAvailable = readMemoryAvailable();
+	return result;
+}
+
+
+/**
+ * Constructor.
+ *
+ * @param[in,out] s - scheduler to adapt
+ * @param[in] v - verbosity level
+ */
+LoadController::LoadController(Scheduler & s, const Verbosity v):
+	scheduler(s),
+	cores(std::max<size_t>(boost::thread::hardware_concurrency(), 1)),
+	verbosity(v),
+	interval(boost::posix_time::seconds(1))
+{}
+
+
+/**
+ * Destructor.
+ */
+LoadController::~LoadController() {
+	this->stop();
+}
+
+
+/**
+ * Sets the initial limit according to the current system load and starts sampling the system
+ * load in a background thread.
+ */
+void LoadController::start() {
+	if ( this->thread ) return;
+	const LoadSample sample(LoadSample::current());
+	size_t limit = this->scheduler.getSlots();
+	if ( sample.loadAverage ) {
+		/* leave the cores used by other processes to them */
+		const double idle = static_cast<double>(this->cores) - *(sample.loadAverage);
+		limit = std::min(limit, idle < 1.0 ? static_cast<size_t>(1) : static_cast<size_t>(idle));
+	}
+	limit = this->adaptLimit(limit, 0, sample);
+	this->scheduler.setLimit(limit);
+	if (this->verbosity >= VERBOSITY_DEBUG) std::cerr << "pp: initial job limit " << this->scheduler.getLimit() << std::endl;
+	this->thread.reset(new boost::thread(boost::bind(&LoadController::run, this)));
+}
+
+
+/**
+ * Stops sampling the system load. The scheduler keeps its last limit.
+ */
+void LoadController::stop() {
+	if ( ! this->thread ) return;
+	this->thread->interrupt();
+	this->thread->join();
+	this->thread.reset();
+}
+
+
+/**
+ * Returns the new limit of concurrently running commands for the given load sample.
+ *
+ * @param[in] limit - current limit
+ * @param[in] running - number of currently running commands
+ * @param[in] sample - current system load
+ * @return new limit between 1 and the number of scheduler slots
+ */
+size_t LoadController::adaptLimit(const size_t limit, const size_t running, const LoadSample & sample) const {
+	const size_t slots = this->scheduler.getSlots();
+	const double load = sample.loadAverage ? *(sample.loadAverage) : 0.0;
+	const double cpu = sample.cpuPressure ? *(sample.cpuPressure) : 0.0;
+	const double io = sample.ioPressure ? *(sample.ioPressure) : 0.0;
+	const double memory = sample.memoryPressure ? *(sample.memoryPressure) : 0.0;
+	const double available = sample.memoryAvailable ? *(sample.memoryAvailable) : 1.0;
+	if (memory > criticalMemoryPressure || available < criticalMemoryAvailable) {
+		/* back off quickly to avoid swapping or the OOM killer */
+		return std::max<size_t>(limit / 2, 1);
+	}
+	if (memory > maxMemoryPressure || available < minMemoryAvailable || cpu > maxPressure || io > maxPressure || load > (static_cast<double>(this->cores) * maxLoadFactor)) {
+		return std::max<size_t>(limit - std::max<size_t>(limit / 4, 1), 1);
+	}
+	if (running >= limit && load < static_cast<double>(this->cores) && cpu < (maxPressure / 2.0) && io < (maxPressure / 2.0) && memory < (maxMemoryPressure / 2.0)) {
+		/* all slots are in use and the system has spare capacity */
+		return std::min(limit + 1, slots);
+	}
+	return std::min(std::max<size_t>(limit, 1), slots);
+}
+
+
+/**
+ * Samples the system load periodically and adapts the scheduler limit until interrupted.
+ */
+void LoadController::run() {
+	try {
+		for (;;) {
+			boost::this_thread::sleep(this->interval);
+			const size_t limit = this->scheduler.getLimit();
+			const size_t newLimit = this->adaptLimit(limit, this->scheduler.getRunning(), LoadSample::current());
+			if (newLimit != limit) {
+				this->scheduler.setLimit(newLimit);
+				if (this->verbosity >= VERBOSITY_DEBUG) std::cerr << "pp: changed job limit from " << limit << " to " << newLimit << std::endl;
+			}
+		}
+	} catch (const boost::thread_interrupted &) {
+		/* stopped */
+	}
+}
+
+
+} /* namespace pp */
@@ -0,0 +1,69 @@
+/**
+ * @file LoadController.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#ifndef __PP_LOADCONTROLLER_HPP__
+#define __PP_LOADCONTROLLER_HPP__
+
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+#include <boost/scoped_ptr.hpp>
+/* workaround for boost::phoenix::bind and boost::bind namespace collision */
+#define BOOST_BIND_NO_PLACEHOLDERS
+#include <boost/thread/thread.hpp>
+#undef BOOST_BIND_NO_PLACEHOLDERS
+#include "Scheduler.hpp"
+#include "Type.hpp"
+
+
+namespace pp {
+
+
+/**
+ * Structure to hold a single sample of the system load. Values which are not available on the
+ * current system are left empty.
+ */
+struct LoadSample {
+	boost::optional<double> loadAverage; /**< System load average of the last minute. */
+	boost::optional<double> cpuPressure; /**< Percentage of time some tasks stalled on CPU over the last 10 seconds. */
+	boost::optional<double> ioPressure; /**< Percentage of time some tasks stalled on I/O over the last 10 seconds. */
+	boost::optional<double> memoryPressure; /**< Percentage of time some tasks stalled on memory over the last 10 seconds. */
+	boost::optional<double> memoryAvailable; /**< Fraction of the total memory available for new processes. */
+	
+	static LoadSample current();
+};
+
+
+/**
+ * Class to adapt the number of concurrently running commands of a scheduler to the system load.
+ * The limit is lowered if the system is overloaded or runs short on memory and raised step by
+ * step while all slots are in use and the system has spare capacity. The limit never exceeds the
+ * number of slots of the scheduler.
+ */
+class LoadController : private boost::noncopyable {
+private:
+	Scheduler & scheduler; /**< Adapted scheduler. */
+	size_t cores; /**< Number of available cores. */
+	Verbosity verbosity; /**< Outputs limit changes on verbosity level DEBUG. */
+	boost::posix_time::time_duration interval; /**< Time between two load samples. */
+	boost::scoped_ptr<boost::thread> thread; /**< Thread sampling the system load. */
+public:
+	explicit LoadController(Scheduler & s, const Verbosity v = VERBOSITY_WARN);
+	~LoadController();
+	void start();
+	void stop();
+	size_t adaptLimit(const size_t limit, const size_t running, const LoadSample & sample) const;
+private:
+	void run();
+};
+
+
+} /* namespace pp */
+
+
+#endif /* __PP_LOADCONTROLLER_HPP__ */
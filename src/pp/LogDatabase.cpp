@@ -0,0 +1,1371 @@
+/**
+ * @file LogDatabase.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#include <cstring>
+#include <set>
+#include <boost/filesystem/operations.hpp>
+#include <boost/foreach.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/noncopyable.hpp>
+#include <pcf/exception/General.hpp>
+#include <pcf/os/Target.hpp>
+#include "LogDatabase.hpp"
+
+
+#if defined(PCF_IS_WIN)
+extern "C" {
+#include <windows.h>
+}
+#else /* ! PCF_IS_WIN */
+extern "C" {
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+}
+#endif /* ! PCF_IS_WIN */
+
+
+namespace pp {
+
+
+namespace {
+
+
+/** Type and version identifier at the beginning of each log file. */
+static const char logMagic[] = "ppdblog";
+/** Version of the log file format. */
+static const boost::uint8_t logVersion = 1;
+/** Size of the log file header in octets. */
+static const size_t logHeaderSize = sizeof(logMagic);
+/** Largest number which can be stored as variable integer. */
+static const boost::uint64_t maxNumber = UINT64_C(0x00FFFFFFFFFFFFFF);
+/** Snapshots are split into commits of about this size in octets. */
+static const size_t snapshotCommitSize = 0x100000;
+
+
+/**
+ * Possible record types within a commit of the log file.
+ */
+enum RecordType {
+	RECORD_FILE = 1, /**< Insert or replace a file record. */
+	RECORD_FILE_FLAGS, /**< Set the flags of a single file record. */
+	RECORD_FILE_DELETE, /**< Delete a single file record and its content hash record. */
+	RECORD_ALL_FLAGS, /**< Set the flags of all file records. */
+	RECORD_DELETE_BY_FLAG, /**< Delete all file records matching the given flags and their content hash records. */
+	RECORD_RUNTIME, /**< Add a transition runtime record. */
+	RECORD_LISTING, /**< Insert or replace a directory listing record. */
+	RECORD_HASH, /**< Insert or replace a content hash record. */
+	RECORD_HASH_DELETE, /**< Delete a single content hash record. */
+	RECORD_CLEAR /**< Delete all records. */
+};
+
+
+/**
+ * Local helper function to check whether the given file flags match the passed flags. This
+ * equals the condition used by the SQLite database.
+ *
+ * @param[in] fileFlags - flags of the file record
+ * @param[in] flags - compare with these flags
+ * @return true on match, else false
+ */
+static bool matchesFlags(const boost::uint64_t fileFlags, const boost::uint64_t flags) {
+	if (flags == 0) return fileFlags == 0;
+	return (fileFlags & flags) == flags;
+}
+
+
+/**
+ * Local helper function to append the given unsigned number as variable integer.
+ *
+ * @param[in,out] block - append to this block
+ * @param[in] value - value to append
+ * @throws pcf::exception::OutOfRange if the value exceeds maxNumber
+ */
+static void appendNumber(pcf::data::OctetBlock & block, const boost::uint64_t value) {
+	if (value > maxNumber) {
+		BOOST_THROW_EXCEPTION(
+			pcf::exception::OutOfRange()
+			<< pcf::exception::tag::Message("Value exceeds the range of the log database format.")
+		);
+	}
+	block.pushBackVarIntBE(value);
+}
+
+
+/**
+ * Local helper function to append the given signed number as zig-zag encoded variable integer.
+ *
+ * @param[in,out] block - append to this block
+ * @param[in] value - value to append
+ * @throws pcf::exception::OutOfRange if the encoded value exceeds maxNumber
+ */
+static void appendSigned(pcf::data::OctetBlock & block, const boost::int64_t value) {
+	appendNumber(block, (static_cast<boost::uint64_t>(value) << 1) ^ static_cast<boost::uint64_t>(value >> 63));
+}
+
+
+/**
+ * Local helper function to append the given 64-bit value with fixed size.
+ *
+ * @param[in,out] block - append to this block
+ * @param[in] value - value to append
+ */
+static void appendFixed(pcf::data::OctetBlock & block, const boost::uint64_t value) {
+	block.pushBackBE(value);
+}
+
+
+/**
+ * Local helper function to append the given string with its length as prefix.
+ *
+ * @param[in,out] block - append to this block
+ * @param[in] value - string to append
+ */
+static void appendString(pcf::data::OctetBlock & block, const std::string & value) {
+	appendNumber(block, static_cast<boost::uint64_t>(value.size()));
+	block.insert(block.end(), value.begin(), value.end());
+}
+
+
+/**
+ * Local helper function to encode a file record.
+ *
+ * @param[in,out] block - append to this block
+ * @param[in] path - normalized file path
+ * @param[in] size - file size in bytes
+ * @param[in] lastModified - last modification time in microseconds since 1970-01-01
+ * @param[in] flags - file flags
+ */
+static void encodeFile(pcf::data::OctetBlock & block, const std::string & path, const boost::uint64_t size, const boost::int64_t lastModified, const boost::uint64_t flags) {
+	block.push_back(static_cast<boost::uint8_t>(RECORD_FILE));
+	appendString(block, path);
+	appendNumber(block, size);
+	appendSigned(block, lastModified);
+	appendNumber(block, flags);
+}
+
+
+/**
+ * Local helper function to encode a runtime record.
+ *
+ * @param[in,out] block - append to this block
+ * @param[in] process - ID of the process of the transition
+ * @param[in] transition - unique key of the transition within its process
+ * @param[in] runtime - runtime information
+ */
+static void encodeRuntime(pcf::data::OctetBlock & block, const std::string & process, const std::string & transition, const RuntimeInformation & runtime) {
+	block.push_back(static_cast<boost::uint8_t>(RECORD_RUNTIME));
+	appendString(block, process);
+	appendString(block, transition);
+	appendSigned(block, static_cast<boost::int64_t>(runtime.duration.total_milliseconds()));
+	appendSigned(block, static_cast<boost::int64_t>(runtime.exitCode));
+	appendNumber(block, runtime.outputSize);
+}
+
+
+/**
+ * Local helper function to encode a directory listing record.
+ *
+ * @param[in,out] block - append to this block
+ * @param[in] path - normalized directory path
+ * @param[in] inode - file serial number of the directory
+ * @param[in] modified - last modification time of the directory in nanoseconds since epoch
+ * @param[in] changed - last status change time of the directory in nanoseconds since epoch
+ * @param[in] entries - encoded directory entries
+ */
+static void encodeListing(pcf::data::OctetBlock & block, const std::string & path, const boost::int64_t inode, const boost::int64_t modified, const boost::int64_t changed, const std::string & entries) {
+	block.push_back(static_cast<boost::uint8_t>(RECORD_LISTING));
+	appendString(block, path);
+	appendFixed(block, static_cast<boost::uint64_t>(inode));
+	appendFixed(block, static_cast<boost::uint64_t>(modified));
+	appendFixed(block, static_cast<boost::uint64_t>(changed));
+	appendString(block, entries);
+}
+
+
+/**
+ * Local helper function to encode a content hash record.
+ *
+ * @param[in,out] block - append to this block
+ * @param[in] path - normalized file path
+ * @param[in] size - file size in bytes
+ * @param[in] lastModified - last modification time in microseconds since 1970-01-01
+ * @param[in] contentChanged - last content change time in microseconds since 1970-01-01
+ * @param[in] hash - hash value of the file content
+ */
+static void encodeHash(pcf::data::OctetBlock & block, const std::string & path, const boost::uint64_t size, const boost::int64_t lastModified, const boost::int64_t contentChanged, const boost::uint64_t hash) {
+	block.push_back(static_cast<boost::uint8_t>(RECORD_HASH));
+	appendString(block, path);
+	appendNumber(block, size);
+	appendSigned(block, lastModified);
+	appendSigned(block, contentChanged);
+	appendFixed(block, hash);
+}
+
+
+/**
+ * Local helper function to write the given records as single commit to the passed stream.
+ *
+ * @param[in,out] out - write to this stream
+ * @param[in] commit - encoded records of the commit
+ * @return true on success, else false
+ * @remarks Write errors are also kept in the state of the stream.
+ */
+static bool writeCommit(std::ostream & out, const pcf::data::OctetBlock & commit) {
+	pcf::data::OctetBlock length;
+	appendNumber(length, static_cast<boost::uint64_t>(commit.size()));
+	out.write(reinterpret_cast<const char *>(&(length[0])), static_cast<std::streamsize>(length.size()));
+	out.write(reinterpret_cast<const char *>(&(commit[0])), static_cast<std::streamsize>(commit.size()));
+	return out.good();
+}
+
+
+/**
+ * Local helper function to write the buffered data of the given file stream through to the
+ * storage device.
+ *
+ * @param[in,out] out - synchronize this file stream
+ * @return true on success, else false
+ */
+static bool syncFile(pcf::file::ofstream & out) {
+	out.flush();
+	if ( ! out.good() ) return false;
+#if defined(PCF_IS_WIN)
+	return FlushFileBuffers(out->handle()) != 0;
+#else /* ! PCF_IS_WIN */
+	return fsync(out->handle()) == 0;
+#endif /* ! PCF_IS_WIN */
+}
+
+
+} /* anonymous namespace */
+
+
+/**
+ * Internal class to decode the records of a log file. Any access beyond the end of the data
+ * marks the reader as invalid.
+ */
+class LogDatabase::Reader {
+private:
+	const boost::uint8_t * ptr; /**< Current read position. */
+	const boost::uint8_t * end; /**< End of the data. */
+	bool valid; /**< False if the data was found to be malformed. */
+public:
+	/**
+	 * Constructor.
+	 *
+	 * @param[in] data - pointer to the data
+	 * @param[in] size - size of the data in octets
+	 */
+	explicit Reader(const boost::uint8_t * data, const size_t size):
+		ptr(data),
+		end(data + size),
+		valid(true)
+	{}
+	
+	/**
+	 * Returns whether all read values were valid.
+	 *
+	 * @return true if valid, else false
+	 */
+	bool isValid() const {
+		return this->valid;
+	}
+	
+	/**
+	 * Returns whether all data was read.
+	 *
+	 * @return true if at the end, else false
+	 */
+	bool atEnd() const {
+		return this->ptr >= this->end;
+	}
+	
+	/**
+	 * Returns the number of octets left.
+	 *
+	 * @return remaining octets
+	 */
+	size_t remaining() const {
+		return static_cast<size_t>(this->end - this->ptr);
+	}
+	
+	/**
+	 * Returns a reader for the next octets and skips them.
+	 *
+	 * @param[in] size - number of octets
+	 * @return reader for these octets
+	 */
+	Reader take(const size_t size) {
+		if (size > this->remaining()) {
+			this->valid = false;
+			return Reader(this->end, 0);
+		}
+		const Reader result(this->ptr, size);
+		this->ptr += size;
+		return result;
+	}
+	
+	/**
+	 * Reads a single octet.
+	 *
+	 * @return read octet
+	 */
+	boost::uint8_t readOctet() {
+		if ( this->atEnd() ) {
+			this->valid = false;
+			return 0;
+		}
+		return *(this->ptr++);
+	}
+	
+	/**
+	 * Reads an unsigned variable integer as written by pcf::data::OctetBlock::pushBackVarIntBE().
+	 *
+	 * @return read value
+	 */
+	boost::uint64_t readNumber() {
+		if ( this->atEnd() ) {
+			this->valid = false;
+			return 0;
+		}
+		const boost::uint8_t first = *(this->ptr);
+		size_t octetCount = 1;
+		while (octetCount <= 8 && (first & (0x80 >> (octetCount - 1))) == 0) octetCount++;
+		if (octetCount > 8 || octetCount > this->remaining()) {
+			this->valid = false;
+			return 0;
+		}
+		boost::uint64_t result = static_cast<boost::uint64_t>(first & (0xFF >> octetCount));
+		for (size_t i = 1; i < octetCount; i++) {
+			result = (result << 8) | static_cast<boost::uint64_t>(this->ptr[i]);
+		}
+		this->ptr += octetCount;
+		return result;
+	}
+	
+	/**
+	 * Reads a zig-zag encoded signed variable integer.
+	 *
+	 * @return read value
+	 */
+	boost::int64_t readSigned() {
+		const boost::uint64_t value = this->readNumber();
+		return static_cast<boost::int64_t>(value >> 1) ^ -static_cast<boost::int64_t>(value & 1);
+	}
+	
+	/**
+	 * Reads a big-endian 64-bit value with fixed size.
+	 *
+	 * @return read value
+	 */
+	boost::uint64_t readFixed() {
+		if (this->remaining() < 8) {
+			this->valid = false;
+			return 0;
+		}
+		boost::uint64_t result = 0;
+		for (size_t i = 0; i < 8; i++) {
+			result = (result << 8) | static_cast<boost::uint64_t>(this->ptr[i]);
+		}
+		this->ptr += 8;
+		return result;
+	}
+	
+	/**
+	 * Reads a string with its length as prefix.
+	 *
+	 * @return read string
+	 */
+	std::string readString() {
+		const boost::uint64_t size = this->readNumber();
+		if (( ! this->valid ) || size > static_cast<boost::uint64_t>(this->remaining())) {
+			this->valid = false;
+			return std::string();
+		}
+		const std::string result(reinterpret_cast<const char *>(this->ptr), static_cast<size_t>(size));
+		this->ptr += static_cast<size_t>(size);
+		return result;
+	}
+};
+
+
+/**
+ * Internal class to hold an exclusive advisory lock for the lifetime of the object. A separate
+ * lock file is used because the log file gets replaced on compaction. The lock file is kept.
+ */
+class LogDatabase::FileLock : private boost::noncopyable {
+private:
+#if defined(PCF_IS_WIN)
+	HANDLE handle; /**< Handle of the lock file. */
+#else /* ! PCF_IS_WIN */
+	int fd; /**< File descriptor of the lock file. */
+#endif /* ! PCF_IS_WIN */
+public:
+	/**
+	 * Constructor. Creates the lock file if needed and locks it.
+	 *
+	 * @param[in] file - path to the lock file
+	 * @throws pcf::exception::Database if the file could not be opened or is locked by another process
+	 */
+	explicit FileLock(const boost::filesystem::path & file) {
+		bool locked;
+#if defined(PCF_IS_WIN)
+		this->handle = CreateFileW(file.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (this->handle == INVALID_HANDLE_VALUE) {
+			BOOST_THROW_EXCEPTION(
+				pcf::exception::Database()
+				<< pcf::exception::tag::Message("Failed to open the lock file \"" + file.string(pcf::path::utf8) + "\".")
+			);
+		}
+		OVERLAPPED overlapped;
+		std::memset(&overlapped, 0, sizeof(overlapped));
+		locked = (LockFileEx(this->handle, LOCKFILE_EXCLUSIVE_LOCK | LOCKFILE_FAIL_IMMEDIATELY, 0, 1, 0, &overlapped) != 0);
+		if ( ! locked ) CloseHandle(this->handle);
+#else /* ! PCF_IS_WIN */
+		this->fd = ::open(file.c_str(), O_RDWR | O_CREAT, 0666);
+		if (this->fd < 0) {
+			BOOST_THROW_EXCEPTION(
+				pcf::exception::Database()
+				<< pcf::exception::tag::Message("Failed to open the lock file \"" + file.string(pcf::path::utf8) + "\".")
+			);
+		}
+		/* executed commands shall not inherit the lock */
+		fcntl(this->fd, F_SETFD, FD_CLOEXEC);
+		locked = (flock(this->fd, LOCK_EX | LOCK_NB) == 0);
+		if ( ! locked ) ::close(this->fd);
+#endif /* ! PCF_IS_WIN */
+		if ( ! locked ) {
+			BOOST_THROW_EXCEPTION(
+				pcf::exception::Database()
+				<< pcf::exception::tag::Message("The lock file \"" + file.string(pcf::path::utf8) + "\" is held by another process.")
+			);
+		}
+	}
+	
+	/**
+	 * Destructor. Releases the lock.
+	 */
+	~FileLock() {
+#if defined(PCF_IS_WIN)
+		CloseHandle(this->handle);
+#else /* ! PCF_IS_WIN */
+		::close(this->fd);
+#endif /* ! PCF_IS_WIN */
+	}
+};
+
+
+/**
+ * Constructor.
+ * Locks and opens the log file at the given location and replays its records. The log file is
+ * created if it does not exist.
+ *
+ * @param[in] db - path to the log file
+ * @throws pcf::exception::Database if the log file could not be opened or is in use
+ */
+LogDatabase::LogDatabase(const boost::filesystem::path & db):
+	path(db),
+	logRecords(0),
+	needsCompaction(false)
+{
+	boost::filesystem::path lockPath(db);
+	lockPath += ".lock";
+	this->fileLock.reset(new FileLock(lockPath));
+	this->load();
+}
+
+
+/**
+ * Destructor.
+ * Closes the log file before the lock is released.
+ */
+LogDatabase::~LogDatabase() {
+	this->output.reset();
+}
+
+
+/**
+ * Returns the database access mutex.
+ *
+ * @return database access mutex
+ */
+boost::mutex & LogDatabase::getMutex() {
+	return this->mutex;
+}
+
+
+/**
+ * Checks whether the log file is open for appending.
+ *
+ * @return true if open, else false
+ */
+bool LogDatabase::isOpen() const {
+	return this->output.get() != NULL;
+}
+
+
+/**
+ * Updates the database entry for the given file by using the passed meta data.
+ *
+ * @param[in] file - file information for database update
+ * @return true if the update was successful, else false
+ */
+bool LogDatabase::updateFile(const FileInformation & file) {
+	std::vector<FileInformation> files;
+	files.push_back(file);
+	return this->updateFiles(files, boost::optional<boost::uint64_t>());
+}
+
+
+/**
+ * Updates the database entries for the given files by using the passed meta data within a
+ * single commit.
+ *
+ * @param[in] files - file information for database update
+ * @param[in] flags - file flags to set instead of those of the passed file information (optional)
+ * @return true if all updates were successful, else false
+ */
+bool LogDatabase::updateFiles(const std::vector<FileInformation> & files, const boost::optional<boost::uint64_t> & flags) {
+	if ( files.empty() ) return true;
+	std::vector<std::string> keys;
+	pcf::data::OctetBlock commit;
+	keys.reserve(files.size());
+	BOOST_FOREACH(const FileInformation & file, files) {
+		keys.push_back(LogDatabase::convertKey(file.path));
+		encodeFile(commit, keys.back(), file.size, DatabaseBackend::toDatabaseTime(file.lastChange), ( flags ) ? *flags : file.flags);
+	}
+	boost::mutex::scoped_lock lock(this->mutex);
+	if ( ! this->append(commit, files.size()) ) return false;
+	for (size_t i = 0; i < files.size(); i++) {
+		FileRecord & record = this->fileRecords[keys[i]];
+		record.size = files[i].size;
+		record.lastModified = DatabaseBackend::toDatabaseTime(files[i].lastChange);
+		record.flags = ( flags ) ? *flags : files[i].flags;
+	}
+	return true;
+}
+
+
+/**
+ * Returns the meta data for a given file.
+ *
+ * @param[out] result - output variable for the meta data
+ * @param[in] file - path to requested file
+ * @return true if the file is in the database, else false
+ */
+bool LogDatabase::getFile(FileInformation & result, const boost::filesystem::path & file) {
+	const std::string key(LogDatabase::convertKey(file));
+	boost::mutex::scoped_lock lock(this->mutex);
+	const FileMap::const_iterator it = this->fileRecords.find(key);
+	if (it == this->fileRecords.end()) return false;
+	result.path = file;
+	result.size = it->second.size;
+	result.lastChange = DatabaseBackend::fromDatabaseTime(it->second.lastModified);
+	result.flags = it->second.flags;
+	return true;
+}
+
+
+/**
+ * Returns the meta data of all files.
+ *
+ * @param[out] result - output variable for the meta data
+ * @return true on success, else false
+ */
+bool LogDatabase::getFiles(std::vector<FileInformation> & result) {
+	result.clear();
+	boost::mutex::scoped_lock lock(this->mutex);
+	result.reserve(this->fileRecords.size());
+	for (FileMap::const_iterator it = this->fileRecords.begin(), endIt = this->fileRecords.end(); it != endIt; ++it) {
+		FileInformation fileInfo;
+		fileInfo.path = boost::filesystem::path(it->first, pcf::path::utf8);
+		fileInfo.size = it->second.size;
+		fileInfo.lastChange = DatabaseBackend::fromDatabaseTime(it->second.lastModified);
+		fileInfo.flags = it->second.flags;
+		result.push_back(fileInfo);
+	}
+	return true;
+}
+
+
+/**
+ * Sets the flags for a given file.
+ *
+ * @param[in] file - set the flags for this file
+ * @param[in] flags - flags to set
+ * @return true if file exists and flags were set, else false
+ */
+bool LogDatabase::setFlags(const boost::filesystem::path & file, const boost::uint64_t flags) {
+	FileInformation fileInfo;
+	std::vector<FileInformation> files;
+	std::vector<boost::filesystem::path> failed;
+	fileInfo.path = file;
+	fileInfo.flags = flags;
+	files.push_back(fileInfo);
+	return this->setFlags(files, failed) && failed.empty();
+}
+
+
+/**
+ * Sets the flags for the given files within a single commit. Files which are not in the
+ * database are skipped and reported.
+ *
+ * @param[in] files - set the flags of the file information for these files
+ * @param[out] failed - output variable for the files which are not in the database
+ * @return true if all existing files were updated, else false
+ */
+bool LogDatabase::setFlags(const std::vector<FileInformation> & files, std::vector<boost::filesystem::path> & failed) {
+	std::vector<FileMap::iterator> found;
+	pcf::data::OctetBlock commit;
+	failed.clear();
+	if ( files.empty() ) return true;
+	boost::mutex::scoped_lock lock(this->mutex);
+	found.reserve(files.size());
+	BOOST_FOREACH(const FileInformation & file, files) {
+		const FileMap::iterator it = this->fileRecords.find(LogDatabase::convertKey(file.path));
+		if (it == this->fileRecords.end()) {
+			failed.push_back(file.path);
+			found.push_back(it);
+			continue;
+		}
+		commit.push_back(static_cast<boost::uint8_t>(RECORD_FILE_FLAGS));
+		appendString(commit, it->first);
+		appendNumber(commit, file.flags);
+		found.push_back(it);
+	}
+	if ( ! this->append(commit, files.size() - failed.size()) ) return false;
+	for (size_t i = 0; i < files.size(); i++) {
+		if (found[i] != this->fileRecords.end()) found[i]->second.flags = files[i].flags;
+	}
+	return true;
+}
+
+
+/**
+ * Sets the flags for all files.
+ *
+ * @param[in] flags - flags to set
+ * @return true if file flags were set, else false
+ */
+bool LogDatabase::setAllFlags(const boost::uint64_t flags) {
+	pcf::data::OctetBlock commit;
+	commit.push_back(static_cast<boost::uint8_t>(RECORD_ALL_FLAGS));
+	appendNumber(commit, flags);
+	boost::mutex::scoped_lock lock(this->mutex);
+	if ( ! this->append(commit, 1) ) return false;
+	this->applyAllFlags(flags);
+	return true;
+}
+
+
+/**
+ * Adds the passed flags to the given file.
+ *
+ * @param[in] file - set the flags for this file
+ * @param[in] flags - flags to add
+ * @return true if file exists and flags were added, else false
+ */
+bool LogDatabase::addFlags(const boost::filesystem::path & file, const boost::uint64_t flags) {
+	pcf::data::OctetBlock commit;
+	boost::mutex::scoped_lock lock(this->mutex);
+	const FileMap::iterator it = this->fileRecords.find(LogDatabase::convertKey(file));
+	if (it == this->fileRecords.end()) return false;
+	commit.push_back(static_cast<boost::uint8_t>(RECORD_FILE_FLAGS));
+	appendString(commit, it->first);
+	appendNumber(commit, it->second.flags | flags);
+	if ( ! this->append(commit, 1) ) return false;
+	it->second.flags |= flags;
+	return true;
+}
+
+
+/**
+ * Delete the given file and its content hash record from the database.
+ *
+ * @param[in] file - file to remove from database
+ * @return true if the file was removed, false on error or if no such file was found in the database
+ */
+bool LogDatabase::deleteFile(const boost::filesystem::path & file) {
+	pcf::data::OctetBlock commit;
+	boost::mutex::scoped_lock lock(this->mutex);
+	const FileMap::iterator it = this->fileRecords.find(LogDatabase::convertKey(file));
+	if (it == this->fileRecords.end()) return false;
+	const std::string key(it->first);
+	commit.push_back(static_cast<boost::uint8_t>(RECORD_FILE_DELETE));
+	appendString(commit, key);
+	if ( ! this->append(commit, 1) ) return false;
+	this->applyDeleteFile(key);
+	return true;
+}
+
+
+/**
+ * Delete the given files and their content hash records from the database within a single
+ * commit. Files which are not in the database are ignored.
+ *
+ * @param[in] files - files to remove from database
+ * @return true on success, else false
+ */
+bool LogDatabase::deleteFiles(const std::vector<boost::filesystem::path> & files) {
+	std::set<std::string, PathLess> found;
+	pcf::data::OctetBlock commit;
+	boost::mutex::scoped_lock lock(this->mutex);
+	BOOST_FOREACH(const boost::filesystem::path & file, files) {
+		const FileMap::const_iterator it = this->fileRecords.find(LogDatabase::convertKey(file));
+		if (it == this->fileRecords.end() || ( ! found.insert(it->first).second )) continue;
+		commit.push_back(static_cast<boost::uint8_t>(RECORD_FILE_DELETE));
+		appendString(commit, it->first);
+	}
+	if ( found.empty() ) return true;
+	if ( ! this->append(commit, found.size()) ) return false;
+	BOOST_FOREACH(const std::string & key, found) {
+		this->applyDeleteFile(key);
+	}
+	return true;
+}
+
+
+/**
+ * Traverse all files in the database for which the given flags are set. The matching files are
+ * collected first. The callback is called without holding the database access mutex.
+ *
+ * @param[in] call - visitor to call
+ * @param[in] flags - match files with these flags
+ * @return true on success, else false if the callback returned false
+ * @remarks The callback needs to return true to continue or false to abort the operation.
+ * @see Database::Callback
+ */
+bool LogDatabase::forEachFileByFlag(const Database::Callback & call, const boost::uint64_t flags) {
+	std::vector<FileInformation> matches;
+	if ( ! call ) return true;
+	{
+		boost::mutex::scoped_lock lock(this->mutex);
+		for (FileMap::const_iterator it = this->fileRecords.begin(), endIt = this->fileRecords.end(); it != endIt; ++it) {
+			if ( ! matchesFlags(it->second.flags, flags) ) continue;
+			FileInformation fileInfo;
+			fileInfo.path = boost::filesystem::path(it->first, pcf::path::utf8);
+			fileInfo.size = it->second.size;
+			fileInfo.lastChange = DatabaseBackend::fromDatabaseTime(it->second.lastModified);
+			fileInfo.flags = it->second.flags;
+			matches.push_back(fileInfo);
+		}
+	}
+	BOOST_FOREACH(const FileInformation & fileInfo, matches) {
+		if ( ! call(fileInfo) ) return false;
+	}
+	return true;
+}
+
+
+/**
+ * Delete all files that match the given flags together with their content hash records.
+ *
+ * @param[in] flags - compare with these flags
+ * @return true on success, else false
+ */
+bool LogDatabase::deleteFilesByFlag(const boost::uint64_t flags) {
+	pcf::data::OctetBlock commit;
+	commit.push_back(static_cast<boost::uint8_t>(RECORD_DELETE_BY_FLAG));
+	appendNumber(commit, flags);
+	boost::mutex::scoped_lock lock(this->mutex);
+	if ( ! this->append(commit, 1) ) return false;
+	this->applyDeleteByFlag(flags);
+	return true;
+}
+
+
+/**
+ * Adds the given transition runtime records within a single commit. Only the last
+ * Database::runtimeHistorySize records are kept per transition.
+ *
+ * @param[in] records - transition runtime records to add
+ * @return true on success, else false
+ */
+bool LogDatabase::addRuntimes(const TransitionRuntimeVector & records) {
+	if ( records.empty() ) return true;
+	pcf::data::OctetBlock commit;
+	BOOST_FOREACH(const TransitionRuntime & record, records) {
+		encodeRuntime(commit, record.process, record.transition, record.runtime);
+	}
+	boost::mutex::scoped_lock lock(this->mutex);
+	if ( ! this->append(commit, records.size()) ) return false;
+	BOOST_FOREACH(const TransitionRuntime & record, records) {
+		this->applyRuntime(record.process, record.transition, record.runtime);
+	}
+	return true;
+}
+
+
+/**
+ * Returns the runtime records of the given transition starting with the most recent one.
+ *
+ * @param[out] result - output variable for the runtime records
+ * @param[in] process - ID of the process of the transition
+ * @param[in] transition - unique key of the transition within its process
+ * @return true if at least one record was found, else false
+ */
+bool LogDatabase::getRuntimes(RuntimeInformationVector & result, const std::string & process, const std::string & transition) {
+	result.clear();
+	boost::mutex::scoped_lock lock(this->mutex);
+	const RuntimeMap::const_iterator it = this->runtimeRecords.find(std::make_pair(process, transition));
+	if (it == this->runtimeRecords.end()) return false;
+	result.assign(it->second.rbegin(), it->second.rend());
+	return ( ! result.empty() );
+}
+
+
+/**
+ * Returns the stored listing of the given directory.
+ *
+ * @param[out] result - output variable for the directory listing
+ * @param[in] directory - absolute path to the requested directory
+ * @return true if a valid listing for the directory is in the database, else false
+ */
+bool LogDatabase::getListing(DirectoryListing & result, const boost::filesystem::path & directory) {
+	const std::string key(LogDatabase::convertKey(directory));
+	boost::mutex::scoped_lock lock(this->mutex);
+	const ListingMap::const_iterator it = this->listingRecords.find(key);
+	if (it == this->listingRecords.end()) return false;
+	result.path = directory;
+	result.inode = it->second.inode;
+	result.modified = it->second.modified;
+	result.changed = it->second.changed;
+	result.entries.clear();
+	if ( ! DatabaseBackend::decodeEntries(result.entries, it->second.entries) ) {
+		result.entries.clear();
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ * Inserts or updates the passed directory listings within a single commit.
+ *
+ * @param[in] listings - directory listings to store
+ * @return true on success, else false
+ */
+bool LogDatabase::updateListings(const std::vector<DirectoryListing> & listings) {
+	if ( listings.empty() ) return true;
+	std::vector<std::string> keys, entries;
+	pcf::data::OctetBlock commit;
+	keys.reserve(listings.size());
+	entries.reserve(listings.size());
+	BOOST_FOREACH(const DirectoryListing & listing, listings) {
+		keys.push_back(LogDatabase::convertKey(listing.path));
+		entries.push_back(DatabaseBackend::encodeEntries(listing.entries));
+		encodeListing(commit, keys.back(), listing.inode, listing.modified, listing.changed, entries.back());
+	}
+	boost::mutex::scoped_lock lock(this->mutex);
+	if ( ! this->append(commit, listings.size()) ) return false;
+	for (size_t i = 0; i < listings.size(); i++) {
+		ListingRecord & record = this->listingRecords[keys[i]];
+		record.inode = listings[i].inode;
+		record.modified = listings[i].modified;
+		record.changed = listings[i].changed;
+		record.entries.swap(entries[i]);
+	}
+	return true;
+}
+
+
+/**
+ * Returns all stored content hash records.
+ *
+ * @param[out] result - output variable for the content hash records
+ * @return true on success, else false
+ */
+bool LogDatabase::getHashes(std::vector<ContentHash> & result) {
+	result.clear();
+	boost::mutex::scoped_lock lock(this->mutex);
+	result.reserve(this->hashRecords.size());
+	for (HashMap::const_iterator it = this->hashRecords.begin(), endIt = this->hashRecords.end(); it != endIt; ++it) {
+		ContentHash record;
+		record.path = boost::filesystem::path(it->first, pcf::path::utf8);
+		record.size = it->second.size;
+		record.lastModified = DatabaseBackend::fromDatabaseTime(it->second.lastModified);
+		record.contentChanged = DatabaseBackend::fromDatabaseTime(it->second.contentChanged);
+		record.hash = it->second.hash;
+		result.push_back(record);
+	}
+	return true;
+}
+
+
+/**
+ * Inserts or updates the passed content hash records within a single commit.
+ *
+ * @param[in] records - content hash records to store
+ * @return true on success, else false
+ */
+bool LogDatabase::updateHashes(const std::vector<ContentHash> & records) {
+	if ( records.empty() ) return true;
+	std::vector<std::string> keys;
+	pcf::data::OctetBlock commit;
+	keys.reserve(records.size());
+	BOOST_FOREACH(const ContentHash & record, records) {
+		keys.push_back(LogDatabase::convertKey(record.path));
+		encodeHash(commit, keys.back(), record.size, DatabaseBackend::toDatabaseTime(record.lastModified), DatabaseBackend::toDatabaseTime(record.contentChanged), record.hash);
+	}
+	boost::mutex::scoped_lock lock(this->mutex);
+	if ( ! this->append(commit, records.size()) ) return false;
+	for (size_t i = 0; i < records.size(); i++) {
+		HashRecord & record = this->hashRecords[keys[i]];
+		record.size = records[i].size;
+		record.lastModified = DatabaseBackend::toDatabaseTime(records[i].lastModified);
+		record.contentChanged = DatabaseBackend::toDatabaseTime(records[i].contentChanged);
+		record.hash = records[i].hash;
+	}
+	return true;
+}
+
+
+/**
+ * Deletes the content hash records of the given files within a single commit. Files without
+ * content hash record are ignored.
+ *
+ * @param[in] files - remove the content hash records of these files
+ * @return true on success, else false
+ */
+bool LogDatabase::deleteHashes(const std::vector<boost::filesystem::path> & files) {
+	std::set<std::string, PathLess> found;
+	pcf::data::OctetBlock commit;
+	boost::mutex::scoped_lock lock(this->mutex);
+	BOOST_FOREACH(const boost::filesystem::path & file, files) {
+		const HashMap::const_iterator it = this->hashRecords.find(LogDatabase::convertKey(file));
+		if (it == this->hashRecords.end() || ( ! found.insert(it->first).second )) continue;
+		commit.push_back(static_cast<boost::uint8_t>(RECORD_HASH_DELETE));
+		appendString(commit, it->first);
+	}
+	if ( found.empty() ) return true;
+	if ( ! this->append(commit, found.size()) ) return false;
+	BOOST_FOREACH(const std::string & key, found) {
+		this->hashRecords.erase(key);
+	}
+	return true;
+}
+
+
+/**
+ * Compacts the log file if it holds more than LogDatabase::compactionRatio records per current
+ * record.
+ *
+ * @return true on success, else false
+ */
+bool LogDatabase::cleanUp() {
+	boost::mutex::scoped_lock lock(this->mutex);
+	if (this->needsCompaction || this->logRecords > (LogDatabase::compactionRatio * this->getRecordCount())) {
+		return this->compact();
+	}
+	return true;
+}
+
+
+/**
+ * Removes all entries in the database to reset it to its initial state.
+ *
+ * @return true on success, else false
+ */
+bool LogDatabase::clear() {
+	pcf::data::OctetBlock commit;
+	commit.push_back(static_cast<boost::uint8_t>(RECORD_CLEAR));
+	boost::mutex::scoped_lock lock(this->mutex);
+	if ( ! this->append(commit, 1) ) return false;
+	this->applyClear();
+	return true;
+}
+
+
+/**
+ * Maps the log file into memory and replays its records. A new log file is written if it does
+ * not exist or has an outdated format version. Incomplete or malformed commits at the end are
+ * dropped by rewriting the log file.
+ *
+ * @throws pcf::exception::Database if the log file could not be read, written or has an invalid type
+ */
+void LogDatabase::load() {
+	boost::system::error_code ec;
+	const boost::filesystem::file_status status = boost::filesystem::status(this->path, ec);
+	const bool exists = boost::filesystem::exists(status);
+	const boost::uintmax_t size = exists ? boost::filesystem::file_size(this->path, ec) : 0;
+	if (exists && ec) {
+		BOOST_THROW_EXCEPTION(
+			pcf::exception::Database()
+			<< pcf::exception::tag::Message("Failed to read the database file \"" + this->path.string(pcf::path::utf8) + "\".")
+		);
+	}
+	if (size > 0) {
+		boost::iostreams::mapped_file_source source;
+		try {
+			source.open(this->path);
+		} catch (...) {
+			BOOST_THROW_EXCEPTION(
+				pcf::exception::Database()
+				<< pcf::exception::tag::Message("Failed to map the database file \"" + this->path.string(pcf::path::utf8) + "\".")
+			);
+		}
+		const boost::uint8_t * data = reinterpret_cast<const boost::uint8_t *>(source.data());
+		if (source.size() < logHeaderSize || std::memcmp(data, logMagic, logHeaderSize - 1) != 0) {
+			BOOST_THROW_EXCEPTION(
+				pcf::exception::Database()
+				<< pcf::exception::tag::Message("Invalid database type of \"" + this->path.string(pcf::path::utf8) + "\".")
+			);
+		}
+		if (data[logHeaderSize - 1] == logVersion) {
+			Reader log(data + logHeaderSize, source.size() - logHeaderSize);
+			if ( ! this->replay(log) ) this->needsCompaction = true;
+		} else {
+			/* database version does not match -> recreate database */
+			this->needsCompaction = true;
+		}
+	} else {
+		this->needsCompaction = true;
+	}
+	if ( this->needsCompaction ) {
+		if ( ! this->compact() ) {
+			BOOST_THROW_EXCEPTION(
+				pcf::exception::Database()
+				<< pcf::exception::tag::Message("Failed to write the database file \"" + this->path.string(pcf::path::utf8) + "\".")
+			);
+		}
+	} else {
+		try {
+			this->output.reset(new pcf::file::ofstream(this->path, std::ofstream::binary | std::ofstream::app | std::ofstream::out));
+		} catch (...) {
+			BOOST_THROW_EXCEPTION(
+				pcf::exception::Database()
+				<< pcf::exception::tag::Message("Failed to open the database file \"" + this->path.string(pcf::path::utf8) + "\" for writing.")
+			);
+		}
+	}
+}
+
+
+/**
+ * Replays all commits from the given log. Each commit is decoded and validated as a whole before
+ * any of its records is applied.
+ *
+ * @param[in,out] log - read commits from here
+ * @return true if all commits were valid, else false
+ */
+bool LogDatabase::replay(Reader & log) {
+	while ( ! log.atEnd() ) {
+		const boost::uint64_t size = log.readNumber();
+		if (( ! log.isValid() ) || size > static_cast<boost::uint64_t>(log.remaining())) {
+			/* incomplete commit */
+			return false;
+		}
+		Reader commit(log.take(static_cast<size_t>(size)));
+		/* validate all records of the commit first */
+		Reader check(commit);
+		size_t count = 0;
+		while ( ! check.atEnd() ) {
+			if ( ! this->applyRecord(check, false) ) return false;
+			count++;
+		}
+		/* apply the validated records */
+		while ( ! commit.atEnd() ) {
+			this->applyRecord(commit, true);
+		}
+		this->logRecords += count;
+	}
+	return true;
+}
+
+
+/**
+ * Decodes the next record of the given commit and applies it to the current records if
+ * requested.
+ *
+ * @param[in,out] commit - read the record from here
+ * @param[in] apply - set to false to only validate the record
+ * @return true on success, else false if the record is malformed
+ */
+bool LogDatabase::applyRecord(Reader & commit, const bool apply) {
+	switch (commit.readOctet()) {
+	case RECORD_FILE:
+		{
+			const std::string key(commit.readString());
+			FileRecord record;
+			record.size = commit.readNumber();
+			record.lastModified = commit.readSigned();
+			record.flags = commit.readNumber();
+			if ( ! commit.isValid() ) return false;
+			if ( apply ) this->fileRecords[key] = record;
+		}
+		break;
+	case RECORD_FILE_FLAGS:
+		{
+			const std::string key(commit.readString());
+			const boost::uint64_t flags = commit.readNumber();
+			if ( ! commit.isValid() ) return false;
+			if ( apply ) {
+				const FileMap::iterator it = this->fileRecords.find(key);
+				if (it != this->fileRecords.end()) it->second.flags = flags;
+			}
+		}
+		break;
+	case RECORD_FILE_DELETE:
+		{
+			const std::string key(commit.readString());
+			if ( ! commit.isValid() ) return false;
+			if ( apply ) this->applyDeleteFile(key);
+		}
+		break;
+	case RECORD_ALL_FLAGS:
+		{
+			const boost::uint64_t flags = commit.readNumber();
+			if ( ! commit.isValid() ) return false;
+			if ( apply ) this->applyAllFlags(flags);
+		}
+		break;
+	case RECORD_DELETE_BY_FLAG:
+		{
+			const boost::uint64_t flags = commit.readNumber();
+			if ( ! commit.isValid() ) return false;
+			if ( apply ) this->applyDeleteByFlag(flags);
+		}
+		break;
+	case RECORD_RUNTIME:
+		{
+			const std::string process(commit.readString());
+			const std::string transition(commit.readString());
+			RuntimeInformation runtime;
+			runtime.duration = boost::posix_time::milliseconds(commit.readSigned());
+			runtime.exitCode = static_cast<int>(commit.readSigned());
+			runtime.outputSize = commit.readNumber();
+			if ( ! commit.isValid() ) return false;
+			if ( apply ) this->applyRuntime(process, transition, runtime);
+		}
+		break;
+	case RECORD_LISTING:
+		{
+			const std::string key(commit.readString());
+			ListingRecord record;
+			record.inode = static_cast<boost::int64_t>(commit.readFixed());
+			record.modified = static_cast<boost::int64_t>(commit.readFixed());
+			record.changed = static_cast<boost::int64_t>(commit.readFixed());
+			record.entries = commit.readString();
+			if ( ! commit.isValid() ) return false;
+			if ( apply ) this->listingRecords[key] = record;
+		}
+		break;
+	case RECORD_HASH:
+		{
+			const std::string key(commit.readString());
+			HashRecord record;
+			record.size = commit.readNumber();
+			record.lastModified = commit.readSigned();
+			record.contentChanged = commit.readSigned();
+			record.hash = commit.readFixed();
+			if ( ! commit.isValid() ) return false;
+			if ( apply ) this->hashRecords[key] = record;
+		}
+		break;
+	case RECORD_HASH_DELETE:
+		{
+			const std::string key(commit.readString());
+			if ( ! commit.isValid() ) return false;
+			if ( apply ) this->hashRecords.erase(key);
+		}
+		break;
+	case RECORD_CLEAR:
+		if ( apply ) this->applyClear();
+		break;
+	default:
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ * Sets the flags of all current file records.
+ *
+ * @param[in] flags - flags to set
+ */
+void LogDatabase::applyAllFlags(const boost::uint64_t flags) {
+	for (FileMap::iterator it = this->fileRecords.begin(), endIt = this->fileRecords.end(); it != endIt; ++it) {
+		it->second.flags = flags;
+	}
+}
+
+
+/**
+ * Removes the current file record and content hash record of the given file.
+ *
+ * @param[in] key - normalized file path
+ */
+void LogDatabase::applyDeleteFile(const std::string & key) {
+	this->hashRecords.erase(key);
+	this->fileRecords.erase(key);
+}
+
+
+/**
+ * Removes all current file records that match the given flags together with their content hash
+ * records.
+ *
+ * @param[in] flags - compare with these flags
+ */
+void LogDatabase::applyDeleteByFlag(const boost::uint64_t flags) {
+	for (FileMap::iterator it = this->fileRecords.begin(), endIt = this->fileRecords.end(); it != endIt; ) {
+		if ( matchesFlags(it->second.flags, flags) ) {
+			this->hashRecords.erase(it->first);
+			this->fileRecords.erase(it++);
+		} else {
+			++it;
+		}
+	}
+}
+
+
+/**
+ * Adds the given runtime record and removes the outdated ones of the same transition.
+ *
+ * @param[in] process - ID of the process of the transition
+ * @param[in] transition - unique key of the transition within its process
+ * @param[in] runtime - runtime information to add
+ */
+void LogDatabase::applyRuntime(const std::string & process, const std::string & transition, const RuntimeInformation & runtime) {
+	std::deque<RuntimeInformation> & list(this->runtimeRecords[std::make_pair(process, transition)]);
+	list.push_back(runtime);
+	while (list.size() > Database::runtimeHistorySize) list.pop_front();
+}
+
+
+/**
+ * Removes all current records.
+ */
+void LogDatabase::applyClear() {
+	this->fileRecords.clear();
+	this->runtimeRecords.clear();
+	this->listingRecords.clear();
+	this->hashRecords.clear();
+}
+
+
+/**
+ * Appends the given records as single commit to the log file and synchronizes it to the storage
+ * device. The database access mutex needs to be held by the caller.
+ *
+ * @param[in] commit - encoded records
+ * @param[in] count - number of records in commit
+ * @return true on success, else false
+ */
+bool LogDatabase::append(const pcf::data::OctetBlock & commit, const size_t count) {
+	if ( commit.empty() ) return true;
+	if ( ! this->output ) return false;
+	if ( ! writeCommit(*(this->output), commit) ) return false;
+	if ( ! syncFile(*(this->output)) ) return false;
+	this->logRecords += count;
+	return true;
+}
+
+
+/**
+ * Writes a snapshot of the current records to a temporary file and replaces the log file with
+ * it. The log file is opened for appending afterwards. The database access mutex needs to be
+ * held by the caller.
+ *
+ * @return true on success, else false
+ */
+bool LogDatabase::compact() {
+	boost::filesystem::path temp(this->path);
+	bool written;
+	temp += ".tmp";
+	try {
+		{
+			pcf::file::ofstream out(temp, std::ofstream::binary | std::ofstream::trunc | std::ofstream::out);
+			pcf::data::OctetBlock commit;
+			out.write(logMagic, static_cast<std::streamsize>(logHeaderSize - 1));
+			out.put(static_cast<char>(logVersion));
+			for (FileMap::const_iterator it = this->fileRecords.begin(), endIt = this->fileRecords.end(); it != endIt; ++it) {
+				encodeFile(commit, it->first, it->second.size, it->second.lastModified, it->second.flags);
+				if (commit.size() >= snapshotCommitSize) {
+					writeCommit(out, commit);
+					commit.clear();
+				}
+			}
+			for (RuntimeMap::const_iterator it = this->runtimeRecords.begin(), endIt = this->runtimeRecords.end(); it != endIt; ++it) {
+				BOOST_FOREACH(const RuntimeInformation & runtime, it->second) {
+					encodeRuntime(commit, it->first.first, it->first.second, runtime);
+				}
+				if (commit.size() >= snapshotCommitSize) {
+					writeCommit(out, commit);
+					commit.clear();
+				}
+			}
+			for (ListingMap::const_iterator it = this->listingRecords.begin(), endIt = this->listingRecords.end(); it != endIt; ++it) {
+				encodeListing(commit, it->first, it->second.inode, it->second.modified, it->second.changed, it->second.entries);
+				if (commit.size() >= snapshotCommitSize) {
+					writeCommit(out, commit);
+					commit.clear();
+				}
+			}
+			for (HashMap::const_iterator it = this->hashRecords.begin(), endIt = this->hashRecords.end(); it != endIt; ++it) {
+				encodeHash(commit, it->first, it->second.size, it->second.lastModified, it->second.contentChanged, it->second.hash);
+				if (commit.size() >= snapshotCommitSize) {
+					writeCommit(out, commit);
+					commit.clear();
+				}
+			}
+			if ( ! commit.empty() ) writeCommit(out, commit);
+			written = syncFile(out);
+		}
+		if ( ! written ) {
+			boost::system::error_code ec;
+			boost::filesystem::remove(temp, ec);
+			return false;
+		}
+		/* the log file needs to be closed before it can be replaced on all platforms */
+		this->output.reset();
+		boost::filesystem::rename(temp, this->path);
+		this->output.reset(new pcf::file::ofstream(this->path, std::ofstream::binary | std::ofstream::app | std::ofstream::out));
+	} catch (...) {
+		boost::system::error_code ec;
+		boost::filesystem::remove(temp, ec);
+		if ( ! this->output ) {
+			try {
+				this->output.reset(new pcf::file::ofstream(this->path, std::ofstream::binary | std::ofstream::app | std::ofstream::out));
+			} catch (...) {}
+		}
+		return false;
+	}
+	this->logRecords = this->getRecordCount();
+	this->needsCompaction = false;
+	return true;
+}
+
+
+/**
+ * Returns the number of current records.
+ *
+ * @return record count
+ */
+size_t LogDatabase::getRecordCount() const {
+	size_t result = this->fileRecords.size() + this->listingRecords.size() + this->hashRecords.size();
+	for (RuntimeMap::const_iterator it = this->runtimeRecords.begin(), endIt = this->runtimeRecords.end(); it != endIt; ++it) {
+		result += it->second.size();
+	}
+	return result;
+}
+
+
+/**
+ * Converts the given path into the key used for the record maps.
+ *
+ * @param[in] path - path to convert
+ * @return normalized UTF-8 path
+ */
+std::string LogDatabase::convertKey(const boost::filesystem::path & path) {
+	return DatabaseBackend::convertPath(path).generic_string(pcf::path::utf8);
+}
+
+
+} /* namespace pp */
@@ -0,0 +1,135 @@
+/**
+ * @file LogDatabase.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#ifndef __PP_LOGDATABASE_HPP__
+#define __PP_LOGDATABASE_HPP__
+
+
+#include <deque>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <pcf/data/OctetBlock.hpp>
+#include <pcf/file/Stream.hpp>
+#include "DatabaseBackend.hpp"
+#include "Type.hpp"
+
+
+namespace pp {
+
+
+/**
+ * Database backend which keeps all records in memory and stores each change as record within
+ * an append-only log file. The log file is memory-mapped and replayed on open. Each write
+ * operation appends a single length prefixed commit which is synchronized to the storage device
+ * and discarded as a whole if it was not completely written. The log file is compacted into a
+ * snapshot of the current records on cleanUp() if it holds too many outdated records. An
+ * exclusive advisory lock on the lock file next to the log file prevents concurrent access by
+ * other processes.
+ */
+class LogDatabase : public DatabaseBackend {
+public:
+	/** The log file is compacted if it holds more than this many records per current record. */
+	static const size_t compactionRatio = 2;
+private:
+	class Reader; /**< Forward declaration of the internal log file decoder. */
+	class FileLock; /**< Forward declaration of the internal advisory file lock. */
+	
+	/** Stored file record. */
+	struct FileRecord {
+		boost::uint64_t size; /**< File size in bytes. */
+		boost::int64_t lastModified; /**< Last modification time in microseconds since 1970-01-01. */
+		boost::uint64_t flags; /**< File flags. */
+	};
+	
+	/** Stored directory listing record. */
+	struct ListingRecord {
+		boost::int64_t inode; /**< File serial number of the directory. */
+		boost::int64_t modified; /**< Last modification time of the directory in nanoseconds since epoch. */
+		boost::int64_t changed; /**< Last status change time of the directory in nanoseconds since epoch. */
+		std::string entries; /**< Encoded directory entries. */
+	};
+	
+	/** Stored content hash record. */
+	struct HashRecord {
+		boost::uint64_t size; /**< File size in bytes. */
+		boost::int64_t lastModified; /**< Last modification time in microseconds since 1970-01-01. */
+		boost::int64_t contentChanged; /**< Last content change time in microseconds since 1970-01-01. */
+		boost::uint64_t hash; /**< Hash value of the file content. */
+	};
+	
+	/** Map type of file records by normalized path. */
+	typedef std::map<std::string, FileRecord, PathLess> FileMap;
+	/** Map type of runtime records by process ID and transition key. The most recent record is last. */
+	typedef std::map<std::pair<std::string, std::string>, std::deque<RuntimeInformation> > RuntimeMap;
+	/** Map type of directory listing records by normalized path. */
+	typedef std::map<std::string, ListingRecord, PathLess> ListingMap;
+	/** Map type of content hash records by normalized path. */
+	typedef std::map<std::string, HashRecord, PathLess> HashMap;
+	
+	boost::mutex mutex; /**< Database access mutex. */
+	boost::filesystem::path path; /**< Path to the log file. */
+	boost::scoped_ptr<FileLock> fileLock; /**< Advisory lock held while the log file is open. */
+	boost::scoped_ptr<pcf::file::ofstream> output; /**< Log file opened for appending. */
+	size_t logRecords; /**< Number of records in the log file. */
+	bool needsCompaction; /**< True if the log file needs to be rewritten before appending. */
+	FileMap fileRecords; /**< Current file records. */
+	RuntimeMap runtimeRecords; /**< Current runtime records. */
+	ListingMap listingRecords; /**< Current directory listing records. */
+	HashMap hashRecords; /**< Current content hash records. */
+public:
+	explicit LogDatabase(const boost::filesystem::path & db);
+	virtual ~LogDatabase();
+	virtual boost::mutex & getMutex();
+	virtual bool isOpen() const;
+	virtual bool updateFile(const FileInformation & file);
+	virtual bool updateFiles(const std::vector<FileInformation> & files, const boost::optional<boost::uint64_t> & flags);
+	virtual bool getFile(FileInformation & result, const boost::filesystem::path & file);
+	virtual bool getFiles(std::vector<FileInformation> & result);
+	virtual bool setFlags(const boost::filesystem::path & file, const boost::uint64_t flags);
+	virtual bool setFlags(const std::vector<FileInformation> & files, std::vector<boost::filesystem::path> & failed);
+	virtual bool setAllFlags(const boost::uint64_t flags);
+	virtual bool addFlags(const boost::filesystem::path & file, const boost::uint64_t flags);
+	virtual bool deleteFile(const boost::filesystem::path & file);
+	virtual bool deleteFiles(const std::vector<boost::filesystem::path> & files);
+	virtual bool forEachFileByFlag(const Database::Callback & call, const boost::uint64_t flags);
+	virtual bool deleteFilesByFlag(const boost::uint64_t flags);
+	virtual bool addRuntimes(const TransitionRuntimeVector & records);
+	virtual bool getRuntimes(RuntimeInformationVector & result, const std::string & process, const std::string & transition);
+	virtual bool getListing(DirectoryListing & result, const boost::filesystem::path & directory);
+	virtual bool updateListings(const std::vector<DirectoryListing> & listings);
+	virtual bool getHashes(std::vector<ContentHash> & result);
+	virtual bool updateHashes(const std::vector<ContentHash> & records);
+	virtual bool deleteHashes(const std::vector<boost::filesystem::path> & files);
+	virtual bool cleanUp();
+	virtual bool clear();
+private:
+	void load();
+	bool replay(Reader & log);
+	bool applyRecord(Reader & commit, const bool apply);
+	void applyAllFlags(const boost::uint64_t flags);
+	void applyDeleteFile(const std::string & key);
+	void applyDeleteByFlag(const boost::uint64_t flags);
+	void applyRuntime(const std::string & process, const std::string & transition, const RuntimeInformation & runtime);
+	void applyClear();
+	bool append(const pcf::data::OctetBlock & commit, const size_t count);
+	bool compact();
+	size_t getRecordCount() const;
+	static std::string convertKey(const boost::filesystem::path & path);
+};
+
+
+} /* namespace pp */
+
+
+#endif /* __PP_LOGDATABASE_HPP__ */
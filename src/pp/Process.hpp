@@ -3,14 +3,16 @@
  * @author Daniel Starke
  * @copyright Copyright 2015-2018 Daniel Starke
  * @date 2015-03-22
- * @version 2017-09-16
+ * @version 2026-10-17
  */
 #ifndef __PP_PROCESS_HPP__
 #define __PP_PROCESS_HPP__
 
 
+#include <algorithm>
 #include <cstdlib>
 #include <iosfwd>
+#include <set>
 #include <string>
 #include <vector>
 #include <boost/algorithm/string/trim.hpp>
@@ -18,8 +20,10 @@
 #include <boost/config/warning_disable.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/exception_ptr.hpp>
 #include <boost/filesystem/path.hpp>
 #include <boost/foreach.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/locale.hpp>
 #include <boost/make_shared.hpp>
@@ -35,7 +39,13 @@
 #include <pcf/os/Target.hpp>
 #include <pcf/path/Utility.hpp>
 #include <pcf/string/Escape.hpp>
+#include "Database.hpp"
+#include "FileStatusCache.hpp"
+#include "FileWatcher.hpp"
 #include "ProcessBlock.hpp"
+#include "Scheduler.hpp"
+#include "TaskGroup.hpp"
+#include "Utility.hpp"
 #include "Variable.hpp"
 #include "Type.hpp"
 
@@ -57,20 +67,54 @@ public:
 		FINISHED, /**< The process finished successfully. */
 		FAILED    /**< An error occurred running the process. */
 	};
+	/** Additional priority cost of transitions which failed in the previous execution. */
+	static const boost::uint64_t failedCost = static_cast<boost::uint64_t>(1) << 40;
+	/** Minimal size of an input file list part read by a separate thread in bytes. */
+	static const size_t minInputListChunkSize = 1048576;
 private:
+	/**
+	 * Structure of a consecutive part of an input file list which is read by a single thread.
+	 */
+	struct InputListChunk {
+		const char * begin; /**< First character of the part. */
+		const char * end; /**< End of the part (after its last line break). */
+		size_t firstLine; /**< Line number of the first line within the part. */
+		PathLiteralPtrVector input; /**< Existing input files in list order. */
+		std::vector< std::pair<size_t, std::string> > missing; /**< Line numbers and paths of missing input files. */
+		boost::exception_ptr error; /**< Exception thrown while reading this part. */
+		
+		/**
+		 * Constructor.
+		 *
+		 * @param[in] b - first character
+		 * @param[in] e - end of the part
+		 */
+		explicit InputListChunk(const char * b, const char * e):
+			begin(b),
+			end(e),
+			firstLine(1)
+		{}
+	};
+	
 	LineInfo lineInfo; /**< Line information where this process was defined. */
 	Configuration config; /**< Configuration to enforce. */
 	ProcessBlockVector processBlocks; /**< Process blocks. */
 	ProcessTransitionVector transitions; /**< File transitions due to the process block definitions. */
 	std::string id; /**< ID of the process. */
+	ResourceMap resources; /**< Resources required to execute a single transition. */
 	size_t transitionsInQueue; /**< Number of remaining transitions within the execution queue. */
 	State state; /**< Current process state. @see State */
+	ProcessTransitionRefVector processDependents; /**< Transitions waiting for this process to finish (pipelined execution only). */
+	Scheduler * executionScheduler; /**< Scheduler used for execution or NULL if not started yet. */
+	ProgressCallback executionProgress; /**< Progress callback passed on execution. */
+	ExecutionCallback executionNext; /**< Finish callback passed on execution. */
 	mutable boost::mutex mutex; /**< Mutex object for parallel execution. */
 public:
 	/** Constructor. */
 	explicit Process():
 		transitionsInQueue(0),
-		state(IDLE)
+		state(IDLE),
+		executionScheduler(NULL)
 	{}
 	
 	/**
@@ -84,8 +128,13 @@ public:
 		processBlocks(o.processBlocks),
 		transitions(o.transitions),
 		id(o.id),
+		resources(o.resources),
 		transitionsInQueue(o.transitionsInQueue),
-		state(o.state)
+		state(o.state),
+		processDependents(o.processDependents),
+		executionScheduler(o.executionScheduler),
+		executionProgress(o.executionProgress),
+		executionNext(o.executionNext)
 	{}
 	
 	/**
@@ -101,8 +150,13 @@ public:
 			this->processBlocks = o.processBlocks;
 			this->transitions = o.transitions;
 			this->id = o.id;
+			this->resources = o.resources;
 			this->transitionsInQueue = o.transitionsInQueue;
 			this->state = o.state;
+			this->processDependents = o.processDependents;
+			this->executionScheduler = o.executionScheduler;
+			this->executionProgress = o.executionProgress;
+			this->executionNext = o.executionNext;
 		}
 		return *this;
 	}
@@ -170,6 +224,10 @@ public:
 		this->transitions.clear();
 		this->transitionsInQueue = 0;
 		this->state = IDLE;
+		this->processDependents.clear();
+		this->executionScheduler = NULL;
+		this->executionProgress.clear();
+		this->executionNext.clear();
 	}
 	
 	/**
@@ -201,33 +259,43 @@ public:
 	 * 
 	 * @param[in] strLit - string with with the initial input file definition
 	 * @param[in,out] input - add new input files to this output variable
+	 * @param[in] readDir - callback function to read the entries of a directory (optional)
+	 * @param[in,out] ios - I/O service to read directories and input file lists in parallel on (optional)
 	 * @return true on success, else false
 	 * @remarks The definition can be a regular expression which matches all files on the
-	 * file system which shall be included or a path to a file (if the path starts with @)
-	 * which contains a file per line as a list of files.
+	 * file system which shall be included, a glob pattern (if the definition starts with glob:)
+	 * or a path to a file (if the path starts with @) which contains a file per line as a list
+	 * of files.
 	 *
 	 */
-	bool createInitialInputList(const StringLiteral & strLit, PathLiteralPtrVector & input) {
+	bool createInitialInputList(const StringLiteral & strLit, PathLiteralPtrVector & input, const pcf::path::ReadDirectoryCallback & readDir = pcf::path::ReadDirectoryCallback(), boost::asio::io_service * ios = NULL) {
 		const std::string str(strLit.getString());
 		if ( str.empty() ) return true; /* can only happen for process block type "none" */
-		if (str[0] != '@') {
-			return this->createInitialInputListFromRegEx(str, strLit.getLineInfo(), input);
+		if (str[0] == '@') {
+			return this->createInitialInputListFromFile(str, strLit.getLineInfo(), input, ios);
 		}
-		return this->createInitialInputListFromFile(str, strLit.getLineInfo(), input);
+		if (str.compare(0, 5, "glob:") == 0) {
+			return this->createInitialInputListFromGlob(str.substr(5), strLit.getLineInfo(), input, readDir, ios);
+		}
+		return this->createInitialInputListFromRegEx(str, strLit.getLineInfo(), input, readDir, ios);
 	}
 	
 	/**
-	 * Creates a list of input files from a given input file.
+	 * Creates a list of input files from a given input file. The file is mapped into memory and
+	 * split at line breaks into parts which are read in parallel on the given I/O service. The
+	 * meta data of each part is queried in a single batch.
 	 * 
 	 * @param[in] inFile - read list of input files from this file (line-wise)
 	 * @param[in] li - script location where this input file was defined
 	 * @param[in,out] input - add new input files to this output variable
+	 * @param[in,out] ios - I/O service to read the parts in parallel on (optional)
 	 * @return true on success, else false
 	 * @see createInitialInputList()
 	 */
-	bool createInitialInputListFromFile(const std::string & inFile, const LineInfo & li, PathLiteralPtrVector & input) const {
+	bool createInitialInputListFromFile(const std::string & inFile, const LineInfo & li, PathLiteralPtrVector & input, boost::asio::io_service * ios = NULL) const {
 		const boost::filesystem::path inputFile(inFile.substr(1), pcf::path::utf8);
-		if ( ! (boost::filesystem::exists(inputFile) && boost::filesystem::is_regular_file(inputFile)) ) {
+		const FileStatus inputFileStatus(this->config.fileStatus->get(inputFile));
+		if ( ! inputFileStatus.isRegularFile() ) {
 			std::ostringstream sout;
 			sout << li << ": Error: Input file list file does not exist \"" << inputFile.string(pcf::path::utf8) + "\".";
 			BOOST_THROW_EXCEPTION(
@@ -236,7 +304,13 @@ public:
 			);
 			return false;
 		}
-		pcf::file::ifstream in(inputFile);
+		if (inputFileStatus.size == 0) return true; /* empty files cannot be mapped */
+		boost::iostreams::mapped_file_source in;
+		try {
+			in.open(inputFile);
+		} catch (...) {
+			/* handled below */
+		}
 		if ( ! in.is_open() ) {
 			std::ostringstream sout;
 			sout << li << ": Error: Failed to read file list input file \"" << inputFile.string(pcf::path::utf8) + "\".";
@@ -246,26 +320,42 @@ public:
 			);
 			return false;
 		}
-		/* read input files line by line */
-		LineInfo pathLineInfo(inputFile);
-		size_t lineNr = 1;
-		for (std::string line; std::getline(in, line); pathLineInfo.line = ++lineNr) {
-			boost::algorithm::trim(line);
-			if ( line.empty() ) continue; /* ignore lines with only whitespaces */
-			const boost::filesystem::path inPath(line, pcf::path::utf8);
-			if ( boost::filesystem::exists(inPath) ) {
-				input.push_back(boost::make_shared<PathLiteral>(line, pathLineInfo, StringLiteral::RAW));
-				input
-					.back()
-					->setFlags(PathLiteral::PERMANENT | PathLiteral::EXISTS)
-					.setLastModification(boost::posix_time::from_time_t(boost::filesystem::last_write_time(inPath)));
-			} else {
-				if (this->config.verbosity >= VERBOSITY_WARN) {
-					std::cerr << inputFile.string(pcf::path::utf8) << ':' << lineNr
+		/* split at line breaks into one part per thread */
+		const char * const end = in.data() + in.size();
+		const size_t chunkCount = std::max<size_t>(1, std::min<size_t>(boost::thread::hardware_concurrency(), in.size() / Process::minInputListChunkSize));
+		std::vector<InputListChunk> chunks;
+		chunks.reserve(chunkCount);
+		size_t firstLine = 1;
+		for (const char * start = in.data(); start < end; ) {
+			const char * stop = end;
+			if ((chunks.size() + 1) < chunkCount) {
+				stop = std::find(start + (static_cast<size_t>(end - start) / (chunkCount - chunks.size())), end, '\n');
+				if (stop < end) stop++;
+			}
+			chunks.push_back(InputListChunk(start, stop));
+			chunks.back().firstLine = firstLine;
+			firstLine += static_cast<size_t>(std::count(start, stop, '\n'));
+			start = stop;
+		}
+		/* read parts in parallel */
+		{
+			TaskGroup tasks(chunks.size() > 1 ? ios : NULL);
+			BOOST_FOREACH(InputListChunk & chunk, chunks) {
+				tasks.run(boost::phoenix::bind(&Process::readInputListChunk, this, boost::phoenix::ref(chunk), boost::phoenix::cref(inputFile)));
+			}
+			tasks.wait();
+		}
+		/* merge in list order */
+		BOOST_FOREACH(InputListChunk & chunk, chunks) {
+			if ( chunk.error ) boost::rethrow_exception(chunk.error);
+			if (this->config.verbosity >= VERBOSITY_WARN) {
+				for (size_t i = 0; i < chunk.missing.size(); i++) {
+					std::cerr << inputFile.string(pcf::path::utf8) << ':' << chunk.missing[i].first
 						<< ": Warning: Input file does not exist and will be ignored \""
-						<< inPath.string(pcf::path::utf8) << "\"." << std::endl;
+						<< chunk.missing[i].second << "\"." << std::endl;
 				}
 			}
+			boost::push_back(input, chunk.input);
 		}
 		return true;
 	}
@@ -276,10 +366,12 @@ public:
 	 * @param[in] inRegEx - match files on the file system against this regular expression
 	 * @param[in] li - script location where this regular expression was defined
 	 * @param[in,out] input - add new input files to this output variable
+	 * @param[in] readDir - callback function to read the entries of a directory (optional)
+	 * @param[in,out] ios - I/O service to read directories in parallel on (optional)
 	 * @return true on success, else false
 	 * @see createInitialInputList()
 	 */
-	bool createInitialInputListFromRegEx(const std::string & inRegEx, const LineInfo & li, PathLiteralPtrVector & input) const {
+	bool createInitialInputListFromRegEx(const std::string & inRegEx, const LineInfo & li, PathLiteralPtrVector & input, const pcf::path::ReadDirectoryCallback & readDir = pcf::path::ReadDirectoryCallback(), boost::asio::io_service * ios = NULL) const {
 		std::vector<boost::filesystem::path> pathList;
 		const std::wstring inRegExW(boost::locale::conv::utf_to_utf<wchar_t>(reduceConsecutiveSlashes(inRegEx)));
 		try {
@@ -291,8 +383,12 @@ public:
 #endif /* PCF_IS_WIN */
 			);
 			const RegExNamedCaptureSet namedCaptures = getRegExCaptureNames(inRegEx);
+			std::vector<std::wstring> excludeW;
+			BOOST_FOREACH(const std::string & pattern, this->config.excludePatterns) {
+				excludeW.push_back(boost::locale::conv::utf_to_utf<wchar_t>(pattern));
+			}
 			try {
-				pcf::path::getRegexPathList(pathList, inRegExW, this->config.fullRecursiveMatch);
+				pcf::path::getRegexPathList(pathList, inRegExW, this->config.fullRecursiveMatch, readDir, excludeW, Process::getPostTask(ios));
 			} catch (const boost::regex_error & e) {
 				std::ostringstream sout;
 				sout << li << ": Error: Regular expression '" << inRegEx << "' is invalid.\n" << e.what();
@@ -333,10 +429,11 @@ public:
 							/* ignore unknown captures */
 						}
 					}
+					const FileStatus status(this->config.fileStatus->get(p));
 					input
 						.back()
 						->setFlags(PathLiteral::PERMANENT | PathLiteral::EXISTS)
-						.setLastModification(boost::posix_time::from_time_t(boost::filesystem::last_write_time(p)))
+						.setLastModification(( this->config.contentHash ) ? this->config.contentHashes->getLastChange(p, status) : status.lastChange)
 						.setRegexCaptures(captures);
 				} else if (this->config.verbosity >= VERBOSITY_WARN) {
 					std::cerr << li << ": Warning: Previously found input file ignored after strict mismatch: " << str << std::endl;
@@ -355,6 +452,52 @@ public:
 		return true;
 	}
 	
+	/**
+	 * Creates a list of input files from a given glob pattern. The pattern is matched without
+	 * any regular expression and provides no captures.
+	 * 
+	 * @param[in] inGlob - match files on the file system against this glob pattern
+	 * @param[in] li - script location where this glob pattern was defined
+	 * @param[in,out] input - add new input files to this output variable
+	 * @param[in] readDir - callback function to read the entries of a directory (optional)
+	 * @param[in,out] ios - I/O service to read directories in parallel on (optional)
+	 * @return true on success, else false
+	 * @see createInitialInputList()
+	 * @see pcf::path::getGlobPathList()
+	 */
+	bool createInitialInputListFromGlob(const std::string & inGlob, const LineInfo & li, PathLiteralPtrVector & input, const pcf::path::ReadDirectoryCallback & readDir = pcf::path::ReadDirectoryCallback(), boost::asio::io_service * ios = NULL) const {
+		std::vector<boost::filesystem::path> pathList;
+		const std::wstring inGlobW(boost::locale::conv::utf_to_utf<wchar_t>(reduceConsecutiveSlashes(inGlob)));
+		std::vector<std::wstring> excludeW;
+		BOOST_FOREACH(const std::string & pattern, this->config.excludePatterns) {
+			excludeW.push_back(boost::locale::conv::utf_to_utf<wchar_t>(pattern));
+		}
+		try {
+			pcf::path::getGlobPathList(pathList, inGlobW, readDir, excludeW, Process::getPostTask(ios));
+		} catch (...) {
+			std::ostringstream sout;
+			sout << li << ": Error: Failed to get path list from glob pattern \"" << inGlob << "\".";
+			BOOST_THROW_EXCEPTION(
+				pcf::exception::File()
+				<< pcf::exception::tag::Message(sout.str())
+			);
+			return false;
+		}
+		std::vector<FileStatus> statusList;
+		this->config.fileStatus->get(statusList, pathList);
+		input.reserve(input.size() + pathList.size());
+		for (size_t i = 0; i < pathList.size(); i++) {
+			const boost::filesystem::path & p(pathList[i]);
+			const FileStatus & status(statusList[i]);
+			input.push_back(boost::make_shared<PathLiteral>(pcf::path::correctSeparator(p).string(pcf::path::utf8), this->lineInfo, StringLiteral::RAW));
+			input
+				.back()
+				->setFlags(PathLiteral::PERMANENT | PathLiteral::EXISTS)
+				.setLastModification(( this->config.contentHash ) ? this->config.contentHashes->getLastChange(p, status) : status.lastChange);
+		}
+		return true;
+	}
+	
 	/**
 	 * Creates all transitions from the list of input files using the internal process block
 	 * definitions.
@@ -364,12 +507,131 @@ public:
 	 */
 	bool createDependencyList(PathLiteralPtrVector & input) {
 		bool result = true;
-		BOOST_FOREACH(const ProcessBlock & processBlock, this->processBlocks) {
-			result = result && processBlock.createTransitions(input, this->transitions, this->config);
+		const size_t blockCount = this->processBlocks.size();
+		std::vector<ClassifiedInputVector> classifiedInput(blockCount);
+		/* classify each input file against all input file filters in a single pass */
+		BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & literal, input) {
+			const std::wstring wstr = boost::locale::conv::utf_to_utf<wchar_t>(literal->getString());
+			for (size_t i = 0; i < blockCount; i++) {
+				const ProcessBlock & processBlock = this->processBlocks[i];
+				if (processBlock.getType() == ProcessBlock::NONE) continue;
+				VariableMap captures;
+				if ( processBlock.matchFilter(wstr, captures) ) {
+					classifiedInput[i].push_back(ClassifiedInput(literal, captures));
+				}
+			}
+		}
+		for (size_t i = 0; i < blockCount; i++) {
+			result = result && this->processBlocks[i].createTransitions(classifiedInput[i], this->transitions, this->config);
 		}
 		return result;
 	}
 	
+	/**
+	 * Adds the input and dependency files of all transitions as well as their output files to
+	 * the given sets.
+	 *
+	 * @param[in,out] paths - add input and dependency files here
+	 * @param[in,out] outputs - add output files here
+	 */
+	void addWatchPaths(std::set<boost::filesystem::path> & paths, std::set<boost::filesystem::path> & outputs) const {
+		BOOST_FOREACH(const ProcessTransition & transition, this->transitions) {
+			BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & literal, transition.dependency) {
+				paths.insert(boost::filesystem::path(literal->getString(), pcf::path::utf8));
+			}
+			BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & literal, transition.output) {
+				outputs.insert(boost::filesystem::path(literal->getString(), pcf::path::utf8));
+			}
+		}
+	}
+	
+	/**
+	 * Adds the input and dependency files of all transitions to the given set. The paths are
+	 * normalized to compare them with the paths reported by the file watcher.
+	 *
+	 * @param[in,out] files - add the normalized paths here
+	 * @see FileWatcher::normalizePath()
+	 */
+	void addDependencyFiles(std::set<boost::filesystem::path> & files) const {
+		BOOST_FOREACH(const ProcessTransition & transition, this->transitions) {
+			BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & literal, transition.dependency) {
+				files.insert(FileWatcher::normalizePath(boost::filesystem::path(literal->getString(), pcf::path::utf8)));
+			}
+		}
+	}
+	
+	/**
+	 * Resets the internal execution states to execute the existing transitions again. The build
+	 * flags of the output files are removed and their meta data is read again.
+	 *
+	 * @see updateBuildFlags()
+	 */
+	void resetExecution() {
+		boost::mutex::scoped_lock lock(this->mutex);
+		this->transitionsInQueue = 0;
+		this->state = IDLE;
+		this->processDependents.clear();
+		this->executionScheduler = NULL;
+		this->executionProgress.clear();
+		this->executionNext.clear();
+		BOOST_FOREACH(ProcessTransition & transition, this->transitions) {
+			transition.missingInput.clear();
+			BOOST_FOREACH(Command & command, transition.commands) {
+				command.reset();
+			}
+			BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & output, transition.output) {
+				const FileStatus status(this->config.fileStatus->get(boost::filesystem::path(output->getString(), pcf::path::utf8)));
+				output->removeFlags(PathLiteral::MODIFIED | PathLiteral::FORCED | PathLiteral::EXISTS);
+				if ( status.exists() ) {
+					output
+						->addFlags(PathLiteral::EXISTS)
+						.setLastModification(status.lastChange);
+				}
+			}
+		}
+	}
+	
+	/**
+	 * Updates the build flags of the output files after the given input and dependency files
+	 * changed. Their meta data is read again first. An output file is marked as modified if a
+	 * dependency was modified, changed again or is missing, or if a dependency is newer than the
+	 * output file.
+	 * The processes this one depends on need to be updated first.
+	 *
+	 * @param[in] changed - normalized paths of the changed files
+	 * @see resetExecution()
+	 */
+	void updateBuildFlags(const std::set<boost::filesystem::path> & changed) const {
+		BOOST_FOREACH(const ProcessTransition & transition, this->transitions) {
+			bool needsBuild = false;
+			boost::posix_time::ptime mostRecentChange;
+			BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & literal, transition.dependency) {
+				const boost::filesystem::path path(literal->getString(), pcf::path::utf8);
+				if (( ! changed.empty() ) && changed.find(FileWatcher::normalizePath(path)) != changed.end()) {
+					const FileStatus status(this->config.fileStatus->get(path));
+					const boost::posix_time::ptime newChange(( this->config.contentHash ) ? this->config.contentHashes->getLastChange(path, status) : status.lastChange);
+					if (newChange != literal->getLastModification()) {
+						/* changed after the outputs were built, regardless of the time tolerance */
+						needsBuild = true;
+					}
+					literal->setLastModification(newChange);
+				}
+				if (literal->hasFlags(PathLiteral::MODIFIED) || ( ! (literal->hasFlags(PathLiteral::EXISTS) || literal->hasFlags(PathLiteral::TEMPORARY)) )) {
+					needsBuild = true;
+				}
+				const boost::posix_time::ptime & lastChange(literal->getLastModification());
+				if (( ! lastChange.is_special() ) && (mostRecentChange.is_not_a_date_time() || mostRecentChange < lastChange)) {
+					mostRecentChange = lastChange;
+				}
+			}
+			BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & output, transition.output) {
+				if (needsBuild || (output->hasFlags(PathLiteral::EXISTS) && pathElementWasModified(mostRecentChange, output->getLastModification(), this->config.modificationTolerance))) {
+					output->addFlags(PathLiteral::MODIFIED);
+				}
+			}
+		}
+	}
+	
 	/**
 	 * Create flat dependent map by adding the relations of the internal transitions to the given map.
 	 *
@@ -500,19 +762,179 @@ public:
 	}
 	
 	/**
-	 * Returns the number of defined commands (according to the number of input files) which shall
-	 * be executed for progress visualization.
+	 * Adds the output files of all internal transitions to the given producer map for pipelined
+	 * execution. This also resets the pipeline states of the internal transitions.
 	 *
-	 * @return number of commands to be executed
+	 * @param[in,out] producers - update this map
 	 */
-	boost::uint64_t countCommands() const {
-		boost::uint64_t result = 0;
-		BOOST_FOREACH(const ProcessTransition & transition, this->transitions) {
-			result += static_cast<boost::uint64_t>(transition.commands.size());
+	void addPipelineProducers(ProcessTransitionProducerMap & producers) {
+		this->processDependents.clear();
+		BOOST_FOREACH(ProcessTransition & transition, this->transitions) {
+			transition.pendingInputs = 0;
+			transition.dependents.clear();
+			transition.priority = 0;
+			BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & output, transition.output) {
+				producers[output->getString()] = ProcessTransitionRef(this, &transition);
+			}
+		}
+	}
+	
+	/**
+	 * Links the internal transitions to the transitions producing their input dependencies for
+	 * pipelined execution. Transitions without any produced input dependency wait for all processes
+	 * producing the given process input instead.
+	 *
+	 * @param[in] producers - producer map created by addPipelineProducers()
+	 * @param[in] input - input file list of this process
+	 * @see execute()
+	 */
+	void linkPipelineInputs(const ProcessTransitionProducerMap & producers, const PathLiteralPtrVector & input) {
+		std::set<Process *> upstream;
+		BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & literal, input) {
+			const ProcessTransitionProducerMap::const_iterator producer = producers.find(literal->getString());
+			if (producer != producers.end() && producer->second.first != this) upstream.insert(producer->second.first);
+		}
+		BOOST_FOREACH(ProcessTransition & transition, this->transitions) {
+			BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & literal, transition.dependency) {
+				const ProcessTransitionProducerMap::const_iterator producer = producers.find(literal->getString());
+				if (producer == producers.end() || producer->second.first == this) continue;
+				producer->second.second->dependents.push_back(ProcessTransitionRef(this, &transition));
+				transition.pendingInputs++;
+			}
+			if (transition.pendingInputs == 0) {
+				/* no file based relation; wait for the whole previous processes */
+				BOOST_FOREACH(Process * process, upstream) {
+					process->processDependents.push_back(ProcessTransitionRef(this, &transition));
+					transition.pendingInputs++;
+				}
+			}
+		}
+	}
+	
+	/**
+	 * Updates the execution priorities of the internal transitions for pipelined execution. The
+	 * priority of a transition is its estimated cost plus the highest priority of all transitions
+	 * waiting for it. The transitions waiting for this process are updated first.
+	 *
+	 * @see linkPipelineInputs()
+	 */
+	void updatePipelinePriorities() {
+		if (( ! this->transitions.empty() ) && this->transitions.front().priority > 0) return; /* already updated */
+		boost::uint64_t processDownstream = 0;
+		BOOST_FOREACH(const ProcessTransitionRef & dependent, this->processDependents) {
+			dependent.first->updatePipelinePriorities();
+			processDownstream = std::max(processDownstream, dependent.second->priority);
+		}
+		BOOST_FOREACH(ProcessTransition & transition, this->transitions) {
+			boost::uint64_t downstream = processDownstream;
+			BOOST_FOREACH(const ProcessTransitionRef & dependent, transition.dependents) {
+				dependent.first->updatePipelinePriorities();
+				downstream = std::max(downstream, dependent.second->priority);
+			}
+			transition.priority = downstream + this->getTransitionCost(transition);
+		}
+	}
+	
+	/**
+	 * Updates the execution priorities of the internal transitions for chained execution. The
+	 * priority of a transition is its estimated cost plus the given downstream cost.
+	 *
+	 * @param[in] downstream - estimated cost of the longest path executed after this process
+	 * @return estimated cost of the longest path starting with this process
+	 */
+	boost::uint64_t updatePriorities(const boost::uint64_t downstream) {
+		boost::uint64_t result = downstream;
+		BOOST_FOREACH(ProcessTransition & transition, this->transitions) {
+			transition.priority = downstream + this->getTransitionCost(transition);
+			result = std::max(result, transition.priority);
 		}
 		return result;
 	}
 	
+	/**
+	 * Passes the number of defined commands (according to the number of input files) which shall
+	 * be executed for progress visualization to the given callback. The callback is called once
+	 * per transition together with its estimated runtime.
+	 *
+	 * @param[in] callProgress - callback function called to count the commands to be executed
+	 * @see loadRuntimes()
+	 */
+	void countCommands(const ProgressCallback & callProgress) const {
+		if ( ! callProgress ) return;
+		BOOST_FOREACH(const ProcessTransition & transition, this->transitions) {
+			callProgress(false, static_cast<boost::uint64_t>(transition.commands.size()), transition.estimatedRuntime);
+		}
+	}
+	
+	/**
+	 * Estimates the runtime of the internal transitions from the runtime records of previous
+	 * executions in the given database. Transitions without records are estimated from the
+	 * records of the other transitions of this process. Transitions which do not need to be
+	 * build are estimated with zero.
+	 *
+	 * @param[in,out] db - read runtime records from this database
+	 */
+	void loadRuntimes(Database & db) {
+		RuntimeInformationVector runtimes;
+		boost::uint64_t knownRuntime = 0;
+		boost::uint64_t knownCommands = 0;
+		BOOST_FOREACH(ProcessTransition & transition, this->transitions) {
+			transition.estimatedRuntime = boost::optional<boost::uint64_t>();
+			transition.failedBefore = false;
+			if ( ! this->transitionNeedsBuild(transition) ) {
+				transition.estimatedRuntime = boost::uint64_t(0);
+				continue;
+			}
+			if ( ! db.getRuntimes(runtimes, this->id, Process::getTransitionKey(transition)) ) continue;
+			/* average over the recorded runtimes */
+			boost::uint64_t runtime = 0;
+			BOOST_FOREACH(const RuntimeInformation & record, runtimes) {
+				runtime += static_cast<boost::uint64_t>(record.duration.total_milliseconds());
+			}
+			runtime /= static_cast<boost::uint64_t>(runtimes.size());
+			transition.estimatedRuntime = runtime;
+			transition.failedBefore = (runtimes.front().exitCode != 0);
+			knownRuntime += runtime;
+			knownCommands += static_cast<boost::uint64_t>(transition.commands.size());
+		}
+		if (knownCommands <= 0) return;
+		/* estimate remaining transitions by the average command runtime of this process */
+		BOOST_FOREACH(ProcessTransition & transition, this->transitions) {
+			if ( transition.estimatedRuntime ) continue;
+			transition.estimatedRuntime = (knownRuntime * static_cast<boost::uint64_t>(transition.commands.size())) / knownCommands;
+		}
+	}
+	
+	/**
+	 * Adds the runtime information of the executed transitions to the given list.
+	 *
+	 * @param[in,out] records - add the transition runtime records here
+	 */
+	void addRuntimes(TransitionRuntimeVector & records) const {
+		BOOST_FOREACH(const ProcessTransition & transition, this->transitions) {
+			TransitionRuntime record;
+			RuntimeInformation & runtime(record.runtime);
+			runtime.duration = boost::posix_time::time_duration(0, 0, 0, 0);
+			runtime.exitCode = 0;
+			runtime.outputSize = 0;
+			bool executed = false;
+			BOOST_FOREACH(const Command & command, transition.commands) {
+				boost::posix_time::ptime start, end;
+				command.getTimes(start, end);
+				if (start.is_not_a_date_time() || end.is_not_a_date_time()) break;
+				executed = true;
+				runtime.duration += end - start;
+				runtime.exitCode = command.getExitCode();
+				runtime.outputSize += command.getOutputSize();
+				if (runtime.exitCode != 0) break;
+			}
+			if ( ! executed ) continue;
+			record.process = this->id;
+			record.transition = Process::getTransitionKey(transition);
+			records.push_back(record);
+		}
+	}
+	
 	/**
 	 * Outputs to the command-lines to the given output streams which would be executed.
 	 *
@@ -573,7 +995,7 @@ public:
 				BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & literal, transition.output) {
 					/* we can even check temporary files because this is performed before they are deleted */
 					const std::string str(literal->getString());
-					if ( ! boost::filesystem::exists(boost::filesystem::path(str, pcf::path::utf8)) ) {
+					if ( ! this->config.fileStatus->get(boost::filesystem::path(str, pcf::path::utf8)).exists() ) {
 						out << "\nError: Missing output path: " << str;
 						allOutputsOk = false;
 					}
@@ -600,6 +1022,18 @@ public:
 		out << '}' << std::endl;
 	}
 	
+	/**
+	 * Releases the memory and temporary files used for the command outputs.
+	 * The command results can no longer be printed afterwards.
+	 */
+	void clearOutputs() {
+		BOOST_FOREACH(ProcessTransition & transition, this->transitions) {
+			BOOST_FOREACH(Command & command, transition.commands) {
+				command.clearOutput();
+			}
+		}
+	}
+	
 	/**
 	 * Returns the current process state.
 	 *
@@ -610,17 +1044,21 @@ public:
 	}
 	
 	/**
-	 * Executes all transitions of this process in parallel.
+	 * Executes all transitions of this process in parallel. Transitions which still wait for
+	 * their input dependencies are queued once these become available. Transitions are queued
+	 * by descending priority.
 	 *
-	 * @param[in,out] ioService - reference to the I/O service instance for work dispatching
+	 * @param[in,out] scheduler - reference to the scheduler instance for work dispatching
 	 * @param[in] callProgress - callback function called to show the current progress
 	 * @param[in] callNext - callback function to be executed if all tasks have been done
+	 * @see linkPipelineInputs()
+	 * @see updatePriorities()
 	 */
-	bool execute(boost::asio::io_service & ioService, const ProgressCallback & callProgress, const ExecutionCallback & callNext) {
+	bool execute(Scheduler & scheduler, const ProgressCallback & callProgress, const ExecutionCallback & callNext) {
 		boost::mutex::scoped_lock lock(this->mutex);
 		if (this->transitionsInQueue > 0) return true; /* execution in progress */
 		if (this->state != IDLE) return true; /* execution in progress */
-		if ( ioService.stopped() ) {
+		if ( scheduler.stopped() ) {
 			this->state = FAILED;
 			return true;
 		}
@@ -629,22 +1067,26 @@ public:
 			this->state = FINISHED;
 			this->transitionsInQueue = 0;
 			lock.unlock();
+			this->releaseDependents(this->processDependents);
 			if ( callNext ) callNext();
 			return true;
 		}
 		this->state = RUNNING;
 		this->transitionsInQueue = this->transitions.size();
+		this->executionScheduler = &scheduler;
+		this->executionProgress = callProgress;
+		this->executionNext = callNext;
+		std::vector<ProcessTransition *> ready;
+		ready.reserve(this->transitions.size());
+		BOOST_FOREACH(ProcessTransition & transition, this->transitions) {
+			if (transition.pendingInputs == 0) ready.push_back(&transition);
+		}
+		/* queue transitions on the longest remaining path first */
+		std::stable_sort(ready.begin(), ready.end(), &Process::hasHigherPriority);
 		
 		lock.unlock();
-		BOOST_FOREACH(ProcessTransition & transition, this->transitions) {
-			ioService.post(boost::phoenix::bind(
-				&Process::executeTransition,
-				this,
-				boost::phoenix::ref(ioService),
-				boost::phoenix::ref(transition),
-				callProgress,
-				callNext
-			));
+		BOOST_FOREACH(ProcessTransition * transition, ready) {
+			this->postTransition(*transition);
 		}
 		
 		return true;
@@ -668,7 +1110,7 @@ public:
 				}
 				if ( finishedOk ) {
 					BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & literal, transition.output) {
-						if (flatDependentMap.count(literal) > 0 && boost::filesystem::exists(boost::filesystem::path(literal->getString(), pcf::path::utf8))) {
+						if (flatDependentMap.count(literal) > 0 && this->config.fileStatus->get(boost::filesystem::path(literal->getString(), pcf::path::utf8)).exists()) {
 							BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & dep, transition.dependency) {
 								const std::string str(dep->getString());
 								const boost::filesystem::path path(str, pcf::path::utf8);
@@ -682,30 +1124,27 @@ public:
 	}
 	
 	/**
-	 * Reset marks of the output files in the given database for temporary file deletion.
+	 * Adds the database file information of all output files to the given list. The file flags
+	 * are taken from the output files.
 	 *
-	 * @param[in,out] db - update this database
+	 * @param[in,out] files - add the file information here
 	 */
-	void markOutputFilesInDatabase(Database & db) const {
+	void addOutputFiles(std::vector<FileInformation> & files) const {
 		BOOST_FOREACH(const ProcessTransition & transition, this->transitions) {
 			BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & output, transition.output) {
-				db.updateFile(boost::filesystem::path(output->getString(), pcf::path::utf8), 0);
-			}
-		}
-	}
-	
-	/**
-	 * Marks the output files in the given database for temporary file deletion.
-	 *
-	 * @param[in,out] db - update this database
-	 */
-	void setFlagsInDatabase(Database & db) const {
-		BOOST_FOREACH(const ProcessTransition & transition, this->transitions) {
-			BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & output, transition.output) {
-				const boost::filesystem::path outputPath(output->getString(), pcf::path::utf8);
-				if ( ! db.setFlags(outputPath, static_cast<boost::uint64_t>(output->getFlags())) ) {
-					if (this->config.verbosity >= VERBOSITY_WARN) std::cerr << "Warning: Failed to update database flags for \"" << outputPath << "\"." << std::endl;
+				FileInformation file;
+				file.path = boost::filesystem::path(output->getString(), pcf::path::utf8);
+				const FileStatus status(this->config.fileStatus->get(file.path));
+				if ( status.isRegularFile() ) {
+					file.size = status.size;
+					file.lastChange = status.lastChange;
+				} else {
+					/* output file does not exist */
+					file.size = 0;
+					file.lastChange = boost::posix_time::ptime(boost::gregorian::date(1970, 1, 1));
 				}
+				file.flags = static_cast<boost::uint64_t>(output->getFlags());
+				files.push_back(file);
 			}
 		}
 	}
@@ -734,13 +1173,14 @@ public:
 				BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & output, transition.output) {
 					const std::string outputStr(output->getString());
 					const boost::filesystem::path outputPath(outputStr, pcf::path::utf8);
-					if (boost::filesystem::exists(outputPath) && boost::filesystem::is_regular_file(outputPath)) {
+					if ( this->config.fileStatus->get(outputPath).isRegularFile() ) {
 						out << "deleting \"" << outputStr << "\": ";
 						if ( boost::filesystem::remove(outputPath) ) {
 							out << "ok\n";
 						} else {
 							out << "failed\n";
 						}
+						this->config.fileStatus->invalidate(outputPath);
 					}
 					output->removeFlags(PathLiteral::EXISTS);
 				}
@@ -748,6 +1188,64 @@ public:
 		}
 	}
 private:
+	/**
+	 * Reads the input files of the given part of an input file list. Leading and trailing white
+	 * spaces of each line are removed and empty lines are ignored. Exceptions are passed via
+	 * InputListChunk::error.
+	 *
+	 * @param[in,out] chunk - part to read
+	 * @param[in] inputFile - path of the input file list
+	 */
+	void readInputListChunk(InputListChunk & chunk, const boost::filesystem::path & inputFile) const {
+		try {
+			std::vector<std::string> lines;
+			std::vector<size_t> lineNumbers;
+			std::vector<boost::filesystem::path> paths;
+			size_t lineNr = chunk.firstLine;
+			for (const char * start = chunk.begin; start < chunk.end; lineNr++) {
+				const char * stop = std::find(start, chunk.end, '\n');
+				const char * next = (stop < chunk.end) ? stop + 1 : stop;
+				/* ignore lines with only whitespaces */
+				while (start < stop && isInputListSpace(*start)) start++;
+				while (stop > start && isInputListSpace(*(stop - 1))) stop--;
+				if (start < stop) {
+					lines.push_back(std::string(start, stop));
+					lineNumbers.push_back(lineNr);
+					paths.push_back(boost::filesystem::path(lines.back(), pcf::path::utf8));
+				}
+				start = next;
+			}
+			std::vector<FileStatus> statuses;
+			this->config.fileStatus->get(statuses, paths);
+			LineInfo pathLineInfo(inputFile);
+			chunk.input.reserve(lines.size());
+			for (size_t i = 0; i < lines.size(); i++) {
+				if ( statuses[i].exists() ) {
+					pathLineInfo.line = lineNumbers[i];
+					chunk.input.push_back(boost::make_shared<PathLiteral>(lines[i], pathLineInfo, StringLiteral::RAW));
+					chunk.input
+						.back()
+						->setFlags(PathLiteral::PERMANENT | PathLiteral::EXISTS)
+						.setLastModification(( this->config.contentHash ) ? this->config.contentHashes->getLastChange(paths[i], statuses[i]) : statuses[i].lastChange);
+				} else {
+					chunk.missing.push_back(std::make_pair(lineNumbers[i], paths[i].string(pcf::path::utf8)));
+				}
+			}
+		} catch (...) {
+			chunk.error = boost::current_exception();
+		}
+	}
+	
+	/**
+	 * Checks whether the given character of an input file list is a white space.
+	 *
+	 * @param[in] c - character to check
+	 * @return true if it is a white space, else false
+	 */
+	static bool isInputListSpace(const char c) {
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+	}
+	
 	/**
 	 * Helper method to decide whether a transition needs to be build or not.
 	 *
@@ -807,17 +1305,125 @@ private:
 	}
 
 	/**
-	 * Executes the given transition within the current thread by executing all its commands
-	 * in sequence.
+	 * Returns the estimated cost of the given transition. This is one for the transition itself
+	 * plus its estimated runtime in milliseconds or one for each command if no estimate is
+	 * available. Transitions which failed in the previous execution get an additional cost of
+	 * Process::failedCost to be executed first.
+	 *
+	 * @param[in] transition - estimate the cost of this transition
+	 * @return estimated cost
+	 * @see loadRuntimes()
+	 */
+	boost::uint64_t getTransitionCost(const ProcessTransition & transition) const {
+		if ( ! this->transitionNeedsBuild(transition) ) return 1;
+		boost::uint64_t result = 1;
+		if ( transition.estimatedRuntime ) {
+			result += *(transition.estimatedRuntime);
+		} else {
+			result += static_cast<boost::uint64_t>(transition.commands.size());
+		}
+		if ( transition.failedBefore ) result += Process::failedCost;
+		return result;
+	}
+	
+	/**
+	 * Returns a key which identifies the given transition within this process across executions.
+	 * This is the list of output files or the list of input files if no output file is given.
+	 *
+	 * @param[in] transition - create the key for this transition
+	 * @return transition key
+	 */
+	static std::string getTransitionKey(const ProcessTransition & transition) {
+		std::string result;
+		const PathLiteralPtrVector & files(transition.output.empty() ? transition.input : transition.output);
+		BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & literal, files) {
+			if ( ! result.empty() ) result.push_back('\n');
+			result.append(literal->getString());
+		}
+		return result;
+	}
+	
+	/**
+	 * Returns a callback function which passes tasks to the given I/O service.
+	 *
+	 * @param[in,out] ios - I/O service to pass the tasks to (optional)
+	 * @return callback function or an empty one if no I/O service was given
+	 */
+	static pcf::path::PostTaskCallback getPostTask(boost::asio::io_service * ios) {
+		if (ios == NULL) return pcf::path::PostTaskCallback();
+		return boost::phoenix::bind(&Process::postTask, ios, boost::phoenix::placeholders::arg1);
+	}
+	
+	/**
+	 * Passes the given task to the given I/O service.
+	 *
+	 * @param[in,out] ios - I/O service to pass the task to
+	 * @param[in] task - task to execute
+	 */
+	static void postTask(boost::asio::io_service * ios, const boost::function0<void> & task) {
+		ios->post(task);
+	}
+	
+	/**
+	 * Compares the priority of two transitions.
+	 *
+	 * @param[in] lhs - left hand side
+	 * @param[in] rhs - right hand side
+	 * @return true if lhs has a higher priority than rhs, else false
+	 */
+	static bool hasHigherPriority(const ProcessTransition * lhs, const ProcessTransition * rhs) {
+		return lhs->priority > rhs->priority;
+	}
+	
+	/**
+	 * Queues the given transition for execution with the scheduler passed to execute().
+	 *
+	 * @param[in,out] transition - queue this transition
+	 */
+	void postTransition(ProcessTransition & transition) {
+		this->executionScheduler->post(boost::phoenix::bind(
+			&Process::executeTransition,
+			this,
+			boost::phoenix::ref(transition),
+			boost::phoenix::placeholders::arg1
+		), transition.priority, this->resources);
+	}
+	
+	/**
+	 * Signals the given transition that one of its producers finished. The transition is queued
+	 * for execution if this was the last one it waited for and execute() was already called.
+	 *
+	 * @param[in,out] transition - signal this transition
+	 */
+	void releaseTransition(ProcessTransition & transition) {
+		boost::mutex::scoped_lock lock(this->mutex);
+		if (transition.pendingInputs > 0) transition.pendingInputs--;
+		if (transition.pendingInputs > 0 || this->executionScheduler == NULL) return;
+		lock.unlock();
+		this->postTransition(transition);
+	}
+	
+	/**
+	 * Signals all given transitions that one of their producers finished.
+	 *
+	 * @param[in] dependents - signal these transitions
+	 * @see releaseTransition()
+	 */
+	static void releaseDependents(const ProcessTransitionRefVector & dependents) {
+		BOOST_FOREACH(const ProcessTransitionRef & dependent, dependents) {
+			dependent.first->releaseTransition(*(dependent.second));
+		}
+	}
+	
+	/**
+	 * Executes the given transition by executing all its commands in sequence.
 	 * 
-	 * @param[in,out] ioService - reference to the I/O service instance for work dispatching
 	 * @param[in,out] transition - execute this transition and update its states
-	 * @param[in] callProgress - callback function called to show the current progress
-	 * @param[in] callNext - callback function to be executed if all tasks have been done
+	 * @param[in] slot - execution slot assigned by the scheduler
 	 */
-	void executeTransition(boost::asio::io_service & ioService, ProcessTransition & transition, const ProgressCallback & callProgress, const ExecutionCallback & callNext) {
+	void executeTransition(ProcessTransition & transition, const size_t slot) {
 		/* early out if I/O service was already canceled */
-		if ( ioService.stopped() ) {
+		if ( this->executionScheduler->stopped() ) {
 			boost::mutex::scoped_lock lock(this->mutex);
 			this->state = FAILED;
 			return;
@@ -827,27 +1433,109 @@ private:
 			/* temporaries can only become missing input if they are forced for creation */
 			if (literal->hasFlags(PathLiteral::TEMPORARY) && ( ! literal->hasFlags(PathLiteral::FORCED) )) continue;
 			const std::string str(literal->getString());
-			const boost::filesystem::path path(str, pcf::path::utf8);
-			if ( ! boost::filesystem::exists(path) ) {
+			if ( ! this->config.fileStatus->get(boost::filesystem::path(str, pcf::path::utf8)).exists() ) {
 				transition.missingInput.insert(str);
 			}
 		}
 		if (transition.missingInput.empty() && this->transitionNeedsBuild(transition)) {
 			/* execute substituted/prepared commands */
-			BOOST_FOREACH(Command & command, transition.commands) {
-				if (( ! command.execute(this->config.commandChecking) ) && this->config.commandChecking) {
-					boost::mutex::scoped_lock lock(this->mutex);
-					this->state = FAILED;
-					break;
-				}
+			this->executeCommand(transition, slot, 0);
+		} else {
+			this->finishTransition(transition, slot);
+		}
+	}
+	
+	/**
+	 * Executes the command with the given index of the passed transition. The following
+	 * commands are executed subsequently.
+	 *
+	 * @param[in,out] transition - execute the command of this transition
+	 * @param[in] slot - execution slot assigned by the scheduler
+	 * @param[in] index - index of the command to execute
+	 */
+	void executeCommand(ProcessTransition & transition, const size_t slot, const size_t index) {
+#ifdef PCF_IS_WIN
+		for (size_t i = index; i < transition.commands.size(); i++) {
+			if (( ! transition.commands[i].execute(this->config.commandChecking) ) && this->config.commandChecking) {
+				boost::mutex::scoped_lock lock(this->mutex);
+				this->state = FAILED;
+				break;
 			}
 		}
-		if ( callProgress ) callProgress(true, static_cast<boost::uint64_t>(transition.commands.size()));
+		this->invalidateOutputs(transition);
+		this->finishTransition(transition, slot);
+#else /* not Windows */
+		if (index >= transition.commands.size()) {
+			this->finishTransition(transition, slot);
+			return;
+		}
+		transition.commands[index].executeAsync(
+			this->executionScheduler->getIoService(),
+			slot,
+			this->config.commandChecking,
+			boost::phoenix::bind(
+				&Process::executedCommand,
+				this,
+				boost::phoenix::ref(transition),
+				slot,
+				index,
+				boost::phoenix::placeholders::arg1
+			)
+		);
+#endif /* Windows */
+	}
+	
+	/**
+	 * Called after a command of the given transition has been executed.
+	 *
+	 * @param[in,out] transition - the command of this transition was executed
+	 * @param[in] slot - execution slot assigned by the scheduler
+	 * @param[in] index - index of the executed command
+	 * @param[in] success - true if the command was executed successfully, else false
+	 */
+	void executedCommand(ProcessTransition & transition, const size_t slot, const size_t index, const bool success) {
+		/* the command may have written any output of this transition */
+		this->invalidateOutputs(transition);
+		if (( ! success ) && this->config.commandChecking) {
+			{
+				boost::mutex::scoped_lock lock(this->mutex);
+				this->state = FAILED;
+			}
+			this->finishTransition(transition, slot);
+			return;
+		}
+		this->executeCommand(transition, slot, index + 1);
+	}
+	
+	/**
+	 * Removes the output files of the given transition from the file meta data cache.
+	 *
+	 * @param[in] transition - the commands of this transition were executed
+	 */
+	void invalidateOutputs(const ProcessTransition & transition) const {
+		BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & output, transition.output) {
+			this->config.fileStatus->invalidate(boost::filesystem::path(output->getString(), pcf::path::utf8));
+		}
+	}
+	
+	/**
+	 * Finishes the execution of the given transition by passing on to the dependent transitions,
+	 * releasing the execution slot and calling the finish callback after the last transition.
+	 *
+	 * @param[in,out] transition - the commands of this transition were executed
+	 * @param[in] slot - execution slot assigned by the scheduler
+	 */
+	void finishTransition(ProcessTransition & transition, const size_t slot) {
+		Scheduler & scheduler(*(this->executionScheduler));
+		if ( this->executionProgress ) this->executionProgress(true, static_cast<boost::uint64_t>(transition.commands.size()), transition.estimatedRuntime);
+		/* pass on to dependent transitions */
+		if ( ! scheduler.stopped() ) this->releaseDependents(transition.dependents);
+		scheduler.release(slot);
 		/* execution finished */
 		{
 			boost::mutex::scoped_lock lock(this->mutex);
 			/* early out if I/O service was already canceled */
-			if ( ioService.stopped() ) {
+			if ( scheduler.stopped() ) {
 				if (this->transitionsInQueue > 0) {
 					this->state = FAILED;
 				} else if (this->state != FAILED) {
@@ -858,8 +1546,10 @@ private:
 			if (this->transitionsInQueue > 0) this->transitionsInQueue--;
 			if (this->transitionsInQueue <= 0) {
 				if (this->state != FAILED) this->state = FINISHED;
+				const ExecutionCallback callNext(this->executionNext);
 				lock.unlock();
-				if (callNext ) callNext();
+				this->releaseDependents(this->processDependents);
+				if ( callNext ) callNext();
 			}
 		}
 	}
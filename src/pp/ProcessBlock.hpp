@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2015-2018 Daniel Starke
  * @date 2015-03-22
- * @version 2017-09-20
+ * @version 2026-10-17
  */
 #ifndef __PP_PROCESSBLOCK_HPP__
 #define __PP_PROCESSBLOCK_HPP__
@@ -12,6 +12,8 @@
 #include <cstdlib>
 #include <iostream>
 #include <string>
+#include <utility>
+#include <vector>
 #include <boost/asio.hpp>
 #include <boost/assign/list_of.hpp>
 #include <boost/config/warning_disable.hpp>
@@ -34,6 +36,7 @@
 #include <pcf/path/Utility.hpp>
 #include <pcf/string/Escape.hpp>
 #include "Command.hpp"
+#include "FileStatusCache.hpp"
 #include "Variable.hpp"
 #include "Type.hpp"
 #include "Utility.hpp"
@@ -42,6 +45,12 @@
 namespace pp {
 
 
+/** Input file with the named captures of the input file filter it passed. */
+typedef std::pair<boost::shared_ptr<PathLiteral>, VariableMap> ClassifiedInput;
+/** List of input files with the named captures of the input file filter they passed. */
+typedef std::vector<ClassifiedInput> ClassifiedInputVector;
+
+
 /**
  * Class to describe and handle a single process block.
  */
@@ -68,6 +77,7 @@ private:
 	CommandVector commands; /**< List of commands associated to this process block. */
 	boost::wregex filter; /**< Input file filter as regular expression. */
 	std::string filterStr; /**< Input file filter as string. */
+	RegExNamedCaptureSet filterCaptures; /**< Named captures of the input file filter. */
 	bool invertFilter; /**< Set true to invert the meaning of the filter. */
 public:
 	/** Default constructor. */
@@ -96,6 +106,7 @@ public:
 			| boost::regex_constants::no_except
 		),
 		filterStr(boost::locale::conv::utf_to_utf<char>(f)),
+		filterCaptures(getRegExCaptureNames(filterStr)),
 		invertFilter(false)
 	{}
 	
@@ -120,6 +131,7 @@ public:
 			| boost::regex_constants::no_except
 		),
 		filterStr(boost::locale::conv::utf_to_utf<char>(f)),
+		filterCaptures(getRegExCaptureNames(filterStr)),
 		invertFilter(i)
 	{}
 	
@@ -137,6 +149,7 @@ public:
 		commands(o.commands),
 		filter(o.filter),
 		filterStr(o.filterStr),
+		filterCaptures(o.filterCaptures),
 		invertFilter(o.invertFilter)
 	{}
 	
@@ -156,6 +169,7 @@ public:
 			this->commands = o.commands;
 			this->filter = o.filter;
 			this->filterStr = o.filterStr;
+			this->filterCaptures = o.filterCaptures;
 			this->invertFilter = o.invertFilter;
 		}
 		return *this;
@@ -170,6 +184,15 @@ public:
 		return this->lineInfo;
 	}
 	
+	/**
+	 * Returns the process block type.
+	 *
+	 * @return process block type
+	 */
+	Type getType() const {
+		return this->type;
+	}
+	
 	/**
 	 * Sets the line information where this process block was defined.
 	 * 
@@ -199,6 +222,7 @@ public:
 			| boost::regex_constants::no_except
 		);
 		this->filterStr = boost::locale::conv::utf_to_utf<char>(f);
+		this->filterCaptures = getRegExCaptureNames(this->filterStr);
 		this->invertFilter = i;
 		return *this;
 	}
@@ -249,31 +273,12 @@ public:
 	 */
 	VariableHandler createVariables(const PathLiteralPtrVector & in, boost::posix_time::ptime & mostRecentChange, bool & needBuild) const {
 		PathLiteralPtrVector filteredInput;
-
+		
 		BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & literal, in) {
-			const std::string str = literal->getString();
-			const std::wstring wstr = boost::locale::conv::utf_to_utf<wchar_t>(str);
-			const RegExNamedCaptureSet namedCaptures = getRegExCaptureNames(this->filterStr);
-			boost::wsmatch what;
-			
-			if (boost::regex_match(wstr, what, this->filter) && ( ! this->invertFilter )) {
-				VariableMap captures;
-				/* overwrite previous captures with named captures from the input filter */
-				BOOST_FOREACH(const std::string & tag, namedCaptures) {
-					try {
-						const boost::wssub_match & match(what[tag]);
-						if ( match.matched ) {
-							captures[tag] = pcf::string::escapeCharacters(std::string(match.first, match.second), '\\', "\\\"");
-						}
-					} catch (...) {
-						/* ignore unknown captures */
-					}
-				}
+			VariableMap captures;
+			if ( this->matchFilter(boost::locale::conv::utf_to_utf<wchar_t>(literal->getString()), captures) ) {
 				literal->addRegexCaptures(captures);
 				filteredInput.push_back(literal);
-			} else if ( this->invertFilter ) {
-				literal->addRegexCaptures(VariableMap());
-				filteredInput.push_back(literal);
 			}
 		}
 		
@@ -364,6 +369,33 @@ public:
 		return this->createVariables(in, mostRecentChange, needBuild);
 	}
 	
+	/**
+	 * Checks whether the given input file passes the stored input file filter. The named captures
+	 * of the filter are set in the output variable if the filter is not inverted. An inverted
+	 * filter passes all input files without captures.
+	 *
+	 * @param[in] input - input file path
+	 * @param[out] captures - output variable for the named captures
+	 * @return true if the input file passes the filter, else false
+	 */
+	bool matchFilter(const std::wstring & input, VariableMap & captures) const {
+		if ( this->invertFilter ) return true;
+		boost::wsmatch what;
+		if ( ! boost::regex_match(input, what, this->filter) ) return false;
+		/* overwrite previous captures with named captures from the input filter */
+		BOOST_FOREACH(const std::string & tag, this->filterCaptures) {
+			try {
+				const boost::wssub_match & match(what[tag]);
+				if ( match.matched ) {
+					captures[tag] = pcf::string::escapeCharacters(std::string(match.first, match.second), '\\', "\\\"");
+				}
+			} catch (...) {
+				/* ignore unknown captures */
+			}
+		}
+		return true;
+	}
+	
 	/**
 	 * Creates a list of transitions from the given input file list. The build can be enforced by
 	 * the passed configuration.
@@ -374,6 +406,30 @@ public:
 	 * @return true on success, else false
 	 */
 	bool createTransitions(const PathLiteralPtrVector & input, ProcessTransitionVector & transitions, const Configuration & config) const {
+		ClassifiedInputVector classifiedInput;
+		if (this->type != NONE) {
+			BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & literal, input) {
+				VariableMap captures;
+				if ( this->matchFilter(boost::locale::conv::utf_to_utf<wchar_t>(literal->getString()), captures) ) {
+					classifiedInput.push_back(ClassifiedInput(literal, captures));
+				}
+			}
+		}
+		return this->createTransitions(classifiedInput, transitions, config);
+	}
+	
+	/**
+	 * Creates a list of transitions from the given input file list which has already been
+	 * classified by the stored input file filter. The build can be enforced by the passed
+	 * configuration.
+	 *
+	 * @param[in] input - filtered input file list with the named captures of the filter
+	 * @param[out] transitions - output variable to add the created transitions to
+	 * @param[in] config - set Configuration::build to force build
+	 * @return true on success, else false
+	 * @see matchFilter()
+	 */
+	bool createTransitions(const ClassifiedInputVector & input, ProcessTransitionVector & transitions, const Configuration & config) const {
 		boost::posix_time::ptime mostRecentChange, mostRecentDepChange;
 		bool allNeedsToBeBuild, outputDependsOnAll = false, isFirst;
 		ProcessTransitionVector thisTransitions;
@@ -383,30 +439,9 @@ public:
 		
 		if (this->type != NONE) {
 			/* create filtered input vector */
-			BOOST_FOREACH(const boost::shared_ptr<PathLiteral> & literal, input) {
-				const std::string str = literal->getString();
-				const std::wstring wstr = boost::locale::conv::utf_to_utf<wchar_t>(str);
-				const RegExNamedCaptureSet namedCaptures = getRegExCaptureNames(this->filterStr);
-				boost::wsmatch what;
-				if (boost::regex_match(wstr, what, this->filter) && ( ! this->invertFilter )) {
-					VariableMap captures;
-					/* overwrite previous captures with named captures from the input filter */
-					BOOST_FOREACH(const std::string & tag, namedCaptures) {
-						try {
-							const boost::wssub_match & match(what[tag]);
-							if ( match.matched ) {
-								captures[tag] = pcf::string::escapeCharacters(std::string(match.first, match.second), '\\', "\\\"");
-							}
-						} catch (...) {
-							/* ignore unknown captures */
-						}
-					}
-					literal->addRegexCaptures(captures);
-					filteredInput.push_back(literal);
-				} else if ( this->invertFilter ) {
-					literal->addRegexCaptures(VariableMap());
-					filteredInput.push_back(literal);
-				}
+			BOOST_FOREACH(const ClassifiedInput & classifiedInput, input) {
+				classifiedInput.first->addRegexCaptures(classifiedInput.second);
+				filteredInput.push_back(classifiedInput.first);
 			}
 			
 			vars.addScopes(this->createVariablesUnfiltered(filteredInput, mostRecentChange, allNeedsToBeBuild).getScopes());
@@ -443,7 +478,7 @@ public:
 			BOOST_FOREACH(ProcessTransition & transition, thisTransitions) {
 				vars.addScope();
 				this->setDestinationVariables(vars);
-				this->addAdditionalDependencies(transition.dependency, vars, mostRecentDepChange);
+				this->addAdditionalDependencies(transition.dependency, vars, mostRecentDepChange, config);
 				boost::optional<VariableMap &> destFiles = vars.getCurrentScope();
 				if ( destFiles ) { /* always true here */
 					BOOST_FOREACH(const VariableMap::value_type & variable, *destFiles) {
@@ -453,12 +488,13 @@ public:
 						transition.output.push_back(boost::make_shared<PathLiteral>(variable.second));
 						PathLiteral & output(*(transition.output.back()));
 						/* if output file already exists */
-						if ( boost::filesystem::exists(path) ) {
+						const FileStatus status(config.fileStatus->get(path));
+						if ( status.exists() ) {
 							output
 								.addFlags(PathLiteral::EXISTS)
-								.setLastModification(boost::posix_time::from_time_t(boost::filesystem::last_write_time(path)));
+								.setLastModification(status.lastChange);
 							/* check if additional input dependency was modified */
-							if (( ! mostRecentDepChange.is_not_a_date_time() ) && pathElementWasModified(mostRecentDepChange, output.getLastModification())) {
+							if (( ! mostRecentDepChange.is_not_a_date_time() ) && pathElementWasModified(mostRecentDepChange, output.getLastModification(), config.modificationTolerance)) {
 								if (config.verbosity >= VERBOSITY_DEBUG) {
 									std::cerr << this->lineInfo << ": Input dependency file was modified for target file: " << path.string(pcf::path::utf8) << std::endl;
 								}
@@ -507,7 +543,7 @@ public:
 				vars.set("?", *literal);
 				vars.addScope();
 				this->setDestinationVariables(vars);
-				this->addAdditionalDependencies(transition.dependency, vars, mostRecentDepChange);
+				this->addAdditionalDependencies(transition.dependency, vars, mostRecentDepChange, config);
 				boost::optional<VariableMap &> destFiles = vars.getCurrentScope();
 				if ( destFiles ) { /* always true here */
 					bool needsToBeBuild = false;
@@ -538,18 +574,19 @@ public:
 								output.addFlags(PathLiteral::TEMPORARY);
 							}
 							/* if output file already exists */
-							if ( boost::filesystem::exists(path) ) {
+							const FileStatus status(config.fileStatus->get(path));
+							if ( status.exists() ) {
 								output
 									.addFlags(PathLiteral::EXISTS)
-									.setLastModification(boost::posix_time::from_time_t(boost::filesystem::last_write_time(path)));
-								if (( ! literal->getLastModification().is_not_a_date_time() ) && pathElementWasModified(literal->getLastModification(), output.getLastModification())) {
+									.setLastModification(status.lastChange);
+								if (( ! literal->getLastModification().is_not_a_date_time() ) && pathElementWasModified(literal->getLastModification(), output.getLastModification(), config.modificationTolerance)) {
 									output.addFlags(PathLiteral::MODIFIED);
 									if (config.verbosity >= VERBOSITY_DEBUG) {
 										std::cerr << this->lineInfo << ": Input file \"" << literal->getString() << "\" was modified for target file: " << path.string(pcf::path::utf8) << std::endl;
 									}
 								}
 								/* check if additional input dependency was modified */
-								if (( ! mostRecentDepChange.is_not_a_date_time() ) && pathElementWasModified(mostRecentDepChange, output.getLastModification())) {
+								if (( ! mostRecentDepChange.is_not_a_date_time() ) && pathElementWasModified(mostRecentDepChange, output.getLastModification(), config.modificationTolerance)) {
 									output.addFlags(PathLiteral::MODIFIED);
 									if (config.verbosity >= VERBOSITY_DEBUG) {
 										std::cerr << this->lineInfo << ": Input dependency file was modified for target file: " << path.string(pcf::path::utf8) << std::endl;
@@ -635,9 +672,10 @@ private:
 	 * @param[in,out] vars - add dependency files to the variable handle and use included variables
 	 * to substitute referenced variables
 	 * @param[out] mostRecentChange - output variable for the most recent change as date time
+	 * @param[in] config - query file meta data and content changes via this configuration
 	 * @param[in] variableChecking - enable strong variable checking
 	 */
-	void addAdditionalDependencies(PathLiteralPtrVector & target, VariableHandler & vars, boost::posix_time::ptime & mostRecentChange, const bool variableChecking = true) const {
+	void addAdditionalDependencies(PathLiteralPtrVector & target, VariableHandler & vars, boost::posix_time::ptime & mostRecentChange, const Configuration & config, const bool variableChecking = true) const {
 		BOOST_FOREACH(const PathVariableMap::value_type & variable, this->dependencies) {
 			/* included variable references are automatically replaces */
 			VariableHandler::Checking checking = VariableHandler::CHECKING_WARN;
@@ -646,12 +684,13 @@ private:
 			}
 			target.push_back(boost::make_shared<PathLiteral>(vars.set(variable.first, variable.second, checking)));
 			const std::string depFileStr(target.back()->getString());
-			const boost::filesystem::path path(depFileStr, pcf::path::utf8);
-			if ( boost::filesystem::exists(path) ) {
+			const boost::filesystem::path depFile(depFileStr, pcf::path::utf8);
+			const FileStatus status(config.fileStatus->get(depFile));
+			if ( status.exists() ) {
 				PathLiteral & output(*(target.back()));
 				output
 					.addFlags(PathLiteral::EXISTS)
-					.setLastModification(boost::posix_time::from_time_t(boost::filesystem::last_write_time(path)));
+					.setLastModification(( config.contentHash ) ? config.contentHashes->getLastChange(depFile, status) : status.lastChange);
 				if (mostRecentChange.is_not_a_date_time() || mostRecentChange < output.getLastModification()) {
 					mostRecentChange = output.getLastModification();
 				}
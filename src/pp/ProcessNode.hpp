@@ -3,17 +3,19 @@
  * @author Daniel Starke
  * @copyright Copyright 2015-2018 Daniel Starke
  * @date 2015-03-22
- * @version 2016-12-29
+ * @version 2026-10-17
  */
 #ifndef __PP_PROCESSNODE_HPP__
 #define __PP_PROCESSNODE_HPP__
 
 
+#include <algorithm>
 #include <cstdlib>
 #include <iosfwd>
 #include <string>
 #include <vector>
 #include <boost/config/warning_disable.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/foreach.hpp>
 #include <boost/function.hpp>
 #include <boost/optional.hpp>
@@ -25,6 +27,7 @@
 #undef BOOST_BIND_NO_PLACEHOLDERS
 #include <pcf/exception/General.hpp>
 #include "Process.hpp"
+#include "TaskGroup.hpp"
 #include "Variable.hpp"
 #include "Type.hpp"
 
@@ -219,14 +222,17 @@ public:
 	
 	/**
 	 * Traverses the dependency tree in dependency order (similar to depth-first, post-order) while
-	 * passing the dependencies to each dependent node.
+	 * passing the dependencies to each dependent node. Parallel nodes are traversed in parallel if
+	 * an I/O service is given.
 	 *
 	 * @param[in] callback - visitor
 	 * @param[in] output - variable to fill with the dependencies for the current node
+	 * @param[in,out] ios - optional I/O service to traverse parallel nodes on
 	 * @param[in] level - current dependency level (not needed to set by top level functions)
 	 * @return true on success, false if a visitor returned false, a function failed or no visitor was given
+	 * @remarks The visitor needs to be thread-safe if an I/O service is given.
 	 */
-	bool traverseDependencies(const DependencyCallbackType & callback, PathLiteralPtrVector & output, const size_t level = 0) {
+	bool traverseDependencies(const DependencyCallbackType & callback, PathLiteralPtrVector & output, boost::asio::io_service * ios = NULL, const size_t level = 0) {
 		if ( ! callback ) return false;
 		PathLiteralPtrVector passingDeps;
 		/* call dependency */
@@ -235,7 +241,7 @@ public:
 				/* output of previous dependency is input for next dependency or will be processed afterwards if no further dependency exists */
 				if ( ! passingDeps.empty() ) node.setDependencyInput(passingDeps);
 				passingDeps.clear();
-				if ( ! node.traverseDependencies(callback, passingDeps, level + 1) ) return false;
+				if ( ! node.traverseDependencies(callback, passingDeps, ios, level + 1) ) return false;
 			}
 		}
 		/* call parallel */
@@ -245,13 +251,33 @@ public:
 				node.setDependencyInput(passingDeps);
 			}
 			/* solve dependencies for parallel nodes */
-			if ( this->value ) {
-				BOOST_FOREACH(ProcessNode & node, this->parallel) {
-					if ( ! node.traverseDependencies(callback, this->value->input, level + 1) ) return false;
+			PathLiteralPtrVector & parallelOutput(this->value ? this->value->input : output);
+			if (ios != NULL && this->parallel.size() > 1) {
+				/* parallel nodes are independent; collect their outputs separately to keep the order */
+				std::vector<PathLiteralPtrVector> outputs(this->parallel.size());
+				std::vector<char> results(this->parallel.size(), 0);
+				{
+					TaskGroup tasks(ios);
+					for (size_t i = 0; i < this->parallel.size(); i++) {
+						tasks.run(boost::phoenix::bind(
+							&ProcessNode::traverseDependenciesTask,
+							&(this->parallel[i]),
+							boost::phoenix::cref(callback),
+							boost::phoenix::ref(outputs[i]),
+							ios,
+							level + 1,
+							boost::phoenix::ref(results[i])
+						));
+					}
+					tasks.wait();
+				}
+				for (size_t i = 0; i < this->parallel.size(); i++) {
+					if ( ! results[i] ) return false;
+					boost::push_back(parallelOutput, outputs[i]);
 				}
 			} else {
 				BOOST_FOREACH(ProcessNode & node, this->parallel) {
-					if ( ! node.traverseDependencies(callback, output, level + 1) ) return false;
+					if ( ! node.traverseDependencies(callback, parallelOutput, ios, level + 1) ) return false;
 				}
 			}
 		} else if ( this->value ) {
@@ -309,7 +335,110 @@ public:
 		}
 		return true;
 	}
+	
+	/**
+	 * Passes all process nodes of the dependency tree at once to the given callback. The order
+	 * of execution is left to the links between the process transitions in this case.
+	 *
+	 * @param[in] callback - visitor
+	 * @param[in] callNext - function to execute if all process nodes finished execution
+	 * @return true on success, false if a visitor returned false or no visitor was given
+	 * @see Process::linkPipelineInputs()
+	 */
+	bool executePipelined(const ExecuteNodeCallbackType & callback, const ExecutionCallback & callNext) {
+		if ( ! callback ) return false;
+		std::vector<ValueType *> elements;
+		this->getValues(elements);
+		boost::mutex::scoped_lock lock(this->mutex);
+		/* we need to ensure that finishedPipelined() doesn't finish before we are done queuing all processes */
+		this->parallelInQueue = elements.size() + 1;
+		lock.unlock();
+		BOOST_FOREACH(ValueType * element, elements) {
+			switch (element->process.getState()) {
+			case Process::IDLE:
+				if ( ! callback(*element, boost::phoenix::bind(&ProcessNode::finishedPipelined, this, callNext)) ) return false;
+				break;
+			case Process::RUNNING:
+				break;
+			case Process::FINISHED:
+			case Process::FAILED:
+				this->finishedPipelined(callNext);
+				break;
+			}
+		}
+		this->finishedPipelined(callNext);
+		return true;
+	}
+	
+	/**
+	 * Updates the execution priorities of all processes within this dependency tree according to
+	 * the execution order of executeChain(). Processes executed earlier have a longer remaining
+	 * path and therefore a higher priority.
+	 *
+	 * @param[in] downstream - estimated cost of the longest path executed after this tree
+	 * @return estimated cost of the longest path through this tree
+	 * @see Process::updatePriorities()
+	 */
+	boost::uint64_t updatePriorities(const boost::uint64_t downstream = 0) {
+		boost::uint64_t result = downstream;
+		/* own node is executed last */
+		if ( this->value ) result = this->value->process.updatePriorities(downstream);
+		/* parallel nodes are executed before */
+		const boost::uint64_t parallelDownstream = result;
+		BOOST_FOREACH(ProcessNode & node, this->parallel) {
+			result = std::max(result, node.updatePriorities(parallelDownstream));
+		}
+		/* dependencies are executed in reverse order before */
+		BOOST_FOREACH(ProcessNode & node, this->dependency) {
+			result = node.updatePriorities(result);
+		}
+		return result;
+	}
 private:
+	/**
+	 * Helper function to traverse the dependency tree as parallel task.
+	 *
+	 * @param[in] callback - visitor
+	 * @param[in] output - variable to fill with the dependencies for the current node
+	 * @param[in,out] ios - I/O service to traverse parallel nodes on
+	 * @param[in] level - current dependency level
+	 * @param[out] result - set to true on success, else false
+	 * @see traverseDependencies()
+	 */
+	void traverseDependenciesTask(const DependencyCallbackType & callback, PathLiteralPtrVector & output, boost::asio::io_service * ios, const size_t level, char & result) {
+		result = this->traverseDependencies(callback, output, ios, level) ? 1 : 0;
+	}
+	
+	/**
+	 * Collects the values of all nodes within this dependency tree in dependency order.
+	 *
+	 * @param[in,out] elements - add pointers to the node values to this list
+	 */
+	void getValues(std::vector<ValueType *> & elements) {
+		BOOST_REVERSE_FOREACH(ProcessNode & node, this->dependency) {
+			node.getValues(elements);
+		}
+		BOOST_FOREACH(ProcessNode & node, this->parallel) {
+			node.getValues(elements);
+		}
+		if ( this->value ) elements.push_back(&*(this->value));
+	}
+	
+	/**
+	 * Called after a process has been executed in pipelined mode.
+	 *
+	 * @param[in] callNext - function to call if all process nodes finished execution
+	 * @see executePipelined()
+	 */
+	void finishedPipelined(const ExecutionCallback & callNext) {
+		boost::mutex::scoped_lock lock(this->mutex);
+		if (this->parallelInQueue > 0) this->parallelInQueue--;
+		if (this->parallelInQueue <= 0) {
+			lock.unlock();
+			if ( callNext ) callNext();
+		}
+	}
+	
 	/**
 	 * Sets the dependency files for this node from the given input.
 	 *
@@ -0,0 +1,358 @@
+/**
+ * @file Scheduler.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#ifndef __PP_SCHEDULER_HPP__
+#define __PP_SCHEDULER_HPP__
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <vector>
+#include <boost/foreach.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/asio.hpp>
+#include <boost/config/warning_disable.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/phoenix/bind.hpp>
+#include <boost/phoenix/core.hpp>
+/* workaround for boost::phoenix::bind and boost::bind namespace collision */
+#define BOOST_BIND_NO_PLACEHOLDERS
+#include <boost/thread/thread.hpp>
+#undef BOOST_BIND_NO_PLACEHOLDERS
+#include "Type.hpp"
+
+
+namespace pp {
+
+
+/**
+ * Class to dispatch tasks to an I/O service while limiting the number of concurrently running
+ * tasks to a fixed number of execution slots. A task keeps its slot until it calls release()
+ * which allows tasks to wait asynchronously for external events without blocking a thread.
+ * Tasks waiting for a free slot are dispatched in order of their priority and in order of
+ * their arrival for equal priorities.@n
+ * Tasks may additionally require an amount of named resources. Such a task is only dispatched
+ * if its requirements fit into the remaining resource budgets. The resources of the highest
+ * prioritized waiting task are reserved if they do not fit yet. Waiting tasks with a lower
+ * priority are only dispatched before it if they fit into the budgets without the reserved
+ * resources. Resources without budget are not limited and requirements exceeding the budget
+ * are limited to the budget.@n
+ * The number of slots which may be used at the same time can be lowered at runtime via
+ * setLimit() to adapt to the current system load.
+ */
+class Scheduler : private boost::noncopyable {
+public:
+	/** Task function type. The task is called with the number of its assigned slot. */
+	typedef boost::function1<void, const size_t> TaskType;
+private:
+	/**
+	 * Structure to hold a task waiting for a free slot.
+	 */
+	struct PendingTask {
+		boost::uint64_t priority; /**< Task priority. Higher values are dispatched first. */
+		boost::uint64_t sequence; /**< Arrival sequence number. */
+		TaskType task; /**< Task to execute. */
+		
+		/**
+		 * Constructor.
+		 *
+		 * @param[in] p - task priority
+		 * @param[in] s - arrival sequence number
+		 * @param[in] t - task to execute
+		 */
+		explicit PendingTask(const boost::uint64_t p, const boost::uint64_t s, const TaskType & t):
+			priority(p),
+			sequence(s),
+			task(t)
+		{}
+		
+		/**
+		 * Compares the dispatch order of two pending tasks.
+		 *
+		 * @param[in] o - object to compare with
+		 * @return true if this task is dispatched before the given one, else false
+		 */
+		bool operator< (const PendingTask & o) const {
+			if (this->priority != o.priority) return this->priority > o.priority;
+			return this->sequence < o.sequence;
+		}
+	};
+	
+	/** Map type of waiting tasks by their required resources. Tasks with equal requirements either all fit or none. */
+	typedef std::map< ResourceMap, std::set<PendingTask> > PendingMap;
+	
+	boost::asio::io_service & ioService; /**< Referred I/O service instance. */
+	std::vector<size_t> freeSlots; /**< Numbers of the currently unused slots. */
+	size_t limit; /**< Maximum number of concurrently running tasks. */
+	ResourceMap budgets; /**< Total amount of each limited resource. */
+	ResourceMap available; /**< Remaining amount of each limited resource. */
+	std::vector<ResourceMap> slotResources; /**< Resources held by the task of each slot. */
+	PendingMap pending; /**< Tasks waiting for a free slot grouped by their required resources. */
+	boost::uint64_t sequence; /**< Arrival sequence number for the next pending task. */
+	mutable boost::mutex mutex; /**< Mutex object for parallel execution. */
+public:
+	/**
+	 * Constructor.
+	 *
+	 * @param[in,out] ios - dispatch tasks to this I/O service
+	 * @param[in] slots - maximum number of concurrently running tasks
+	 * @param[in] resources - budgets of the limited resources
+	 */
+	explicit Scheduler(boost::asio::io_service & ios, const size_t slots, const ResourceMap & resources = ResourceMap()):
+		ioService(ios),
+		limit(slots),
+		budgets(resources),
+		available(resources),
+		slotResources(slots + 1),
+		sequence(0)
+	{
+		this->freeSlots.reserve(slots);
+		for (size_t slot = slots; slot > 0; slot--) {
+			this->freeSlots.push_back(slot);
+		}
+	}
+	
+	/**
+	 * Returns the I/O service used for task dispatching.
+	 *
+	 * @return referred I/O service instance
+	 */
+	boost::asio::io_service & getIoService() {
+		return this->ioService;
+	}
+	
+	/**
+	 * Checks whether the underlying I/O service was stopped.
+	 *
+	 * @return true if stopped, else false
+	 */
+	bool stopped() const {
+		return this->ioService.stopped();
+	}
+	
+	/**
+	 * Returns the number of available slots.
+	 *
+	 * @return maximum number of concurrently running tasks
+	 */
+	size_t getSlots() const {
+		return this->slotResources.size() - 1;
+	}
+	
+	/**
+	 * Returns the number of tasks currently holding a slot.
+	 *
+	 * @return number of running tasks
+	 */
+	size_t getRunning() const {
+		boost::mutex::scoped_lock lock(this->mutex);
+		return this->getSlots() - this->freeSlots.size();
+	}
+	
+	/**
+	 * Returns the current limit of concurrently running tasks.
+	 *
+	 * @return number of slots which may be used at the same time
+	 */
+	size_t getLimit() const {
+		boost::mutex::scoped_lock lock(this->mutex);
+		return this->limit;
+	}
+	
+	/**
+	 * Changes the number of slots which may be used at the same time. Running tasks are not
+	 * affected if the limit is lowered. Waiting tasks are dispatched if the limit is raised.
+	 *
+	 * @param[in] value - new limit between 1 and the number of slots
+	 */
+	void setLimit(const size_t value) {
+		std::vector< std::pair<TaskType, size_t> > ready;
+		boost::mutex::scoped_lock lock(this->mutex);
+		this->limit = std::max<size_t>(std::min(value, this->getSlots()), 1);
+		this->collectReady(ready);
+		lock.unlock();
+		this->dispatchAll(ready);
+	}
+	
+	/**
+	 * Queues the given task for execution. The task is dispatched as soon as a slot and the
+	 * required resources are available.
+	 *
+	 * @param[in] task - task to execute
+	 * @param[in] priority - tasks with higher priority are dispatched first
+	 * @param[in] resources - resources required by the task
+	 * @remarks The task needs to call release() with its slot number once it has finished.
+	 */
+	void post(const TaskType & task, const boost::uint64_t priority = 0, const ResourceMap & resources = ResourceMap()) {
+		std::vector< std::pair<TaskType, size_t> > ready;
+		boost::mutex::scoped_lock lock(this->mutex);
+		const ResourceMap required(this->getRequired(resources));
+		if (this->pending.empty() && this->hasFreeSlot() && this->fits(required)) {
+			const size_t slot = this->acquire(required);
+			lock.unlock();
+			this->dispatch(task, slot);
+			return;
+		}
+		/* keep the dispatch order of the already waiting tasks */
+		this->pending[required].insert(PendingTask(priority, this->sequence++, task));
+		this->collectReady(ready);
+		lock.unlock();
+		this->dispatchAll(ready);
+	}
+	
+	/**
+	 * Releases the given slot and its resources and dispatches the next waiting tasks.
+	 *
+	 * @param[in] slot - slot number passed to the finished task
+	 */
+	void release(const size_t slot) {
+		std::vector< std::pair<TaskType, size_t> > ready;
+		boost::mutex::scoped_lock lock(this->mutex);
+		BOOST_FOREACH(const ResourceMap::value_type & resource, this->slotResources[slot]) {
+			this->available[resource.first] += resource.second;
+		}
+		this->slotResources[slot].clear();
+		this->freeSlots.push_back(slot);
+		this->collectReady(ready);
+		lock.unlock();
+		this->dispatchAll(ready);
+	}
+private:
+	/**
+	 * Checks whether a new task may be assigned to a slot. The internal mutex needs to be locked
+	 * by the caller.
+	 *
+	 * @return true if a slot is free and the limit was not reached, else false
+	 */
+	bool hasFreeSlot() const {
+		return ( ! this->freeSlots.empty() ) && (this->getSlots() - this->freeSlots.size()) < this->limit;
+	}
+	
+	/**
+	 * Assigns slots to the waiting tasks which can be dispatched now. The internal mutex needs to
+	 * be locked by the caller. Only the first task of each group of equal resource requirements
+	 * is considered. If the highest prioritized task does not fit, its resources are reserved and
+	 * only tasks which fit besides this reservation are dispatched.
+	 *
+	 * @param[out] ready - append tasks to dispatch and their assigned slots here
+	 */
+	void collectReady(std::vector< std::pair<TaskType, size_t> > & ready) {
+		while (( ! this->pending.empty() ) && this->hasFreeSlot()) {
+			PendingMap::iterator head = this->pending.end();
+			PendingMap::iterator next = this->pending.end();
+			for (PendingMap::iterator it = this->pending.begin(); it != this->pending.end(); ++it) {
+				if (head == this->pending.end() || *(it->second.begin()) < *(head->second.begin())) head = it;
+			}
+			if ( this->fits(head->first) ) {
+				next = head;
+			} else {
+				/* reserve the resources of the blocked head task */
+				for (PendingMap::iterator it = this->pending.begin(); it != this->pending.end(); ++it) {
+					if (it == head || ( ! this->fits(it->first, head->first) )) continue;
+					if (next == this->pending.end() || *(it->second.begin()) < *(next->second.begin())) next = it;
+				}
+				if (next == this->pending.end()) break;
+			}
+			ready.push_back(std::make_pair(next->second.begin()->task, this->acquire(next->first)));
+			next->second.erase(next->second.begin());
+			if ( next->second.empty() ) this->pending.erase(next);
+		}
+	}
+	
+	/**
+	 * Returns the given resource requirements limited to the resources with budget.
+	 *
+	 * @param[in] resources - resource requirements of a task
+	 * @return requirements to account for
+	 */
+	ResourceMap getRequired(const ResourceMap & resources) const {
+		ResourceMap result;
+		BOOST_FOREACH(const ResourceMap::value_type & resource, resources) {
+			const ResourceMap::const_iterator budget = this->budgets.find(resource.first);
+			if (budget == this->budgets.end() || resource.second <= 0) continue;
+			result[resource.first] = std::min(resource.second, budget->second);
+		}
+		return result;
+	}
+	
+	/**
+	 * Checks whether the given resource requirements fit into the remaining budgets.
+	 * The internal mutex needs to be locked by the caller.
+	 *
+	 * @param[in] required - requirements as returned by getRequired()
+	 * @return true if the requirements can be satisfied, else false
+	 */
+	bool fits(const ResourceMap & required) const {
+		return this->fits(required, ResourceMap());
+	}
+	
+	/**
+	 * Checks whether the given resource requirements fit into the remaining budgets without the
+	 * given reserved resources. The internal mutex needs to be locked by the caller.
+	 *
+	 * @param[in] required - requirements as returned by getRequired()
+	 * @param[in] reserved - resources which may not be used
+	 * @return true if the requirements can be satisfied, else false
+	 */
+	bool fits(const ResourceMap & required, const ResourceMap & reserved) const {
+		BOOST_FOREACH(const ResourceMap::value_type & resource, required) {
+			const ResourceMap::const_iterator remaining = this->available.find(resource.first);
+			if (remaining == this->available.end()) return false;
+			const ResourceMap::const_iterator reservation = reserved.find(resource.first);
+			const boost::uint64_t amount = resource.second + ((reservation != reserved.end()) ? reservation->second : 0);
+			if (remaining->second < amount) return false;
+		}
+		return true;
+	}
+	
+	/**
+	 * Assigns a free slot and the given resources to a new task. The internal mutex needs to be
+	 * locked by the caller.
+	 *
+	 * @param[in] required - requirements as returned by getRequired()
+	 * @return assigned slot number
+	 */
+	size_t acquire(const ResourceMap & required) {
+		const size_t slot = this->freeSlots.back();
+		this->freeSlots.pop_back();
+		BOOST_FOREACH(const ResourceMap::value_type & resource, required) {
+			this->available[resource.first] -= resource.second;
+		}
+		this->slotResources[slot] = required;
+		return slot;
+	}
+	
+	/**
+	 * Passes the given task for execution to the I/O service.
+	 *
+	 * @param[in] task - task to execute
+	 * @param[in] slot - assigned slot number
+	 */
+	void dispatch(const TaskType & task, const size_t slot) {
+		this->ioService.post(boost::phoenix::bind(task, slot));
+	}
+	
+	/**
+	 * Passes the given tasks for execution to the I/O service.
+	 *
+	 * @param[in] ready - tasks to execute and their assigned slots
+	 */
+	void dispatchAll(const std::vector< std::pair<TaskType, size_t> > & ready) {
+		for (std::vector< std::pair<TaskType, size_t> >::const_iterator it = ready.begin(); it != ready.end(); ++it) {
+			this->dispatch(it->first, it->second);
+		}
+	}
+};
+
+
+} /* namespace pp */
+
+
+#endif /* __PP_SCHEDULER_HPP__ */
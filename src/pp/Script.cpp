@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2015-2018 Daniel Starke
  * @date 2015-01-24
- * @version 2016-12-28
+ * @version 2026-10-17
  * @remarks May fail to compile with GCC due to a bug for MinGW target within the GC
  * ( https://gcc.gnu.org/bugzilla/show_bug.cgi?id=66488 ).
  */
@@ -263,9 +263,10 @@ bool Script::readInclude(const boost::filesystem::path & path, const boost::file
  * Prepares the script for execution.
  *
  * @param[in] target - target to execute
+ * @param[in,out] scheduler - scheduler whose worker threads are used for preparation
  * @return true on success, else false
  */
-bool Script::prepare(const std::string & target) {
+bool Script::prepare(const std::string & target, Scheduler & scheduler) {
 	using namespace boost::phoenix::placeholders;
 	ExecutionMap::iterator aTarget = this->targets.find(target);
 	if (aTarget == this->targets.end()) {
@@ -283,7 +284,11 @@ bool Script::prepare(const std::string & target) {
 		return false;
 	}
 	this->progress.reset();
-	if ( ! aTarget->second.prepare(boost::phoenix::bind(&Script::progressUpdate, this, _1, _2)) ) {
+	this->estimatedRuntime = 0;
+	this->estimatedTotalRuntime = 0;
+	this->estimatedTotalCommands = 0;
+	this->unestimatedCommands = 0;
+	if ( ! aTarget->second.prepare(scheduler, boost::phoenix::bind(&Script::progressUpdate, this, _1, _2, _3)) ) {
 		return false;
 	}
 	this->progressDateTime = boost::posix_time::microsec_clock::universal_time();
@@ -294,25 +299,58 @@ bool Script::prepare(const std::string & target) {
 
 
 /**
- * Executes the previously read and prepared script on the given I/O service.
+ * Updates the previously prepared script for another execution after the given paths changed.
+ * Script::prepare() needs to be called instead if this fails.
  *
  * @param[in] target - target to execute
- * @param[in,out] ioService - dispatch work on this I/O service
+ * @param[in] changed - normalized paths which changed since the last execution
+ * @param[in,out] scheduler - scheduler whose worker threads are used for preparation
  * @return true on success, else false
+ * @see Execution::update()
  */
-bool Script::execute(const std::string & target, boost::asio::io_service & ioService) {
+bool Script::update(const std::string & target, const std::set<boost::filesystem::path> & changed, Scheduler & scheduler) {
+	using namespace boost::phoenix::placeholders;
+	ExecutionMap::iterator aTarget = this->targets.find(target);
+	if (aTarget == this->targets.end()) {
+		return false;
+	}
+	this->progress.reset();
+	this->estimatedRuntime = 0;
+	this->estimatedTotalRuntime = 0;
+	this->estimatedTotalCommands = 0;
+	this->unestimatedCommands = 0;
+	if ( ! aTarget->second.update(changed, scheduler, boost::phoenix::bind(&Script::progressUpdate, this, _1, _2, _3)) ) {
+		return false;
+	}
+	this->progressDateTime = boost::posix_time::microsec_clock::universal_time();
+	this->progressCount = 0;
+	this->progress.start(0);
+	return true;
+}
+
+
+/**
+ * Executes the previously read and prepared script on the given scheduler.
+ *
+ * @param[in] target - target to execute
+ * @param[in,out] scheduler - dispatch work on this scheduler
+ * @param[in,out] isFirst - set to true before calling this function to handle output formatting
+ * correctly
+ * @return true on success, else false
+ */
+bool Script::execute(const std::string & target, Scheduler & scheduler, bool & isFirst) {
 	using namespace boost::phoenix::placeholders;
 	ExecutionMap::iterator aTarget = this->targets.find(target);
 	if (aTarget == this->targets.end()) {
 		std::cerr << "Error: The target \"" << target << "\" was not defined." << std::endl;
 		std::cerr << "Possible targets: ";
-		bool isFirst = true;
+		bool isFirstTarget = true;
 		BOOST_FOREACH(const ExecutionMap::value_type t, this->targets) {
-			if ( ! isFirst ) {
+			if ( ! isFirstTarget ) {
 				std::cerr << ", ";
 			}
 			std::cerr << t.first;
-			isFirst = false;
+			isFirstTarget = false;
 		}
 		std::cerr << std::endl;
 		return false;
@@ -321,9 +359,10 @@ bool Script::execute(const std::string & target, boost::asio::io_service & ioSer
 		std::cout << "Executing target \"" << target << "\"." << std::endl;
 	}
 	aTarget->second.execute(
-		ioService,
-		boost::phoenix::bind(&Script::progressUpdate, this, _1, _2),
-		boost::phoenix::bind(&Script::finishedTarget, this, target)
+		scheduler,
+		boost::phoenix::bind(&Script::progressUpdate, this, _1, _2, _3),
+		boost::phoenix::bind(&Script::finishedTarget, this, target),
+		isFirst
 	);
 	return true;
 }
@@ -347,6 +386,26 @@ bool Script::complete(const std::string & target, bool & isFirst) {
 }
 
 
+/**
+ * Collects the paths which affect the result of the given target. This needs to be called after
+ * Script::prepare().
+ *
+ * @param[in] target - target to query
+ * @param[in,out] paths - add the paths to watch for changes here
+ * @param[in,out] outputs - add the output files of the target here
+ * @return true on success, else false
+ * @see Execution::getWatchPaths()
+ */
+bool Script::getWatchPaths(const std::string & target, std::set<boost::filesystem::path> & paths, std::set<boost::filesystem::path> & outputs) {
+	ExecutionMap::iterator aTarget = this->targets.find(target);
+	if (aTarget == this->targets.end()) {
+		return false;
+	}
+	aTarget->second.getWatchPaths(paths, outputs);
+	return true;
+}
+
+
 /**
  * Returns the currently configured verbosity level.
  *
@@ -430,24 +489,48 @@ Script & Script::setProgressFormat(const std::string & format) {
 
 
 /**
- * Callback function called to update the current progress.
+ * Callback function called to update the current progress. The ETA is calculated from the given
+ * runtime estimates if available. Commands without estimate are estimated with the average
+ * command runtime of all estimated commands in this case.
  *
  * @param[in] addToCurrent - true if the total counter shall be updated, false to update the current
  * state
  * @param[in] commands - number of commands processed
+ * @param[in] estimate - estimated runtime of the processed commands in milliseconds (if available)
  */
-void Script::progressUpdate(const bool addToCurrent, const boost::uint64_t commands) {
+void Script::progressUpdate(const bool addToCurrent, const boost::uint64_t commands, const boost::optional<boost::uint64_t> & estimate) {
 	boost::mutex::scoped_lock lock(this->mutex);
 	const boost::posix_time::ptime dateTime = boost::posix_time::microsec_clock::universal_time();
 	if ( ! addToCurrent ) {
 		/* count total */
 		this->progress.addTotal(commands);
+		if ( ! estimate ) {
+			this->unestimatedCommands += commands;
+		} else if (*estimate > 0) {
+			this->estimatedRuntime += *estimate;
+			this->estimatedTotalRuntime += *estimate;
+			this->estimatedTotalCommands += commands;
+		}
 	} else {
 		this->progressCount += commands;
+		if ( ! estimate ) {
+			this->unestimatedCommands -= std::min(this->unestimatedCommands, commands);
+		} else {
+			this->estimatedRuntime -= std::min(this->estimatedRuntime, *estimate);
+		}
 		/* update every second at most */
 		if ((dateTime - this->progressDateTime) >= boost::posix_time::seconds(1)
 			|| (this->progress.getCurrent() + this->progressCount) >= this->progress.getTotal()) {
 			this->progress.add(this->progressCount, dateTime);
+			if (this->unestimatedCommands <= 0 || this->estimatedTotalCommands > 0) {
+				boost::uint64_t remaining = this->estimatedRuntime;
+				if (this->unestimatedCommands > 0) {
+					remaining += (this->unestimatedCommands * this->estimatedTotalRuntime) / this->estimatedTotalCommands;
+				}
+				this->progress.setEstimate(boost::posix_time::milliseconds(static_cast<boost::int64_t>(remaining / this->progressJobs)));
+			} else {
+				this->progress.setEstimate(boost::optional<boost::posix_time::time_duration>());
+			}
 			if ( progressOutput ) {
 				(*progressOutput) << this->progress.format(this->progressFormat.c_str(), "command", "commands");
 				progressOutput->flush();
@@ -4,7 +4,7 @@
  * @copyright Copyright 2015-2018 Daniel Starke
  * @copyright Copyright 2015-2016 Daniel Starke
  * @date 2015-01-24
- * @version 2016-12-30
+ * @version 2026-10-17
  *
  * Data hierarchy:@n
  * - Execution
@@ -26,17 +26,32 @@
  *     - ProcessNode::traverseTopDown()      -> Execution::createTemporaryOutputFileInfoMap()
  *     - updateTemporaryCreationFlags()
  *     - ProcessNode::traverseBottomUp()     -> Execution::propagateForcedFlag()
+ *     - ProcessNode::traverseBottomUp()     -> Execution::loadRuntimes()
+ *     - ProcessNode::traverseBottomUp()     -> Execution::countCommands()
+ * - Script::update() (watch mode, instead of Script::prepare() if possible)
+ *   - Execution::update()
+ *     - ProcessNode::traverseTopDown()      -> Execution::addInputLists()
+ *     - ProcessNode::traverseTopDown()      -> Execution::addDependencyFiles()
+ *     - ProcessNode::traverseBottomUp()     -> Execution::updateProcessNode()
+ *     - ProcessNode::traverseBottomUp()     -> Execution::createFlatDependentMap()
+ *     - ProcessNode::traverseBottomUp()     -> Execution::loadRuntimes()
  *     - ProcessNode::traverseBottomUp()     -> Execution::countCommands()
  * - Script::execute()
  *   - Execution::execute()
  *     - ProcessNode::traverseBottomUp()     -> Execution::printCallback()
- *     - ProcessNode::executeChain()         -> Execution::executeProcess() -> Execution::finished() -> Script::finishedTarget()
+ *     - ProcessNode::updatePriorities()     -> Process::updatePriorities()
+ *     - ProcessNode::executeChain()         -> Execution::executeProcess() -> Execution::finishedProcess() -> Execution::finished() -> Script::finishedTarget()
+ *     - ProcessNode::traverseBottomUp()     -> Execution::addPipelineProducers() (pipelined execution only)
+ *     - ProcessNode::traverseBottomUp()     -> Execution::linkPipelineInputs() (pipelined execution only)
+ *     - ProcessNode::traverseBottomUp()     -> Execution::updatePipelinePriorities() (pipelined execution only)
+ *     - ProcessNode::executePipelined()     -> Execution::executeProcess() -> Execution::finishedProcess() -> Execution::finished() -> Script::finishedTarget()
  * - Script::complete()
  *   - Execution::complete()
  *     - ProcessNode::traverseBottomUp()     -> Execution::logCallback()
  *     - ProcessNode::traverseBottomUp()     -> Execution::updateFlatDependentMap()
  *     - delete temporaries
- *     - ProcessNode::traverseBottomUp()     -> Execution::setFlagsInDatabase()
+ *     - ProcessNode::traverseBottomUp()     -> Execution::addRuntimes()
+ *     - ProcessNode::traverseBottomUp()     -> Execution::addOutputFiles()
  */
 #ifndef __PP_SCRIPT_HPP__
 #define __PP_SCRIPT_HPP__
@@ -79,6 +94,7 @@
 #include <pcf/path/Utility.hpp>
 #include <pcf/time/Utility.hpp>
 #include "Execution.hpp"
+#include "Scheduler.hpp"
 #include "Variable.hpp"
 #include "Type.hpp"
 
@@ -113,6 +129,11 @@ private:
 	pcf::time::ProgressClock progress; /**< Instance of a progress output generator. */
 	boost::posix_time::ptime progressDateTime; /**< Start date time of target execution. */
 	boost::uint64_t progressCount; /**< Number of progressed files. */
+	size_t progressJobs; /**< Number of commands executed in parallel. */
+	boost::uint64_t estimatedRuntime; /**< Estimated runtime of the remaining commands with runtime estimate in milliseconds. */
+	boost::uint64_t estimatedTotalRuntime; /**< Estimated runtime of all commands with runtime estimate in milliseconds. */
+	boost::uint64_t estimatedTotalCommands; /**< Number of all commands with runtime estimate. */
+	boost::uint64_t unestimatedCommands; /**< Number of remaining commands without runtime estimate. */
 	mutable boost::mutex mutex; /**< Mutex object for parallel execution. */
 public:
 	/**
@@ -128,7 +149,8 @@ public:
 		initialConfig(c),
 		environment(),
 		vars(vh),
-		progress(0, (jobs > 3) ? jobs : 3) /* progress average over the last jobs commands */
+		progress(0, (jobs > 3) ? jobs : 3), /* progress average over the last jobs commands */
+		progressJobs((jobs > 1) ? jobs : 1)
 	{
 		this->vars.addDynamicVariable("?");
 		this->vars.addDynamicVariable("*");
@@ -188,9 +210,11 @@ public:
 	
 	void reset();
 	bool read(const boost::filesystem::path & path);
-	bool prepare(const std::string & target);
-	bool execute(const std::string & target, boost::asio::io_service & ioService);
+	bool prepare(const std::string & target, Scheduler & scheduler);
+	bool update(const std::string & target, const std::set<boost::filesystem::path> & changed, Scheduler & scheduler);
+	bool execute(const std::string & target, Scheduler & scheduler, bool & isFirst);
 	bool complete(const std::string & target, bool & isFirst);
+	bool getWatchPaths(const std::string & target, std::set<boost::filesystem::path> & paths, std::set<boost::filesystem::path> & outputs);
 	
 	Verbosity getVerbosity() const;
 	
@@ -201,7 +225,7 @@ public:
 private:
 	bool readImport(const boost::filesystem::path & path, const boost::filesystem::path & sourceFile = boost::filesystem::path());
 	bool readInclude(const boost::filesystem::path & path, const boost::filesystem::path & sourceFile = boost::filesystem::path());
-	void progressUpdate(const bool addToCurrent, const boost::uint64_t commands);
+	void progressUpdate(const bool addToCurrent, const boost::uint64_t commands, const boost::optional<boost::uint64_t> & estimate);
 	void finishedTarget(const std::string & target) const;
 };
 
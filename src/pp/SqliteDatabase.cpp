@@ -0,0 +1,1124 @@
+/**
+ * @file SqliteDatabase.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2015-2018 Daniel Starke
+ * @date 2015-10-01
+ * @version 2026-10-17
+ * @remarks This implementation requires SQLite3 to be build with SQLITE_ENABLE_UPDATE_DELETE_LIMIT.
+ */
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+#include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/utility.hpp>
+#include <pcf/exception/General.hpp>
+#include <pcf/os/Target.hpp>
+#include <pcf/path/Utility.hpp>
+#include "SqliteDatabase.hpp"
+
+
+namespace pp {
+
+
+namespace {
+
+
+/**
+ * Local helper function to convert a given directory path into its database representation
+ * which always ends with a slash.
+ *
+ * @param[in] directory - directory path to convert
+ * @return database representation of the directory path
+ */
+static std::string convertDirectory(const boost::filesystem::path & directory) {
+	std::string result(pcf::path::normalize(directory, true).generic_string(pcf::path::utf8));
+	if (result.empty() || result[result.size() - 1] != '/') result.push_back('/');
+	return result;
+}
+
+
+/**
+ * Internal structure with a read-only database connection and its prepared SQL statements.
+ * Read connections are only used by a single thread at a time.
+ */
+struct ReadConnection : private boost::noncopyable {
+	pcf::data::SQLite3 database; /**< SQLite3 database handle. */
+	bool initializedDatabase; /**< True if the database connection was already initialized, else false. */
+	pcf::data::SQLite3::Statement & getFile; /**< Get file information from directory path and file name. */
+	pcf::data::SQLite3::Statement & getRuntimes; /**< Get transition runtime records starting with the most recent one. */
+	pcf::data::SQLite3::Statement & getListing; /**< Get directory listing by path. */
+	/**
+	 * Constructor.
+	 * 
+	 * @param[in] db - path to database
+	 */
+	explicit ReadConnection(const boost::filesystem::path & db) :
+		database(db),
+		/* initialize connection before preparing needed SQL statements */
+		initializedDatabase(this->initConnection()),
+		/* prepared statements */
+		getFile    (this->database.prepare("SELECT file.size, file.lastModified, file.flags FROM file JOIN directory ON directory.id == file.path WHERE directory.path = ? AND file.file = ? LIMIT 1")),
+		getRuntimes(this->database.prepare("SELECT duration, exitCode, outputSize FROM runtime WHERE process = ? AND transition = ? ORDER BY id DESC")),
+		getListing (this->database.prepare("SELECT inode, modified, changed, entries FROM listing WHERE path = ? LIMIT 1"))
+	{}
+	
+	/**
+	 * Ends all pending reads to release the database snapshot of this connection.
+	 */
+	void reset() {
+		this->getFile.reset();
+		this->getRuntimes.reset();
+		this->getListing.reset();
+	}
+private:
+	/**
+	 * Initialize the connection modes.
+	 */
+	bool initConnection() {
+		if ( ! (this->database.query("PRAGMA query_only = ON") && this->database.query("PRAGMA busy_timeout = 10000")) ) {
+			BOOST_THROW_EXCEPTION(
+				pcf::exception::Database()
+				<< pcf::exception::tag::Message("Failed to set up read connection for the database.")
+			);
+			return false;
+		}
+		return true;
+	}
+};
+
+
+} /* namespace */
+
+
+/**
+ * Internal structure with a database handle with its prepared SQL statements.
+ * All writes go through this single connection. Lookups use a pool of read-only connections.
+ */
+struct SqliteDatabase::Handle {
+	mutable boost::mutex mutex; /**< Database access mutex. */
+	pcf::data::SQLite3 database; /**< SQLite3 database handle. */
+	boost::filesystem::path path; /**< Path to the database for additional read connections. */
+	std::vector< boost::shared_ptr<ReadConnection> > idleReaders; /**< Read connections not in use. */
+	size_t readers; /**< Number of opened read connections. */
+	boost::mutex readerMutex; /**< Mutex object for the read connection pool. */
+	boost::condition_variable readerReleased; /**< Signaled if a read connection was released. */
+	bool initializedDatabase; /**< True if the database was already initialized, else false. */
+	/** Map type of directory database indices by path as passed. */
+	typedef std::map<boost::filesystem::path::string_type, int> DirectoryIdMap;
+	DirectoryIdMap directoryIds; /**< Known directory database indices. Cleared whenever directories are deleted or a transaction is rolled back. */
+	pcf::data::SQLite3::Statement & updateFile; /**< Insert/update file. */
+	pcf::data::SQLite3::Statement & setFileFlags; /**< Set specific flags for single file by path. */
+	pcf::data::SQLite3::Statement & setAllFileFlags; /**< Set specific flags for all files. */
+	pcf::data::SQLite3::Statement & addFileFlags; /**< Add specific file flags for single file by path. */
+	pcf::data::SQLite3::Statement & deleteFile; /**< Delete single file by path. */
+	pcf::data::SQLite3::Statement & getAllFiles; /**< Returns a list of all files. */
+	pcf::data::SQLite3::Statement & getFilesByFlag; /**< Returns a list of files with a specific flag set. */
+	pcf::data::SQLite3::Statement & deleteFilesByFlag; /**< Delete all file with a specific flag set. */
+	pcf::data::SQLite3::Statement & deleteUnusedDirectories; /**< Delete unreferenced directory paths. */
+	pcf::data::SQLite3::Statement & deleteAllDirectories; /**< Delete all directory and file entries (propagated). */
+	pcf::data::SQLite3::Statement & deleteAllFiles; /**< Delete all file entries. */
+	pcf::data::SQLite3::Statement & getDirectoryId; /**< Get directory index by path. */
+	pcf::data::SQLite3::Statement & addDirectory; /**< Add single directory by path. */
+	pcf::data::SQLite3::Statement & addRuntime; /**< Add single transition runtime record. */
+	pcf::data::SQLite3::Statement & deleteOldRuntimes; /**< Delete all but the most recent runtime records of each transition. */
+	pcf::data::SQLite3::Statement & deleteAllRuntimes; /**< Delete all transition runtime records. */
+	pcf::data::SQLite3::Statement & updateListing; /**< Insert/update directory listing. */
+	pcf::data::SQLite3::Statement & deleteAllListings; /**< Delete all directory listings. */
+	pcf::data::SQLite3::Statement & getHashes; /**< Get all content hash records. */
+	pcf::data::SQLite3::Statement & updateHash; /**< Insert/update content hash record. */
+	pcf::data::SQLite3::Statement & deleteHash; /**< Delete single content hash record by path. */
+	pcf::data::SQLite3::Statement & deleteHashesByFlag; /**< Delete the content hash records of all files with a specific flag set. */
+	pcf::data::SQLite3::Statement & deleteAllHashes; /**< Delete all content hash records. */
+	/**
+	 * Constructor.
+	 * 
+	 * @param[in] db - path to database
+	 */
+	Handle(const boost::filesystem::path & db) :
+		database(db),
+		path(db),
+		readers(0),
+		/* initialize database before preparing needed SQL statements */
+		initializedDatabase(this->initDatabase()),
+		/* prepared statements */
+		updateFile             (this->database.prepare("INSERT OR REPLACE INTO file (path, file, size, lastModified, flags) VALUES (?, ?, ?, ?, ?)")),
+		setFileFlags           (this->database.prepare("UPDATE OR FAIL file SET flags = ? WHERE path = ? AND file = ? LIMIT 1")),
+		setAllFileFlags        (this->database.prepare("UPDATE OR FAIL file SET flags = ?")),
+		addFileFlags           (this->database.prepare("UPDATE OR FAIL file SET flags = (flags | ?) WHERE path = ? AND file = ? LIMIT 1")),
+		deleteFile             (this->database.prepare("DELETE FROM file WHERE path = ? AND file = ?")),
+		getAllFiles            (this->database.prepare("SELECT (directory.path || file.file) AS path, file.size, file.lastModified, file.flags FROM file JOIN directory ON directory.id == file.path")),
+		getFilesByFlag         (this->database.prepare("SELECT (directory.path || file.file) AS path, file.size, file.lastModified, file.flags FROM file JOIN directory ON directory.id == file.path WHERE ((?001 == 0 AND flags == 0) OR (?001 != 0 AND (flags & ?001) == ?001))")),
+		deleteFilesByFlag      (this->database.prepare("DELETE FROM file WHERE ((?001 == 0 AND flags == 0) OR (?001 != 0 AND (flags & ?001) == ?001))")),
+		deleteUnusedDirectories(this->database.prepare("DELETE FROM directory WHERE id NOT IN (SELECT path FROM file)")),
+		deleteAllDirectories   (this->database.prepare("DELETE FROM directory")),
+		deleteAllFiles         (this->database.prepare("DELETE FROM file")),
+		getDirectoryId         (this->database.prepare("SELECT id FROM directory WHERE path = ? LIMIT 1")),
+		addDirectory           (this->database.prepare("INSERT INTO directory (path) VALUES (?)")),
+		addRuntime             (this->database.prepare("INSERT INTO runtime (process, transition, duration, exitCode, outputSize) VALUES (?, ?, ?, ?, ?)")),
+		deleteOldRuntimes      (this->database.prepare("DELETE FROM runtime WHERE (SELECT COUNT(*) FROM runtime AS newer WHERE newer.process = runtime.process AND newer.transition = runtime.transition AND newer.id > runtime.id) >= ?")),
+		deleteAllRuntimes      (this->database.prepare("DELETE FROM runtime")),
+		updateListing          (this->database.prepare("INSERT OR REPLACE INTO listing (path, inode, modified, changed, entries) VALUES (?, ?, ?, ?, ?)")),
+		deleteAllListings      (this->database.prepare("DELETE FROM listing")),
+		getHashes              (this->database.prepare("SELECT path, size, lastModified, contentChanged, hash FROM hash")),
+		updateHash             (this->database.prepare("INSERT OR REPLACE INTO hash (path, size, lastModified, contentChanged, hash) VALUES (?, ?, ?, ?, ?)")),
+		deleteHash             (this->database.prepare("DELETE FROM hash WHERE path = ?")),
+		deleteHashesByFlag     (this->database.prepare("DELETE FROM hash WHERE path IN (SELECT (directory.path || file.file) FROM file JOIN directory ON directory.id == file.path WHERE ((?001 == 0 AND flags == 0) OR (?001 != 0 AND (flags & ?001) == ?001)))")),
+		deleteAllHashes        (this->database.prepare("DELETE FROM hash"))
+	{};
+	
+	/**
+	 * Helper class to use a read connection of the pool within the current scope.
+	 */
+	class ScopedReader : private boost::noncopyable {
+	private:
+		Handle & handle; /**< Owner of the read connection pool. */
+		boost::shared_ptr<ReadConnection> reader; /**< Acquired read connection. */
+	public:
+		/**
+		 * Constructor. Waits until a read connection is available.
+		 *
+		 * @param[in,out] h - acquire a read connection from this handle
+		 */
+		explicit ScopedReader(Handle & h):
+			handle(h),
+			reader(h.acquireReader())
+		{}
+		
+		/**
+		 * Destructor. Returns the read connection to the pool.
+		 */
+		~ScopedReader() {
+			this->handle.releaseReader(this->reader);
+		}
+		
+		/**
+		 * Returns the acquired read connection.
+		 *
+		 * @return read connection
+		 */
+		ReadConnection & operator* () const {
+			return *(this->reader);
+		}
+		
+		/**
+		 * Returns the acquired read connection.
+		 *
+		 * @return read connection
+		 */
+		ReadConnection * operator-> () const {
+			return this->reader.get();
+		}
+	};
+	
+	/**
+	 * Helper class to end a transaction at the end of the current scope. A rollback is performed
+	 * unless commit() was called. The known directory indices are dropped on rollback as they may
+	 * refer to directories which were added within the transaction.
+	 */
+	class ScopedTransaction : private boost::noncopyable {
+	private:
+		Handle & handle; /**< Database handle of the transaction. */
+		bool doCommit; /**< True if the transaction shall be committed. */
+		pcf::data::SQLite3::ScopedRollback transaction; /**< Underlying transaction. */
+	public:
+		/**
+		 * Constructor. Begins a new transaction.
+		 *
+		 * @param[in,out] h - begin the transaction on this handle
+		 */
+		explicit ScopedTransaction(Handle & h):
+			handle(h),
+			doCommit(false),
+			transaction(h.database)
+		{}
+		
+		/**
+		 * Destructor. Drops the known directory indices if no commit was requested.
+		 */
+		~ScopedTransaction() {
+			if ( ! this->doCommit ) this->handle.directoryIds.clear();
+		}
+		
+		/**
+		 * Perform commit on scope exit.
+		 */
+		void commit() {
+			this->doCommit = true;
+			this->transaction.commit();
+		}
+	};
+	
+	/**
+	 * Returns an idle read connection of the pool. A new one is opened if none is idle and
+	 * the maximum number of read connections was not reached yet.
+	 *
+	 * @return read connection
+	 */
+	boost::shared_ptr<ReadConnection> acquireReader() {
+		boost::mutex::scoped_lock lock(this->readerMutex);
+		while (this->idleReaders.empty() && this->readers >= SqliteDatabase::maxReadConnections) {
+			this->readerReleased.wait(lock);
+		}
+		if ( ! this->idleReaders.empty() ) {
+			const boost::shared_ptr<ReadConnection> result(this->idleReaders.back());
+			this->idleReaders.pop_back();
+			return result;
+		}
+		this->readers++;
+		lock.unlock();
+		try {
+			return boost::make_shared<ReadConnection>(this->path);
+		} catch (...) {
+			lock.lock();
+			this->readers--;
+			this->readerReleased.notify_one();
+			throw;
+		}
+	}
+	
+	/**
+	 * Returns the given read connection to the pool.
+	 *
+	 * @param[in] reader - read connection to return
+	 */
+	void releaseReader(const boost::shared_ptr<ReadConnection> & reader) {
+		reader->reset();
+		boost::mutex::scoped_lock lock(this->readerMutex);
+		this->idleReaders.push_back(reader);
+		this->readerReleased.notify_one();
+	}
+private:
+	/**
+	 * Initialize the database structure as needed.
+	 */
+	bool initDatabase() {
+		/* version and type of the database */
+		const int databaseVersion(2);
+		const std::string databaseType("parallelProcessor");
+		/* helper variables */
+		bool result;
+		bool hasPreferenceTable = false;
+		bool needsDatabaseRecreation = false;
+		std::string prefKey;
+		boost::mutex::scoped_lock lock(this->mutex);
+		/* set database modes */
+		result = this->database.query("PRAGMA foreign_keys = ON");
+		if ( ! result ) {
+			BOOST_THROW_EXCEPTION(
+				pcf::exception::Database()
+				<< pcf::exception::tag::Message("Failed to enforce foreign key constraints in database.")
+			);
+			return false;
+		}
+		result = this->database.query(std::string("PRAGMA synchronous = OFF"));
+		if ( ! result ) {
+			BOOST_THROW_EXCEPTION(
+				pcf::exception::Database()
+				<< pcf::exception::tag::Message("Failed to disable synchronous transaction mode for the database.")
+			);
+			return false;
+		}
+		/* write-ahead logging lets the read connections proceed while writing */
+		result = this->database.query(std::string("PRAGMA journal_mode = WAL"));
+		if ( ! result ) {
+			BOOST_THROW_EXCEPTION(
+				pcf::exception::Database()
+				<< pcf::exception::tag::Message("Failed to set journal mode to write-ahead logging for the database.")
+			);
+			return false;
+		}
+		/* add database tables */
+		/* preference table */
+		if ( this->database.query("SELECT 1 FROM preference LIMIT 1") ) {
+			hasPreferenceTable = true;
+		} else {
+			result = this->database.query(
+				"CREATE TABLE IF NOT EXISTS preference (key TEXT PRIMARY KEY UNIQUE NOT NULL, value)"
+			);
+			if ( ! result ) {
+				BOOST_THROW_EXCEPTION(
+					pcf::exception::Database()
+					<< pcf::exception::tag::Message("Failed to create initial database structure for preferences.")
+				);
+				return false;
+			}
+		}
+		pcf::data::SQLite3::ScopedStatement stmtGetPreferenceByKey(this->database, "SELECT key, value FROM preference WHERE key = ? LIMIT 1");
+		pcf::data::SQLite3::ScopedStatement stmtSetPreferenceByKey(this->database, "INSERT OR REPLACE INTO preference (key, value) VALUES (?, ?)");
+		/* check database type */
+		stmtGetPreferenceByKey.reset();
+		prefKey = "databaseType";
+		stmtGetPreferenceByKey.bind(prefKey);
+		if ( stmtGetPreferenceByKey.next() ) {
+			const std::string realDatabaseType(stmtGetPreferenceByKey.getColumn<std::string>(1));
+			if (realDatabaseType != databaseType) {
+				BOOST_THROW_EXCEPTION(
+					pcf::exception::Database()
+					<< pcf::exception::tag::Message("Invalid database type \"" + realDatabaseType + "\".")
+				);
+				return false;
+			}
+		}
+		/* check database version */
+		stmtGetPreferenceByKey.reset();
+		prefKey = "databaseVersion";
+		stmtGetPreferenceByKey.bind(prefKey);
+		if ( stmtGetPreferenceByKey.next() ) {
+			if (stmtGetPreferenceByKey.getColumn<boost::int64_t>(1) != databaseVersion) {
+				needsDatabaseRecreation = true;
+			}
+		} else if ( hasPreferenceTable ) {
+			needsDatabaseRecreation = true;
+		} else {
+			stmtSetPreferenceByKey.reset();
+			stmtSetPreferenceByKey.bind(prefKey);
+			stmtSetPreferenceByKey.bind(static_cast<boost::int64_t>(databaseVersion));
+			if ( ! stmtSetPreferenceByKey() ) {
+				BOOST_THROW_EXCEPTION(
+					pcf::exception::Database()
+					<< pcf::exception::tag::Message("Failed to set database preference value for \"" + prefKey + "\".")
+				);
+				return false;
+			}
+		}
+		if ( needsDatabaseRecreation ) {
+			/* database version does not match -> recreate database */
+			if ( ! this->database.clear() ) {
+				BOOST_THROW_EXCEPTION(
+					pcf::exception::Database()
+					<< pcf::exception::tag::Message("Failed clear database.")
+				);
+				return false;
+			}
+			lock.unlock();
+			return this->initDatabase();
+		}
+		/* directory table */
+		result = this->database.query(
+			"CREATE TABLE IF NOT EXISTS directory (id INTEGER PRIMARY KEY AUTOINCREMENT, path TEXT"
+#ifdef PCF_IS_WIN
+			" COLLATE NOCASE"
+#endif /* PCF_IS_WIN */
+			" UNIQUE NOT NULL)"
+		);
+		if ( ! result ) {
+			BOOST_THROW_EXCEPTION(
+				pcf::exception::Database()
+				<< pcf::exception::tag::Message("Failed to create initial database structure for directories.")
+			);
+			return false;
+		}
+		/* file table */
+		result = this->database.query(
+			"CREATE TABLE IF NOT EXISTS file (id INTEGER PRIMARY KEY AUTOINCREMENT, path INTEGER NOT NULL, file TEXT"
+#ifdef PCF_IS_WIN
+			" COLLATE NOCASE"
+#endif /* PCF_IS_WIN */
+			" NOT NULL, size UNSIGNED BIG INT NOT NULL, lastModified DATETIME, flags UNSIGNED BIG INT NOT NULL,"
+			" FOREIGN KEY(path) REFERENCES directory(id)"
+			" ON DELETE CASCADE ON UPDATE CASCADE,"
+			" UNIQUE(path, file) ON CONFLICT REPLACE"
+			")"
+		);
+		if ( ! result ) {
+			BOOST_THROW_EXCEPTION(
+				pcf::exception::Database()
+				<< pcf::exception::tag::Message("Failed to create initial database structure for files.")
+			);
+			return false;
+		}
+		/* runtime table */
+		result = this->database.query(
+			"CREATE TABLE IF NOT EXISTS runtime (id INTEGER PRIMARY KEY AUTOINCREMENT, process TEXT NOT NULL, transition TEXT"
+#ifdef PCF_IS_WIN
+			" COLLATE NOCASE"
+#endif /* PCF_IS_WIN */
+			" NOT NULL, duration UNSIGNED BIG INT NOT NULL, exitCode INTEGER NOT NULL, outputSize UNSIGNED BIG INT NOT NULL)"
+		);
+		if ( result ) {
+			result = this->database.query("CREATE INDEX IF NOT EXISTS runtimeTransition ON runtime (process, transition)");
+		}
+		if ( ! result ) {
+			BOOST_THROW_EXCEPTION(
+				pcf::exception::Database()
+				<< pcf::exception::tag::Message("Failed to create initial database structure for runtimes.")
+			);
+			return false;
+		}
+		/* directory listing table */
+		result = this->database.query(
+			"CREATE TABLE IF NOT EXISTS listing (path TEXT"
+#ifdef PCF_IS_WIN
+			" COLLATE NOCASE"
+#endif /* PCF_IS_WIN */
+			" PRIMARY KEY NOT NULL, inode INTEGER NOT NULL, modified INTEGER NOT NULL, changed INTEGER NOT NULL, entries TEXT NOT NULL)"
+		);
+		if ( ! result ) {
+			BOOST_THROW_EXCEPTION(
+				pcf::exception::Database()
+				<< pcf::exception::tag::Message("Failed to create initial database structure for directory listings.")
+			);
+			return false;
+		}
+		/* content hash table */
+		result = this->database.query(
+			"CREATE TABLE IF NOT EXISTS hash (path TEXT"
+#ifdef PCF_IS_WIN
+			" COLLATE NOCASE"
+#endif /* PCF_IS_WIN */
+			" PRIMARY KEY NOT NULL, size UNSIGNED BIG INT NOT NULL, lastModified INTEGER NOT NULL, contentChanged INTEGER NOT NULL, hash INTEGER NOT NULL)"
+		);
+		if ( ! result ) {
+			BOOST_THROW_EXCEPTION(
+				pcf::exception::Database()
+				<< pcf::exception::tag::Message("Failed to create initial database structure for content hashes.")
+			);
+			return false;
+		}
+		return true;
+	}
+};
+
+
+
+/**
+ * Constructor.
+ * Opens and initializes the SQLite database at the given location.
+ *
+ * @param[in] db - path to database
+ */
+SqliteDatabase::SqliteDatabase(const boost::filesystem::path & db) :
+	handle(boost::make_shared<SqliteDatabase::Handle>(db))
+{}
+
+
+/**
+ * Returns the mutex of the database handle.
+ *
+ * @return database access mutex
+ */
+boost::mutex & SqliteDatabase::getMutex() {
+	return this->handle->mutex;
+}
+
+
+/**
+ * Checks whether the database handle is valid.
+ *
+ * @return true if open, else false
+ */
+bool SqliteDatabase::isOpen() const {
+	if ( ! this->handle ) return false;
+	if ( this->handle->database.getHandle() == NULL ) return false;
+	return true;
+}
+
+
+/**
+ * Updates the database entry for the given file by using the passed meta data.
+ *
+ * @param[in] file - file information for database update
+ * @return true if the update was successful, else false
+ */
+bool SqliteDatabase::updateFile(const FileInformation & file) {
+	boost::mutex::scoped_lock lock(this->handle->mutex);
+	const int directoryId = this->getDirectoryIdInternal(file.path.parent_path(), true);
+	if (directoryId == -1) return false;
+	/* update database */
+	const std::string origFileStr(convertPath(file.path).filename().generic_string(pcf::path::utf8));
+	/* automatically end transaction at the end of scope */
+	Handle::ScopedTransaction transaction(*(this->handle));
+	/* add file information to database */
+	this->handle->updateFile.reset();
+	this->handle->updateFile.bind(directoryId);
+	this->handle->updateFile.bind(origFileStr);
+	this->handle->updateFile.bind(static_cast<boost::int64_t>(file.size));
+	this->handle->updateFile.bind(toDatabaseTime(file.lastChange));
+	this->handle->updateFile.bind(static_cast<boost::int64_t>(file.flags));
+	if ( ! this->handle->updateFile() ) {
+		return false;
+	}
+	/* save changes to the database */
+	transaction.commit();
+	return true;
+}
+
+
+/**
+ * Updates the database entries for the given files by using the passed meta data within a
+ * single transaction.
+ *
+ * @param[in] files - file information for database update
+ * @param[in] flags - file flags to set instead of those of the passed file information (optional)
+ * @return true if all updates were successful, else false
+ */
+bool SqliteDatabase::updateFiles(const std::vector<FileInformation> & files, const boost::optional<boost::uint64_t> & flags) {
+	if ( files.empty() ) return true;
+	boost::mutex::scoped_lock lock(this->handle->mutex);
+	/* automatically end transaction at the end of scope */
+	Handle::ScopedTransaction transaction(*(this->handle));
+	BOOST_FOREACH(const FileInformation & file, files) {
+		const int directoryId = this->getDirectoryIdInternal(file.path.parent_path(), true);
+		if (directoryId == -1) return false;
+		/* add file information to database */
+		this->handle->updateFile.reset();
+		this->handle->updateFile.bind(directoryId);
+		this->handle->updateFile.bind(convertPath(file.path).filename().generic_string(pcf::path::utf8));
+		this->handle->updateFile.bind(static_cast<boost::int64_t>(file.size));
+		this->handle->updateFile.bind(toDatabaseTime(file.lastChange));
+		this->handle->updateFile.bind(static_cast<boost::int64_t>(( flags ) ? *flags : file.flags));
+		if ( ! this->handle->updateFile() ) {
+			return false;
+		}
+	}
+	/* save changes to the database */
+	transaction.commit();
+	return true;
+}
+
+
+/**
+ * Returns the meta data for a given file.
+ * 
+ * @param[out] result - output variable for the meta data
+ * @param[in] file - path to requested file
+ * @return true if the file is in the database, else false
+ */
+bool SqliteDatabase::getFile(FileInformation & result, const boost::filesystem::path & file) {
+	const std::string origDirectoryStr(convertDirectory(file.parent_path()));
+	const std::string origFileStr(convertPath(file).filename().generic_string(pcf::path::utf8));
+	Handle::ScopedReader reader(*(this->handle));
+	/* get file information from database */
+	reader->getFile.reset();
+	reader->getFile.bind(origDirectoryStr);
+	reader->getFile.bind(origFileStr);
+	if ( reader->getFile.next() ) {
+		/* file exists */
+		result.path = file;
+		result.size = static_cast<boost::uint64_t>(reader->getFile.getColumn<boost::int64_t>(0));
+		result.lastChange = fromDatabaseTime(reader->getFile.getColumn<boost::int64_t>(1));
+		result.flags = static_cast<boost::uint64_t>(reader->getFile.getColumn<boost::int64_t>(2));
+		return true;
+	}
+	/* file not found in database */
+	return false;
+}
+
+
+/**
+ * Returns the meta data of all files within a single sequential scan.
+ *
+ * @param[out] result - output variable for the meta data
+ * @return true on success, else false
+ */
+bool SqliteDatabase::getFiles(std::vector<FileInformation> & result) {
+	result.clear();
+	boost::mutex::scoped_lock lock(this->handle->mutex);
+	this->handle->getAllFiles.reset();
+	while ( this->handle->getAllFiles.next() ) {
+		FileInformation fileInfo;
+		fileInfo.path = boost::filesystem::path(this->handle->getAllFiles.getColumn<std::string>(0), pcf::path::utf8);
+		fileInfo.size = static_cast<boost::uint64_t>(this->handle->getAllFiles.getColumn<boost::int64_t>(1));
+		fileInfo.lastChange = fromDatabaseTime(this->handle->getAllFiles.getColumn<boost::int64_t>(2));
+		fileInfo.flags = static_cast<boost::uint64_t>(this->handle->getAllFiles.getColumn<boost::int64_t>(3));
+		result.push_back(fileInfo);
+	}
+	return true;
+}
+
+
+/**
+ * Sets the flags for a given file.
+ *
+ * @param[in] file - set the flags for this file
+ * @param[in] flags - flags to set
+ * @return true if file exists and flags were set, else false
+ */
+bool SqliteDatabase::setFlags(const boost::filesystem::path & file, const boost::uint64_t flags) {
+	boost::mutex::scoped_lock lock(this->handle->mutex);
+	const int directoryId = this->getDirectoryIdInternal(file.parent_path(), false);
+	if (directoryId == -1) return false;
+	/* update database */
+	const std::string origFileStr(convertPath(file).filename().generic_string(pcf::path::utf8));
+	/* automatically end transaction at the end of scope */
+	Handle::ScopedTransaction transaction(*(this->handle));
+	/* add file information to database */
+	this->handle->setFileFlags.reset();
+	this->handle->setFileFlags.bind(static_cast<boost::int64_t>(flags));
+	this->handle->setFileFlags.bind(directoryId);
+	this->handle->setFileFlags.bind(origFileStr);
+	if ( ! this->handle->setFileFlags() ) {
+		return false;
+	}
+	/* save changes to the database */
+	transaction.commit();
+	return true;
+}
+
+
+/**
+ * Sets the flags for the given files within a single transaction. Files which are not in the
+ * database are skipped and reported.
+ *
+ * @param[in] files - set the flags of the file information for these files
+ * @param[out] failed - output variable for the files which are not in the database
+ * @return true if all existing files were updated, else false
+ */
+bool SqliteDatabase::setFlags(const std::vector<FileInformation> & files, std::vector<boost::filesystem::path> & failed) {
+	failed.clear();
+	if ( files.empty() ) return true;
+	boost::mutex::scoped_lock lock(this->handle->mutex);
+	/* automatically end transaction at the end of scope */
+	Handle::ScopedTransaction transaction(*(this->handle));
+	BOOST_FOREACH(const FileInformation & file, files) {
+		const int directoryId = this->getDirectoryIdInternal(file.path.parent_path(), false);
+		if (directoryId == -1) {
+			failed.push_back(file.path);
+			continue;
+		}
+		this->handle->setFileFlags.reset();
+		this->handle->setFileFlags.bind(static_cast<boost::int64_t>(file.flags));
+		this->handle->setFileFlags.bind(directoryId);
+		this->handle->setFileFlags.bind(convertPath(file.path).filename().generic_string(pcf::path::utf8));
+		if ( ! this->handle->setFileFlags() ) {
+			return false;
+		}
+	}
+	/* save changes to the database */
+	transaction.commit();
+	return true;
+}
+
+
+/**
+ * Sets the flags for all files.
+ *
+ * @param[in] flags - flags to set
+ * @return true if file flags were set, else false
+ */
+bool SqliteDatabase::setAllFlags(const boost::uint64_t flags) {
+	boost::mutex::scoped_lock lock(this->handle->mutex);
+	/* update database */
+	/* automatically end transaction at the end of scope */
+	Handle::ScopedTransaction transaction(*(this->handle));
+	/* add file information to database */
+	this->handle->setAllFileFlags.reset();
+	this->handle->setAllFileFlags.bind(static_cast<boost::int64_t>(flags));
+	if ( ! this->handle->setAllFileFlags() ) {
+		return false;
+	}
+	/* save changes to the database */
+	transaction.commit();
+	return true;
+}
+
+
+/**
+ * Adds the passed flags to the given file.
+ * 
+ * @param[in] file - set the flags for this file
+ * @param[in] flags - flags to add
+ * @return true if file exists and flags were added, else false
+ */
+bool SqliteDatabase::addFlags(const boost::filesystem::path & file, const boost::uint64_t flags) {
+	boost::mutex::scoped_lock lock(this->handle->mutex);
+	const int directoryId = this->getDirectoryIdInternal(file.parent_path(), false);
+	if (directoryId == -1) return false;
+	/* update database */
+	const std::string origFileStr(convertPath(file).filename().generic_string(pcf::path::utf8));
+	/* automatically end transaction at the end of scope */
+	Handle::ScopedTransaction transaction(*(this->handle));
+	/* add file information to database */
+	this->handle->addFileFlags.reset();
+	this->handle->addFileFlags.bind(static_cast<boost::int64_t>(flags));
+	this->handle->addFileFlags.bind(directoryId);
+	this->handle->addFileFlags.bind(origFileStr);
+	if ( ! this->handle->addFileFlags() ) {
+		return false;
+	}
+	/* save changes to the database */
+	transaction.commit();
+	return true;
+}
+
+
+/**
+ * Delete the given file and its content hash record from the database.
+ * 
+ * @param[in] file - file to remove from database
+ * @return true if the file was removed, false on error or if no such file was found in the database
+ */
+bool SqliteDatabase::deleteFile(const boost::filesystem::path & file) {
+	boost::mutex::scoped_lock lock(this->handle->mutex);
+	const int directoryId = this->getDirectoryIdInternal(file.parent_path(), false);
+	if (directoryId == -1) return false;
+	/* automatically end transaction at the end of scope */
+	Handle::ScopedTransaction transaction(*(this->handle));
+	const boost::filesystem::path origFile(convertPath(file));
+	/* delete file from database */
+	this->handle->deleteFile.reset();
+	this->handle->deleteFile.bind(directoryId);
+	this->handle->deleteFile.bind(origFile.filename().generic_string(pcf::path::utf8));
+	if ( ! this->handle->deleteFile() ) {
+		return false;
+	}
+	/* delete content hash from database */
+	this->handle->deleteHash.reset();
+	this->handle->deleteHash.bind(origFile.generic_string(pcf::path::utf8));
+	if ( ! this->handle->deleteHash() ) {
+		return false;
+	}
+	/* save changes to the database */
+	transaction.commit();
+	return true;
+}
+
+
+/**
+ * Delete the given files and their content hash records from the database within a single
+ * transaction. Files which are not in the database are ignored.
+ * 
+ * @param[in] files - files to remove from database
+ * @return true on success, else false
+ */
+bool SqliteDatabase::deleteFiles(const std::vector<boost::filesystem::path> & files) {
+	if ( files.empty() ) return true;
+	boost::mutex::scoped_lock lock(this->handle->mutex);
+	/* automatically end transaction at the end of scope */
+	Handle::ScopedTransaction transaction(*(this->handle));
+	BOOST_FOREACH(const boost::filesystem::path & file, files) {
+		const int directoryId = this->getDirectoryIdInternal(file.parent_path(), false);
+		if (directoryId == -1) continue;
+		const boost::filesystem::path origFile(convertPath(file));
+		/* delete file from database */
+		this->handle->deleteFile.reset();
+		this->handle->deleteFile.bind(directoryId);
+		this->handle->deleteFile.bind(origFile.filename().generic_string(pcf::path::utf8));
+		if ( ! this->handle->deleteFile() ) {
+			return false;
+		}
+		/* delete content hash from database */
+		this->handle->deleteHash.reset();
+		this->handle->deleteHash.bind(origFile.generic_string(pcf::path::utf8));
+		if ( ! this->handle->deleteHash() ) {
+			return false;
+		}
+	}
+	/* save changes to the database */
+	transaction.commit();
+	return true;
+}
+
+
+/**
+ * Traverse all files in the database for which the given flags are set.
+ *
+ * @param[in] call - visitor to call
+ * @param[in] flags - match files with these flags
+ * @return true on success, else false if the callback returned false
+ * @remarks The callback needs to return true to continue or false to abort the operation.
+ * @see Callback
+ */
+bool SqliteDatabase::forEachFileByFlag(const Database::Callback & call, const boost::uint64_t flags) {
+	FileInformation fileInfo;
+	if ( ! call ) return true;
+	boost::mutex::scoped_lock lock(this->handle->mutex);
+	this->handle->getFilesByFlag.reset();
+	this->handle->getFilesByFlag.bind(static_cast<boost::int64_t>(flags));
+	while ( this->handle->getFilesByFlag.next() ) {
+		fileInfo.path = boost::filesystem::path(this->handle->getFilesByFlag.getColumn<std::string>(0), pcf::path::utf8);
+		fileInfo.size = static_cast<boost::uint64_t>(this->handle->getFilesByFlag.getColumn<boost::int64_t>(1));
+		fileInfo.lastChange = fromDatabaseTime(this->handle->getFilesByFlag.getColumn<boost::int64_t>(2));
+		fileInfo.flags = static_cast<boost::uint64_t>(this->handle->getFilesByFlag.getColumn<boost::int64_t>(3));
+		lock.unlock(); /* return access to the database */
+		if ( ! call(fileInfo) ) return false;
+		lock.lock(); /* take access of the database back again */
+	}
+	return true;
+}
+
+
+/**
+ * Delete all files that match the given flags together with their content hash records.
+ *
+ * @param[in] flags - compare with these flags
+ * @return true on success, else false
+ */
+bool SqliteDatabase::deleteFilesByFlag(const boost::uint64_t flags) {
+	boost::mutex::scoped_lock lock(this->handle->mutex);
+	/* automatically end transaction at the end of scope */
+	Handle::ScopedTransaction transaction(*(this->handle));
+	this->handle->deleteHashesByFlag.reset();
+	this->handle->deleteHashesByFlag.bind(static_cast<boost::int64_t>(flags));
+	if ( ! this->handle->deleteHashesByFlag() ) {
+		return false;
+	}
+	this->handle->deleteFilesByFlag.reset();
+	this->handle->deleteFilesByFlag.bind(static_cast<boost::int64_t>(flags));
+	if ( ! this->handle->deleteFilesByFlag() ) {
+		return false;
+	}
+	/* save changes to the database */
+	transaction.commit();
+	return true;
+}
+
+
+/**
+ * Adds the given transition runtime records within a single transaction. Only the last
+ * Database::runtimeHistorySize records are kept per transition.
+ *
+ * @param[in] records - transition runtime records to add
+ * @return true on success, else false
+ */
+bool SqliteDatabase::addRuntimes(const TransitionRuntimeVector & records) {
+	if ( records.empty() ) return true;
+	boost::mutex::scoped_lock lock(this->handle->mutex);
+	/* automatically end transaction at the end of scope */
+	Handle::ScopedTransaction transaction(*(this->handle));
+	/* add runtime information to database */
+	BOOST_FOREACH(const TransitionRuntime & record, records) {
+		this->handle->addRuntime.reset();
+		this->handle->addRuntime.bind(record.process);
+		this->handle->addRuntime.bind(record.transition);
+		this->handle->addRuntime.bind(static_cast<boost::int64_t>(record.runtime.duration.total_milliseconds()));
+		this->handle->addRuntime.bind(record.runtime.exitCode);
+		this->handle->addRuntime.bind(static_cast<boost::int64_t>(record.runtime.outputSize));
+		if ( ! this->handle->addRuntime() ) {
+			return false;
+		}
+	}
+	/* remove outdated runtime information */
+	this->handle->deleteOldRuntimes.reset();
+	this->handle->deleteOldRuntimes.bind(static_cast<boost::int64_t>(Database::runtimeHistorySize));
+	if ( ! this->handle->deleteOldRuntimes() ) {
+		return false;
+	}
+	/* save changes to the database */
+	transaction.commit();
+	return true;
+}
+
+
+/**
+ * Returns the runtime records of the given transition starting with the most recent one.
+ *
+ * @param[out] result - output variable for the runtime records
+ * @param[in] process - ID of the process of the transition
+ * @param[in] transition - unique key of the transition within its process
+ * @return true if at least one record was found, else false
+ */
+bool SqliteDatabase::getRuntimes(RuntimeInformationVector & result, const std::string & process, const std::string & transition) {
+	RuntimeInformation runtime;
+	result.clear();
+	Handle::ScopedReader reader(*(this->handle));
+	reader->getRuntimes.reset();
+	reader->getRuntimes.bind(process);
+	reader->getRuntimes.bind(transition);
+	while ( reader->getRuntimes.next() ) {
+		runtime.duration = boost::posix_time::milliseconds(reader->getRuntimes.getColumn<boost::int64_t>(0));
+		runtime.exitCode = reader->getRuntimes.getColumn<int>(1);
+		runtime.outputSize = static_cast<boost::uint64_t>(reader->getRuntimes.getColumn<boost::int64_t>(2));
+		result.push_back(runtime);
+	}
+	return ( ! result.empty() );
+}
+
+
+/**
+ * Returns the stored listing of the given directory.
+ *
+ * @param[out] result - output variable for the directory listing
+ * @param[in] directory - absolute path to the requested directory
+ * @return true if a valid listing for the directory is in the database, else false
+ */
+bool SqliteDatabase::getListing(DirectoryListing & result, const boost::filesystem::path & directory) {
+	const std::string origDirectoryStr(convertPath(directory).generic_string(pcf::path::utf8));
+	Handle::ScopedReader reader(*(this->handle));
+	reader->getListing.reset();
+	reader->getListing.bind(origDirectoryStr);
+	if ( ! reader->getListing.next() ) return false;
+	result.path = directory;
+	result.inode = reader->getListing.getColumn<boost::int64_t>(0);
+	result.modified = reader->getListing.getColumn<boost::int64_t>(1);
+	result.changed = reader->getListing.getColumn<boost::int64_t>(2);
+	result.entries.clear();
+	if ( ! decodeEntries(result.entries, reader->getListing.getColumn<std::string>(3)) ) {
+		result.entries.clear();
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ * Inserts or updates the passed directory listings within a single transaction.
+ *
+ * @param[in] listings - directory listings to store
+ * @return true on success, else false
+ */
+bool SqliteDatabase::updateListings(const std::vector<DirectoryListing> & listings) {
+	if ( listings.empty() ) return true;
+	boost::mutex::scoped_lock lock(this->handle->mutex);
+	/* automatically end transaction at the end of scope */
+	Handle::ScopedTransaction transaction(*(this->handle));
+	BOOST_FOREACH(const DirectoryListing & listing, listings) {
+		this->handle->updateListing.reset();
+		this->handle->updateListing.bind(convertPath(listing.path).generic_string(pcf::path::utf8));
+		this->handle->updateListing.bind(listing.inode);
+		this->handle->updateListing.bind(listing.modified);
+		this->handle->updateListing.bind(listing.changed);
+		this->handle->updateListing.bind(encodeEntries(listing.entries));
+		if ( ! this->handle->updateListing() ) {
+			return false;
+		}
+	}
+	/* save changes to the database */
+	transaction.commit();
+	return true;
+}
+
+
+/**
+ * Returns all stored content hash records.
+ *
+ * @param[out] result - output variable for the content hash records
+ * @return true on success, else false
+ */
+bool SqliteDatabase::getHashes(std::vector<ContentHash> & result) {
+	result.clear();
+	boost::mutex::scoped_lock lock(this->handle->mutex);
+	this->handle->getHashes.reset();
+	while ( this->handle->getHashes.next() ) {
+		ContentHash record;
+		record.path = boost::filesystem::path(this->handle->getHashes.getColumn<std::string>(0), pcf::path::utf8);
+		record.size = static_cast<boost::uint64_t>(this->handle->getHashes.getColumn<boost::int64_t>(1));
+		record.lastModified = fromDatabaseTime(this->handle->getHashes.getColumn<boost::int64_t>(2));
+		record.contentChanged = fromDatabaseTime(this->handle->getHashes.getColumn<boost::int64_t>(3));
+		record.hash = static_cast<boost::uint64_t>(this->handle->getHashes.getColumn<boost::int64_t>(4));
+		result.push_back(record);
+	}
+	return true;
+}
+
+
+/**
+ * Inserts or updates the passed content hash records within a single transaction.
+ *
+ * @param[in] records - content hash records to store
+ * @return true on success, else false
+ */
+bool SqliteDatabase::updateHashes(const std::vector<ContentHash> & records) {
+	if ( records.empty() ) return true;
+	boost::mutex::scoped_lock lock(this->handle->mutex);
+	/* automatically end transaction at the end of scope */
+	Handle::ScopedTransaction transaction(*(this->handle));
+	BOOST_FOREACH(const ContentHash & record, records) {
+		this->handle->updateHash.reset();
+		this->handle->updateHash.bind(convertPath(record.path).generic_string(pcf::path::utf8));
+		this->handle->updateHash.bind(static_cast<boost::int64_t>(record.size));
+		this->handle->updateHash.bind(toDatabaseTime(record.lastModified));
+		this->handle->updateHash.bind(toDatabaseTime(record.contentChanged));
+		this->handle->updateHash.bind(static_cast<boost::int64_t>(record.hash));
+		if ( ! this->handle->updateHash() ) {
+			return false;
+		}
+	}
+	/* save changes to the database */
+	transaction.commit();
+	return true;
+}
+
+
+/**
+ * Deletes the content hash records of the given files within a single transaction.
+ *
+ * @param[in] files - remove the content hash records of these files
+ * @return true on success, else false
+ */
+bool SqliteDatabase::deleteHashes(const std::vector<boost::filesystem::path> & files) {
+	if ( files.empty() ) return true;
+	boost::mutex::scoped_lock lock(this->handle->mutex);
+	/* automatically end transaction at the end of scope */
+	Handle::ScopedTransaction transaction(*(this->handle));
+	BOOST_FOREACH(const boost::filesystem::path & file, files) {
+		this->handle->deleteHash.reset();
+		this->handle->deleteHash.bind(convertPath(file).generic_string(pcf::path::utf8));
+		if ( ! this->handle->deleteHash() ) {
+			return false;
+		}
+	}
+	/* save changes to the database */
+	transaction.commit();
+	return true;
+}
+
+
+/**
+ * Removes unnecessary directory entries from the database.
+ * 
+ * @return true on success, else false
+ */
+bool SqliteDatabase::cleanUp() {
+	boost::mutex::scoped_lock lock(this->handle->mutex);
+	/* AUTOINCREMENT prevents the reuse of deleted directory indices but these need to be forgotten */
+	this->handle->directoryIds.clear();
+	if ( this->handle->deleteUnusedDirectories() ) {
+		return true;
+	}
+	return false;
+}
+
+
+/**
+ * Removes all entries in the database to reset it to its initial state.
+ *
+ * @return true on success, else false
+ */
+bool SqliteDatabase::clear() {
+	boost::mutex::scoped_lock lock(this->handle->mutex);
+	this->handle->directoryIds.clear();
+	if (this->handle->deleteAllDirectories() && this->handle->deleteAllFiles() && this->handle->deleteAllRuntimes() && this->handle->deleteAllListings() && this->handle->deleteAllHashes()) {
+		return true;
+	}
+	return false;
+}
+
+
+/**
+ * Returns the index of the given directory path.
+ *
+ * @param[in] directory - return database index to this directory path
+ * @param[in] aine - add passed directory to database if not already there (add if not exist)
+ * @return directory database index or -1 on error
+ */
+int SqliteDatabase::getDirectoryIdInternal(const boost::filesystem::path & directory, const bool aine) {
+	const Handle::DirectoryIdMap::const_iterator it = this->handle->directoryIds.find(directory.native());
+	if (it != this->handle->directoryIds.end()) return it->second;
+	const std::string origDirectoryStr(convertDirectory(directory));
+	this->handle->getDirectoryId.reset();
+	this->handle->getDirectoryId.bind(origDirectoryStr);
+	if ( this->handle->getDirectoryId.next() ) {
+		/* directory found in database */
+		const int id = this->handle->getDirectoryId.getColumn<int>(0);
+		this->handle->directoryIds[directory.native()] = id;
+		return id;
+	}
+	if ( ! aine ) return -1;
+	this->handle->addDirectory.reset();
+	this->handle->addDirectory.bind(origDirectoryStr);
+	if ( ! this->handle->addDirectory() ) {
+		return -1;
+	}
+	/* the directory table uses an integer primary key which equals the row ID */
+	const int id = static_cast<int>(this->handle->database.getLastInsertRowId());
+	this->handle->directoryIds[directory.native()] = id;
+	return id;
+}
+
+
+} /* namespace pp */
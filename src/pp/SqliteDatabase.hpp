@@ -0,0 +1,71 @@
+/**
+ * @file SqliteDatabase.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2015-2018 Daniel Starke
+ * @date 2015-10-01
+ * @version 2026-10-17
+ */
+#ifndef __PP_SQLITEDATABASE_HPP__
+#define __PP_SQLITEDATABASE_HPP__
+
+
+#include <string>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <pcf/data/SQLite3.hpp>
+#include "DatabaseBackend.hpp"
+#include "Type.hpp"
+
+
+namespace pp {
+
+
+/**
+ * Database backend which stores all records in a SQLite3 database. Writes go through a single
+ * connection. Lookups use a pool of read-only connections.
+ */
+class SqliteDatabase : public DatabaseBackend {
+public:
+	/** Maximum number of concurrently opened read-only connections. */
+	static const size_t maxReadConnections = 4;
+private:
+	struct Handle; /**< Forward declaration of internal database structure. */
+	boost::shared_ptr<Handle> handle; /**< Internal database handle and statements. */
+public:
+	explicit SqliteDatabase(const boost::filesystem::path & db);
+	virtual boost::mutex & getMutex();
+	virtual bool isOpen() const;
+	virtual bool updateFile(const FileInformation & file);
+	virtual bool updateFiles(const std::vector<FileInformation> & files, const boost::optional<boost::uint64_t> & flags);
+	virtual bool getFile(FileInformation & result, const boost::filesystem::path & file);
+	virtual bool getFiles(std::vector<FileInformation> & result);
+	virtual bool setFlags(const boost::filesystem::path & file, const boost::uint64_t flags);
+	virtual bool setFlags(const std::vector<FileInformation> & files, std::vector<boost::filesystem::path> & failed);
+	virtual bool setAllFlags(const boost::uint64_t flags);
+	virtual bool addFlags(const boost::filesystem::path & file, const boost::uint64_t flags);
+	virtual bool deleteFile(const boost::filesystem::path & file);
+	virtual bool deleteFiles(const std::vector<boost::filesystem::path> & files);
+	virtual bool forEachFileByFlag(const Database::Callback & call, const boost::uint64_t flags);
+	virtual bool deleteFilesByFlag(const boost::uint64_t flags);
+	virtual bool addRuntimes(const TransitionRuntimeVector & records);
+	virtual bool getRuntimes(RuntimeInformationVector & result, const std::string & process, const std::string & transition);
+	virtual bool getListing(DirectoryListing & result, const boost::filesystem::path & directory);
+	virtual bool updateListings(const std::vector<DirectoryListing> & listings);
+	virtual bool getHashes(std::vector<ContentHash> & result);
+	virtual bool updateHashes(const std::vector<ContentHash> & records);
+	virtual bool deleteHashes(const std::vector<boost::filesystem::path> & files);
+	virtual bool cleanUp();
+	virtual bool clear();
+private:
+	int getDirectoryIdInternal(const boost::filesystem::path & directory, const bool aine = false);
+};
+
+
+} /* namespace pp */
+
+
+#endif /* __PP_SQLITEDATABASE_HPP__ */
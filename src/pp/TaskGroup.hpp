@@ -0,0 +1,157 @@
+/**
+ * @file TaskGroup.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-17
+ * @version 2026-10-17
+ */
+#ifndef __PP_TASKGROUP_HPP__
+#define __PP_TASKGROUP_HPP__
+
+
+#include <cstdlib>
+#include <deque>
+#include <boost/asio.hpp>
+#include <boost/config/warning_disable.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/phoenix/bind.hpp>
+#include <boost/phoenix/core.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+/* workaround for boost::phoenix::bind and boost::bind namespace collision */
+#define BOOST_BIND_NO_PLACEHOLDERS
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#undef BOOST_BIND_NO_PLACEHOLDERS
+
+
+namespace pp {
+
+
+/**
+ * Class to execute a group of independent tasks in parallel on the worker threads of an I/O
+ * service and to wait for their completion. The waiting thread executes tasks of its own group
+ * which were not picked up by a worker yet. Therefore, tasks may wait for nested task groups
+ * without blocking all worker threads. Tasks are executed in the calling thread if no I/O
+ * service is given.
+ */
+class TaskGroup : private boost::noncopyable {
+public:
+	/** Task function type. */
+	typedef boost::function0<void> TaskType;
+private:
+	/**
+	 * Structure to hold the task group state which is shared with the posted handlers.
+	 */
+	struct State {
+		std::deque<TaskType> queue; /**< Tasks not started yet. */
+		size_t running; /**< Number of currently running tasks. */
+		boost::exception_ptr error; /**< First exception thrown by a task. */
+		boost::mutex mutex; /**< Mutex object for parallel execution. */
+		boost::condition_variable finished; /**< Signaled when the last running task finished. */
+		
+		/** Default constructor. */
+		explicit State():
+			running(0)
+		{}
+	};
+	
+	boost::asio::io_service * ioService; /**< Optional I/O service used for task dispatching. */
+	boost::shared_ptr<State> state; /**< Shared task group state. */
+public:
+	/**
+	 * Constructor.
+	 *
+	 * @param[in,out] ios - optional I/O service to dispatch the tasks to
+	 */
+	explicit TaskGroup(boost::asio::io_service * ios = NULL):
+		ioService(ios),
+		state(boost::make_shared<State>())
+	{}
+	
+	/**
+	 * Destructor. Waits for all running tasks to finish.
+	 */
+	~TaskGroup() {
+		try {
+			this->wait();
+		} catch (...) {
+			/* ignore */
+		}
+	}
+	
+	/**
+	 * Queues the given task for parallel execution.
+	 *
+	 * @param[in] task - task to execute
+	 */
+	void run(const TaskType & task) {
+		{
+			boost::mutex::scoped_lock lock(this->state->mutex);
+			this->state->queue.push_back(task);
+		}
+		if (this->ioService != NULL) this->ioService->post(boost::phoenix::bind(&TaskGroup::runPending, this->state));
+	}
+	
+	/**
+	 * Waits until all queued tasks have finished. Tasks not started yet are executed within the
+	 * calling thread.
+	 *
+	 * @throws the first exception thrown by any task of this group
+	 */
+	void wait() {
+		while ( TaskGroup::executeNext(*(this->state)) );
+		boost::mutex::scoped_lock lock(this->state->mutex);
+		while (this->state->running > 0) this->state->finished.wait(lock);
+		if ( this->state->error ) {
+			const boost::exception_ptr error(this->state->error);
+			this->state->error = boost::exception_ptr();
+			lock.unlock();
+			boost::rethrow_exception(error);
+		}
+	}
+private:
+	/**
+	 * Handler posted to the I/O service for each queued task.
+	 *
+	 * @param[in,out] s - task group state
+	 */
+	static void runPending(const boost::shared_ptr<State> & s) {
+		TaskGroup::executeNext(*s);
+	}
+	
+	/**
+	 * Executes the next queued task.
+	 *
+	 * @param[in,out] s - task group state
+	 * @return true if a task was executed, false if the queue was empty
+	 */
+	static bool executeNext(State & s) {
+		TaskType task;
+		{
+			boost::mutex::scoped_lock lock(s.mutex);
+			if ( s.queue.empty() ) return false;
+			task.swap(s.queue.front());
+			s.queue.pop_front();
+			s.running++;
+		}
+		try {
+			task();
+		} catch (...) {
+			boost::mutex::scoped_lock lock(s.mutex);
+			if ( ! s.error ) s.error = boost::current_exception();
+		}
+		boost::mutex::scoped_lock lock(s.mutex);
+		s.running--;
+		if (s.running == 0) s.finished.notify_all();
+		return true;
+	}
+};
+
+
+} /* namespace pp */
+
+
+#endif /* __PP_TASKGROUP_HPP__ */
@@ -3,11 +3,15 @@
  * @author Daniel Starke
  * @copyright Copyright 2015-2018 Daniel Starke
  * @date 2015-08-09
- * @version 2016-11-20
+ * @version 2026-10-17
  */
+#include <cctype>
+#include <limits>
 #include <map>
 #include <string>
 #include <boost/assign/list_of.hpp>
+#include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
 #include <pcf/exception/General.hpp>
 #include "Type.hpp"
 
@@ -78,6 +82,48 @@ bool operator< (const Verbosity lhs, const Verbosity rhs) {
 #endif
 
 
+/**
+ * Returns a resource name and amount pair from the given string if parsing was successful.
+ * The expected format is "<name>=<amount>" whereas the amount may end with one of the binary
+ * unit suffixes K, M, G or T.
+ *
+ * @param[in] str - string to parse
+ * @return the parsed value on success
+ */
+boost::optional<ResourceMap::value_type> getResourcePair(const std::string & str) {
+	const std::string::size_type assign = str.find('=');
+	if (assign == std::string::npos || assign == 0) return boost::optional<ResourceMap::value_type>();
+	const std::string name(str, 0, assign);
+	BOOST_FOREACH(const char c, name) {
+		if (::isalnum(static_cast<int>(static_cast<unsigned char>(c))) == 0 && c != '_') return boost::optional<ResourceMap::value_type>();
+	}
+	std::string value(str, assign + 1);
+	int shift = 0;
+	if ( ! value.empty() ) {
+		switch (::toupper(static_cast<int>(static_cast<unsigned char>(value[value.size() - 1])))) {
+		case 'K': shift = 10; break;
+		case 'M': shift = 20; break;
+		case 'G': shift = 30; break;
+		case 'T': shift = 40; break;
+		default: break;
+		}
+		if (shift > 0) value.erase(value.size() - 1);
+	}
+	if ( value.empty() ) return boost::optional<ResourceMap::value_type>();
+	BOOST_FOREACH(const char c, value) {
+		if (::isdigit(static_cast<int>(static_cast<unsigned char>(c))) == 0) return boost::optional<ResourceMap::value_type>();
+	}
+	boost::uint64_t amount;
+	try {
+		amount = boost::lexical_cast<boost::uint64_t>(value);
+	} catch (const boost::bad_lexical_cast &) {
+		return boost::optional<ResourceMap::value_type>();
+	}
+	if (amount > (std::numeric_limits<boost::uint64_t>::max() >> shift)) return boost::optional<ResourceMap::value_type>();
+	return boost::optional<ResourceMap::value_type>(ResourceMap::value_type(name, amount << shift));
+}
+
+
 /** Mapping for the transition reasons to strings. */
 const char ProcessTransition::reasonMap[3][2] = {
 	{' ', 'F'},
@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2015-2018 Daniel Starke
  * @date 2015-03-22
- * @version 2017-09-16
+ * @version 2026-10-17
  */
 #ifndef __PP_TYPE_HPP__
 #define __PP_TYPE_HPP__
@@ -12,12 +12,18 @@
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 #include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/function.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/optional.hpp>
 #include <boost/regex.hpp>
 #include <boost/shared_ptr.hpp>
+#include <pcf/path/Utility.hpp>
+#include "ContentHashStore.hpp"
+#include "FileStatusCache.hpp"
 #include "Variable.hpp"
 #include "Shell.hpp"
 
@@ -33,6 +39,8 @@ struct TemporaryFileInfo;
 class Process;
 struct ProcessNode;
 class Execution;
+struct RuntimeInformation;
+struct TransitionRuntime;
 
 
 namespace parser {
@@ -63,12 +71,18 @@ typedef std::map< std::string, boost::shared_ptr<Shell> > ShellMap;
 typedef std::vector<Command> CommandVector;
 typedef std::vector<ProcessBlock> ProcessBlockVector;
 typedef std::vector<ProcessTransition> ProcessTransitionVector;
+typedef std::pair<Process *, ProcessTransition *> ProcessTransitionRef;
+typedef std::vector<ProcessTransitionRef> ProcessTransitionRefVector;
+typedef std::map<std::string, ProcessTransitionRef> ProcessTransitionProducerMap;
 typedef std::map<boost::shared_ptr<PathLiteral>, TemporaryFileInfo> TemporaryFileInfoMap;
 typedef std::map<std::string, Process> ProcessMap;
 typedef std::vector<ProcessNode> ProcessNodeVector;
+typedef std::vector<RuntimeInformation> RuntimeInformationVector;
+typedef std::vector<TransitionRuntime> TransitionRuntimeVector;
+typedef std::map<std::string, boost::uint64_t> ResourceMap;
 typedef std::map<std::string, Execution> ExecutionMap;
 typedef boost::function0<void> ExecutionCallback;
-typedef boost::function2<void, const bool, const boost::uint64_t> ProgressCallback;
+typedef boost::function3<void, const bool, const boost::uint64_t, const boost::optional<boost::uint64_t> &> ProgressCallback;
 
 
 /* functions */
@@ -78,6 +92,7 @@ std::ostream & operator<< (std::ostream & out, const Verbosity in);
 /* unsupported in MSVC (@see https://connect.microsoft.com/VisualStudio/feedback/details/529700/enum-operator-overloading-broken) */
 bool operator< (const Verbosity lhs, const Verbosity rhs);
 #endif
+boost::optional<ResourceMap::value_type> getResourcePair(const std::string & str);
 
 
 /* classes */
@@ -90,6 +105,11 @@ struct ProcessTransition {
 	PathLiteralPtrVector output; /**< Output file list. */
 	MissingInputSet missingInput; /**< Missing input files after execution. */
 	CommandVector commands; /**< Commands to be executed to perform this transition. */
+	size_t pendingInputs; /**< Number of unfinished producers this transition waits for (pipelined execution only). */
+	ProcessTransitionRefVector dependents; /**< Transitions waiting for this transition to finish (pipelined execution only). */
+	boost::uint64_t priority; /**< Estimated cost of the longest remaining execution path starting with this transition. */
+	boost::optional<boost::uint64_t> estimatedRuntime; /**< Estimated runtime in milliseconds based on previous executions. */
+	bool failedBefore; /**< True if the transition failed in the previous execution. */
 	/** Reason flag bit positions for transitions. */
 	enum Reason {
 		FORCED, /**< Transition is/was forced. */
@@ -134,6 +154,38 @@ struct FileInformation {
 };
 
 
+/**
+ * This structure holds the information of a directory listing record in the database.
+ */
+struct DirectoryListing {
+	boost::filesystem::path path; /**< Absolute path to the directory. */
+	boost::int64_t inode; /**< File serial number of the directory. */
+	boost::int64_t modified; /**< Last modification time of the directory in nanoseconds since epoch. */
+	boost::int64_t changed; /**< Last status change time of the directory in nanoseconds since epoch. */
+	std::vector<pcf::path::DirectoryEntry> entries; /**< Directory entries in the order of the file system. */
+};
+
+
+/**
+ * This structure holds the information of a transition runtime record in the database.
+ */
+struct RuntimeInformation {
+	boost::posix_time::time_duration duration; /**< Execution time of all transition commands. */
+	int exitCode; /**< Exit code of the failed or last command. */
+	boost::uint64_t outputSize; /**< Size of the output of all transition commands in bytes. */
+};
+
+
+/**
+ * This structure associates a transition runtime record with its transition.
+ */
+struct TransitionRuntime {
+	std::string process; /**< ID of the process of the transition. */
+	std::string transition; /**< Unique key of the transition within its process. */
+	RuntimeInformation runtime; /**< Runtime information of the transition. */
+};
+
+
 /**
  * Configurations for the script parser.
  */
@@ -145,12 +197,21 @@ struct Configuration {
 	bool variableChecking; /**< Enable check whether a variable was defined before used if true. */
 	bool nestedVariables; /**< Enable variable assignment within process blocks if true. */
 	bool fullRecursiveMatch; /**< Enable full recursive regular expression match for input file list generation if true. */
+	std::vector<std::string> excludePatterns; /**< Regular expressions of paths skipped by the full recursive match. */
 	bool removeTemporaries; /**< Remove temporary files at the end of execution if set to true. */
 	bool cleanUpIncompletes; /**< Deletes output files from incomplete transitions if true. */
 	bool removeRemains; /**< Remove files added in previous runs but without any input dependency if true. */
+	bool logDatabase; /**< Store the database as append-only log file instead of SQLite3 database if true. */
+	bool databaseSnapshot; /**< Load all file records of the database at once and write back only changed records if true. */
+	bool pipelinedExecution; /**< Start each transition as soon as its input dependencies are available if true. */
+	bool contentHash; /**< Ignore modification time changes of input files with unchanged content hash if true. */
+	boost::uint64_t outputLimit; /**< Command output size in bytes kept in memory before moving it to a temporary file (0 for unlimited). */
+	boost::posix_time::time_duration modificationTolerance; /**< Minimal time difference for a file to count as newer than its reference file. */
 	std::string shell; /**< Use this shell (ID of the requested shell). */
 	bool lockedVerbosity; /**< Verbosity is locked for further changes by the script if set to true. */
 	Verbosity verbosity; /**< Verbosity level. */
+	boost::shared_ptr<FileStatusCache> fileStatus; /**< File meta data cache shared by all copies of this configuration. */
+	boost::shared_ptr<ContentHashStore> contentHashes; /**< Content hash records shared by all copies of this configuration. */
 	
 	/** Default constructor. */
 	explicit Configuration():
@@ -164,8 +225,16 @@ struct Configuration {
 		removeTemporaries(false),
 		cleanUpIncompletes(false),
 		removeRemains(false),
+		logDatabase(false),
+		databaseSnapshot(false),
+		pipelinedExecution(false),
+		contentHash(false),
+		outputLimit(0),
+		modificationTolerance(boost::posix_time::seconds(1)),
 		lockedVerbosity(false),
-		verbosity(VERBOSITY_INFO)
+		verbosity(VERBOSITY_INFO),
+		fileStatus(boost::make_shared<FileStatusCache>()),
+		contentHashes(boost::make_shared<ContentHashStore>())
 	{}
 };
 
@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2016-2018 Daniel Starke
  * @date 2016-11-20
- * @version 2016-12-30
+ * @version 2026-10-17
  */
 #ifndef __PP_UTILITY_HPP__
 #define __PP_UTILITY_HPP__
@@ -13,8 +13,10 @@
 #include <string>
 #include <boost/config/warning_disable.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/filesystem/path.hpp>
 #include <boost/foreach.hpp>
 #include <pcf/exception/General.hpp>
+#include <pcf/path/Utility.hpp>
 #include "Type.hpp"
 #include "Variable.hpp"
 
@@ -24,17 +26,25 @@ namespace pp {
 
 /**
  * Checks if the given file time indicates that the file was changed compared to the specified
- * reference time. An tolerance of 1 second if used. The function always returns false if no
- * valid time or reference time was given.
+ * reference time. The file time needs to be newer than the reference time by at least the given
+ * tolerance. Tolerances of one second or more compare the times in whole seconds, i.e. a file
+ * changed in a later second counts as modified. Shorter tolerances compare the sub-second times.
+ * The function always returns false if no valid time or reference time was given.
  * 
  * @param[in] time - file modification time
  * @param[in] ref - reference file modification time (e.g. input file)
+ * @param[in] tolerance - minimal time difference (default: 1 second)
  * @return true if modified, else false and also on error
  */
-static bool pathElementWasModified(const boost::posix_time::ptime & time, const boost::posix_time::ptime & ref) {
+static bool pathElementWasModified(const boost::posix_time::ptime & time, const boost::posix_time::ptime & ref, const boost::posix_time::time_duration & tolerance = boost::posix_time::seconds(1)) {
 	if ( time.is_special() ) return false;
 	if ( ref.is_special() ) return false;
-	return (time >= (ref + boost::posix_time::seconds(1)));
+	if (tolerance >= boost::posix_time::seconds(1)) {
+		const boost::posix_time::ptime timeSec(time.date(), boost::posix_time::seconds(time.time_of_day().total_seconds()));
+		const boost::posix_time::ptime refSec(ref.date(), boost::posix_time::seconds(ref.time_of_day().total_seconds()));
+		return (timeSec >= (refSec + boost::posix_time::seconds(tolerance.total_seconds())));
+	}
+	return (time > ref && (time - ref) >= tolerance);
 }
 
 
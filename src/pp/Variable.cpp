@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2015-2018 Daniel Starke
  * @date 2015-01-27
- * @version 2016-12-19
+ * @version 2026-10-17
  */
 #include <algorithm>
 #include <fstream>
@@ -710,6 +710,34 @@ void StringLiteral::functionRExists(std::string & str, const LineInfo & li, cons
 }
 
 
+/**
+ * Replacement function to return true if the given path exists using glob patterns or false else.
+ * 
+ * @param[in,out] str - apply function on this string
+ * @param[in] li - line information (position where this function was called)
+ * @see pcf::path::getGlobPathList()
+ */
+void StringLiteral::functionGExists(std::string & str, const LineInfo & li) {
+	std::vector<boost::filesystem::path> pathList;
+	try {
+		if ( ! pcf::path::getGlobPathList(pathList, boost::locale::conv::utf_to_utf<wchar_t>(str)) ) {
+			str = "false";
+			return;
+		}
+	} catch (...) {
+		std::ostringstream sout;
+		sout << li << ": Error: Failed to get path list from glob pattern \"" << str << "\".";
+		BOOST_THROW_EXCEPTION(
+			pcf::exception::File()
+			<< pcf::exception::tag::Message(sout.str())
+		);
+		str = "false";
+		return;
+	}
+	str = pathList.empty() ? "false" : "true";
+}
+
+
 /**
  * Adds the given flags to the path literal.
  *
@@ -717,7 +745,7 @@ void StringLiteral::functionRExists(std::string & str, const LineInfo & li, cons
  * @return reference to this object for chained operations
  */
 PathLiteral & PathLiteral::addFlags(const PathLiteral::Flag val) {
-	this->flags = this->flags | val;
+	this->flags.fetch_or(val, boost::memory_order_relaxed);
 	return *this;
 }
 
@@ -729,7 +757,7 @@ PathLiteral & PathLiteral::addFlags(const PathLiteral::Flag val) {
  * @return reference to this object for chained operations
  */
 PathLiteral & PathLiteral::removeFlags(const PathLiteral::Flag val) {
-	this->flags = static_cast<PathLiteral::Flag>(static_cast<int>(this->flags) & (~static_cast<int>(val)));
+	this->flags.fetch_and(~static_cast<int>(val), boost::memory_order_relaxed);
 	return *this;
 }
 
@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2015-2018 Daniel Starke
  * @date 2015-01-27
- * @version 2017-09-16
+ * @version 2026-10-17
  */
 #ifndef __PP_VARIABLE_HPP__
 #define __PP_VARIABLE_HPP__
@@ -17,6 +17,7 @@
 #include <string>
 #include <vector>
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/atomic.hpp>
 #include <boost/config/warning_disable.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
@@ -752,6 +753,7 @@ public:
 	static void functionExtension(std::string & str);
 	static void functionExists(std::string & str);
 	static void functionRExists(std::string & str, const LineInfo & li, const bool fullRecursiveMatch);
+	static void functionGExists(std::string & str, const LineInfo & li);
 private:
 	/**
 	 * Returns true if there are still unresolved variables within this string literal part list.
@@ -873,7 +875,7 @@ public:
 		EXISTS = 0x10 /**< The file path exists. */
 	};
 private:
-	Flag flags; /**< Path literal flags. */
+	boost::atomic<int> flags; /**< Path literal flags. Atomic to allow updates from parallel preparation passes. */
 	boost::posix_time::ptime lastModification; /**< Last modification time of the path. */
 public:
 	/**
@@ -913,7 +915,7 @@ public:
 	 */
 	PathLiteral(const PathLiteral & o):
 		StringLiteral(o),
-		flags(o.flags),
+		flags(o.flags.load(boost::memory_order_relaxed)),
 		lastModification(o.lastModification)
 	{}
 	
@@ -923,7 +925,7 @@ public:
 	 * @return path literal flags
 	 */
 	Flag getFlags() const {
-		return this->flags;
+		return static_cast<Flag>(this->flags.load(boost::memory_order_relaxed));
 	}
 	
 	/**
@@ -933,7 +935,7 @@ public:
 	 * @return true if all checked flags are set, else false
 	 */
 	bool hasFlags(const Flag val) const {
-		return (this->flags & val) != 0;
+		return (this->flags.load(boost::memory_order_relaxed) & val) != 0;
 	}
 	
 	/**
@@ -943,7 +945,7 @@ public:
 	 * @return reference to this object for chained operations
 	 */
 	PathLiteral & setFlags(const Flag val) {
-		this->flags = val;
+		this->flags.store(val, boost::memory_order_relaxed);
 		return *this;
 	}
 	
@@ -993,7 +995,7 @@ public:
 	PathLiteral & operator= (const PathLiteral & o) {
 		if (this != &o) {
 			this->StringLiteral::operator= (o);
-			this->flags = o.flags;
+			this->flags.store(o.flags.load(boost::memory_order_relaxed), boost::memory_order_relaxed);
 			this->lastModification = o.lastModification;
 		}
 		return *this;
@@ -1007,7 +1009,7 @@ public:
 	 */
 	bool operator== (const PathLiteral & rh) const {
 		if ( ! this->StringLiteral::operator== (rh) ) return false;
-		if (this->flags != rh.flags) return false;
+		if (this->getFlags() != rh.getFlags()) return false;
 		return (this->lastModification == rh.lastModification);
 	}
 	
@@ -1019,7 +1021,7 @@ public:
 	 */
 	bool operator< (const PathLiteral & rh) const {
 		if ( this->StringLiteral::operator< (rh) ) return true;
-		if (this->flags < rh.flags) return true;
+		if (this->getFlags() < rh.getFlags()) return true;
 		if (this->lastModification < rh.lastModification) return true;
 		return false;
 	}
@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2015-2018 Daniel Starke
  * @date 2015-10-31
- * @version 2016-12-30
+ * @version 2026-10-17
  */
 #ifndef __PP_PARSER_SCRIPT_HPP__
 #define __PP_PARSER_SCRIPT_HPP__
@@ -16,6 +16,7 @@
 #include <boost/config/warning_disable.hpp>
 #include <boost/foreach.hpp>
 #include <boost/locale.hpp>
+#include <boost/regex.hpp>
 #include <boost/spirit/include/qi.hpp>
 #include <boost/spirit/include/phoenix_bind.hpp>
 #include <boost/spirit/include/phoenix_core.hpp>
@@ -136,6 +137,7 @@ struct Script : qi::grammar<Iterator, Skipper> {
 	qi::rule<Iterator> l_shell;
 	qi::rule<Iterator> l_include;
 	qi::rule<Iterator> l_import;
+	qi::rule<Iterator> l_exclude;
 	qi::rule<Iterator> l_and;
 	qi::rule<Iterator> l_or;
 	qi::rule<Iterator> l_is;
@@ -156,6 +158,7 @@ struct Script : qi::grammar<Iterator, Skipper> {
 	qi::rule<Iterator> l_all;
 	qi::rule<Iterator> l_none;
 	qi::rule<Iterator> l_execution;
+	qi::rule<Iterator> l_resources;
 	/* complex grammars */
 	qi::rule<Iterator, std::string()> arrayIndex;
 	qi::rule<Iterator, std::string()> idString;
@@ -187,6 +190,8 @@ struct Script : qi::grammar<Iterator, Skipper> {
 	qi::rule<Iterator, pp::Command(), qi::locals<Iterator> > command;
 	qi::rule<Iterator, pp::ProcessBlock(), qi::locals<ProcessBlock::Type, pp::StringLiteral, bool>, Skipper> processBlock;
 	qi::rule<Iterator, pp::Process *(), Skipper> processPragmaInclude;
+	qi::rule<Iterator, std::string()> resourceRequirement;
+	qi::rule<Iterator, void(pp::Process &), qi::locals<Iterator>, Skipper> processPragmaResources;
 	qi::rule<Iterator, pp::Process(), Skipper> process;
 	qi::rule<Iterator, void(pp::StringLiteralVector &, bool &), Skipper> processParameterList;
 	qi::rule<Iterator, pp::ProcessNode(), qi::locals<std::string /* _a */, bool /* _b */>, Skipper> executionElement;
@@ -326,6 +331,7 @@ struct Script : qi::grammar<Iterator, Skipper> {
 		MAKE_LITERAL(shell);
 		MAKE_LITERAL(include);
 		MAKE_LITERAL(import);
+		MAKE_LITERAL(exclude);
 		MAKE_LITERAL(is);
 		MAKE_LITERAL(set);
 		MAKE_LITERAL(file);
@@ -339,6 +345,7 @@ struct Script : qi::grammar<Iterator, Skipper> {
 		MAKE_LITERAL(all);
 		MAKE_LITERAL(none);
 		MAKE_LITERAL(execution);
+		MAKE_LITERAL(resources);
 		
 #undef MAKE_LITERAL
 
@@ -475,6 +482,10 @@ struct Script : qi::grammar<Iterator, Skipper> {
 						| lit("remove-temporaries")   [ref(this->script.config.removeTemporaries)   = _a]
 						| lit("clean-up-incompletes") [ref(this->script.config.cleanUpIncompletes)  = _a]
 						| lit("remove-remains")       [ref(this->script.config.removeRemains)       = _a]
+						| lit("log-database")         [ref(this->script.config.logDatabase)         = _a]
+						| lit("database-snapshot")    [ref(this->script.config.databaseSnapshot)    = _a]
+						| lit("pipelined-execution")  [ref(this->script.config.pipelinedExecution)  = _a]
+						| lit("content-hash")         [ref(this->script.config.contentHash)         = _a]
 					)
 				)
 				/* verbosity */
@@ -502,6 +513,8 @@ struct Script : qi::grammar<Iterator, Skipper> {
 				| ((l_import > gap) > nonEmptyValueString(true, false)[_pass = phx::bind<bool>(&Script::readImport, this, _1)])
 				/* include */
 				| ((l_include > gap) > nonEmptyValueString(true, false)[_pass = phx::bind<bool>(&Script::readInclude, this, _1)])
+				/* exclude */
+				| ((l_exclude > gap) > valueString(true, false)[_pass = phx::bind<bool>(&Script::addExcludePattern, this, _1)])
 			)
 		];
 		
@@ -631,6 +644,20 @@ struct Script : qi::grammar<Iterator, Skipper> {
 			lexeme[pragmaPrefix > l_include > gap > processId[_pass = phx::bind<bool>(&Script::getProcess, this, _val, _1)]]
 		);
 		
+		resourceRequirement.name("<resource>=<amount>");
+		resourceRequirement %= (
+			+char_("_a-zA-Z0-9") >> char_('=') >> +char_("a-zA-Z0-9")
+		);
+		
+		/* @param[in,out] _r1 - output variable for process */
+		processPragmaResources.name("@resources <resource>=<amount> ...");
+		processPragmaResources = (
+			lexeme[
+				pragmaPrefix >> l_resources >> +blank
+				> ((omit[iter_pos[_a = _1]] >> resourceRequirement[_pass = phx::bind<bool>(&Script::addProcessResource, this, _r1, _1, _a)]) % +blank)
+			]
+		);
+		
 		process.name("process : <id> { ... }");
 		process = (
 			iter_pos[phx::bind(&Script::setLineInfo<Process>, _val, _1)]
@@ -638,6 +665,7 @@ struct Script : qi::grammar<Iterator, Skipper> {
 			> beginGroup[phx::bind(&Script::enterScope, this)]
 			> *(
 				  processBlock[phx::bind(&Script::addProcessBlock, _val, _1)]
+				| processPragmaResources(_val)
 				| processPragmaInclude[phx::bind(&Script::includeProcessBlocks, _val, _1)]
 			)
 			> endGroup[phx::bind(&Script::leaveScope, this)]
@@ -1346,6 +1374,30 @@ private:
 		return false;
 	}
 	
+	/**
+	 * Adds the given regular expression to the paths skipped by the full recursive match of input
+	 * files. An empty string removes all previously added patterns.
+	 *
+	 * @param[in] p - regular expression of the excluded paths
+	 * @return true on success, else false
+	 */
+	bool addExcludePattern(const pp::StringLiteral & p) {
+		if (p.isSet() == false || p.isVariable()) return false;
+		const std::string pattern(p.getString());
+		if ( pattern.empty() ) {
+			this->script.config.excludePatterns.clear();
+			return true;
+		}
+		try {
+			const boost::wregex regex(boost::locale::conv::utf_to_utf<wchar_t>(pattern), boost::regex_constants::perl);
+		} catch (const boost::regex_error & e) {
+			std::cerr << p.getLineInfo() << ": Error: Regular expression '" << pattern << "' is invalid.\n" << e.what() << std::endl;
+			return false;
+		}
+		this->script.config.excludePatterns.push_back(pattern);
+		return true;
+	}
+	
 	/**
 	 * Returns the numeric representation of the content from the given variable in the desired type.
 	 *
@@ -1607,6 +1659,26 @@ private:
 		proc.processBlocks.push_back(pb);
 	}
 	
+	/**
+	 * Adds the given resource requirement to the passed process.
+	 *
+	 * @param[in,out] proc - add to this process
+	 * @param[in] str - resource requirement in the format "<resource>=<amount>"
+	 * @param[in] it - extract script location from this iterator
+	 * @return true on success, else false
+	 */
+	bool addProcessResource(Process & proc, const std::string & str, const Iterator & it) {
+		const boost::optional<ResourceMap::value_type> resource(getResourcePair(str));
+		if ( ! resource ) {
+			const boost::spirit::classic::file_position_base<std::string> & pos = it.get_position();
+			const pp::LineInfo scriptPos(pos.file, static_cast<size_t>(pos.line), static_cast<size_t>(pos.column));
+			std::cerr << scriptPos << ": Invalid resource requirement: " << str << std::endl;
+			return false;
+		}
+		proc.resources[resource->first] = resource->second;
+		return true;
+	}
+	
 	/**
 	 * Sets the ID of the passed process.
 	 *
@@ -1771,11 +1843,13 @@ private:
 		if ( this->script.config.removeRemains ) {
 			/* database is only active if auto remaining file removal is set */
 			const boost::optional<pp::StringLiteral &> dbFilePath(this->script.vars.get("db"));
+			const Database::Format dbFormat = ( this->script.config.logDatabase ) ? Database::LOG : Database::SQLITE;
 			if ( dbFilePath && dbFilePath->isSet() ) {
-				exec.setDatabase(boost::filesystem::path(dbFilePath->getString(), pcf::path::utf8));
+				exec.setDatabase(boost::filesystem::path(dbFilePath->getString(), pcf::path::utf8), dbFormat);
 			} else {
 				boost::filesystem::path databasePath(this->script.mainSource.parent_path());
-				exec.setDatabase(databasePath / (this->script.mainSource.filename().string(pcf::path::utf8) + ".db"));
+				const char * const extension = ( this->script.config.logDatabase ) ? ".dblog" : ".db";
+				exec.setDatabase(databasePath / (this->script.mainSource.filename().string(pcf::path::utf8) + extension), dbFormat);
 			}
 		}
 		/* set configuration */
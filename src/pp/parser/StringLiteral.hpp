@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2015-2018 Daniel Starke
  * @date 2015-10-31
- * @version 2016-11-27
+ * @version 2026-10-17
  */
 #ifndef __PP_PARSER_STRINGLITERAL_HPP__
 #define __PP_PARSER_STRINGLITERAL_HPP__
@@ -202,6 +202,7 @@ struct StringLiteral : qi::grammar<Iterator, StringLiteralCaptureVector(pp::Stri
 				| string("extension")[_val = construct<StringLiteralFunctionPair>(_1, pp::StringLiteral::functionExtension)]
 				| string("exists")   [_val = construct<StringLiteralFunctionPair>(_1, pp::StringLiteral::functionExists)]
 				| string("rexists")  [_val = phx::bind<StringLiteralFunctionPair>(&StringLiteral::getRExistsFunction, _1, _a, phx::ref(this->fullRecursiveMatch))]
+				| string("gexists")  [_val = phx::bind<StringLiteralFunctionPair>(&StringLiteral::getGExistsFunction, _1, _a)]
 			))
 		);
 		
@@ -430,6 +431,20 @@ private:
 		const LineInfo li(pos.file, static_cast<size_t>(pos.line), static_cast<size_t>(pos.column));
 		return StringLiteralFunctionPair(str, phx::bind(&pp::StringLiteral::functionRExists, phx::placeholders::_1, li, frm));
 	}
+	
+	/**
+	 * Returns a gexists function object for the given string.
+	 * 
+	 * @param[in] str - string to apply this function to
+	 * @param[in] it - extract script location from this iterator
+	 * @return gexists function object
+	 * @see pp::StringLiteral::functionGExists
+	 */
+	static StringLiteralFunctionPair getGExistsFunction(const std::string & str, const Iterator & it) {
+		const boost::spirit::classic::file_position_base<std::string> & pos = it.get_position();
+		const LineInfo li(pos.file, static_cast<size_t>(pos.line), static_cast<size_t>(pos.column));
+		return StringLiteralFunctionPair(str, phx::bind(&pp::StringLiteral::functionGExists, phx::placeholders::_1, li));
+	}
 };
 
 
@@ -0,0 +1,69 @@
+# @file database-snapshot1.sh
+# @author Daniel Starke
+# @copyright Copyright 2026 Daniel Starke
+# @date 2026-10-17
+# @version 2026-10-17
+
+database_snapshot1_cleanup() {
+	rm -rf database-snapshot1
+	return 0
+}
+
+to_var t_create <<"_END"
+d database-snapshot1
+f database-snapshot1/in.txt
+_END
+
+to_var t_script <<"_END"
+@enable environment-variables
+@enable remove-remains
+@enable database-snapshot
+
+db = "database-snapshot1/state.db"
+input = "database-snapshot1/in\\.txt"
+
+process : A { foreach {
+	destination = "{?:directory}/out1.txt"
+	echo output1 > "{destination}"
+} }
+
+process : B { foreach {
+	destination = "{?:directory}/out2.txt"
+	echo output2 > "{destination}"
+} }
+
+execution : default {
+	@if TEST_RUN is "3"
+		B("{input}")
+	@else
+		A("{input}")
+	@end
+}
+
+_END
+
+to_var t_text <<"_END"
+^deleting "database-snapshot1/out1.txt": ok$
+_END
+
+to_var t_nerror <<"_END"
+^process\\.parallel:.*:.*:.*$
+_END
+
+to_var t_check <<"_END"
+f database-snapshot1/out2.txt
+f database-snapshot1/state.db
+_END
+
+to_var t_ncheck <<"_END"
+f database-snapshot1/out1.txt
+_END
+
+t_runs="3"
+
+t_exit="0"
+
+t_before="database_snapshot1_cleanup"
+if [ "${clean}" -eq 1 ]; then
+	t_after="database_snapshot1_cleanup"
+fi
@@ -0,0 +1,76 @@
+# @file exclude1.sh
+# @author Daniel Starke
+# @copyright Copyright 2026 Daniel Starke
+# @date 2026-10-17
+# @version 2026-10-17
+
+exclude1_cleanup() {
+	rm -rf exclude1
+	return 0
+}
+
+to_var t_create <<"_END"
+f exclude1/in/a.txt
+f exclude1/in/tmp.txt
+f exclude1/in/sub/b.txt
+f exclude1/in/sub/tmp/c.txt
+f exclude1/in/.git/d.txt
+f exclude1/in/tmp/e.txt
+f exclude1/in/other/f.txt
+_END
+
+to_var t_script <<"_END"
+@disable remove-temporaries
+@disable remove-remains
+@disable clean-up-incompletes
+@enable full-recursive-match
+
+@exclude "\\.git"
+@exclude "tmp/"
+@exclude "other/f\\.txt"
+
+process : A { foreach {
+	destination = "{?}.a"
+	echo A {?} > "{destination}"
+} }
+
+@exclude ""
+
+process : B { foreach {
+	destination = "{?}.b"
+	echo B {?} > "{destination}"
+} }
+
+execution : default {
+	A("exclude1/in/.*\\.txt")
+	B("exclude1/in/.*\\.txt")
+}
+_END
+
+to_var t_text <<"_END"
+echo A exclude1/in/a\\.txt
+echo A exclude1/in/tmp\\.txt
+echo A exclude1/in/sub/b\\.txt
+echo B exclude1/in/sub/tmp/c\\.txt
+echo B exclude1/in/\\.git/d\\.txt
+echo B exclude1/in/tmp/e\\.txt
+echo B exclude1/in/other/f\\.txt
+_END
+
+to_var t_ntext <<"_END"
+echo A exclude1/in/sub/tmp/c\\.txt
+echo A exclude1/in/\\.git/d\\.txt
+echo A exclude1/in/tmp/e\\.txt
+echo A exclude1/in/other/f\\.txt
+_END
+
+to_var t_nerror <<"_END"
+^process\\.parallel:.*:.*:.*$
+_END
+
+t_exit="0"
+
+t_before="exclude1_cleanup"
+if [ "${clean}" -eq 1 ]; then
+	t_after="exclude1_cleanup"
+fi
@@ -0,0 +1,69 @@
+# @file log-database1.sh
+# @author Daniel Starke
+# @copyright Copyright 2026 Daniel Starke
+# @date 2026-10-17
+# @version 2026-10-17
+
+log_database1_cleanup() {
+	rm -rf log-database1
+	return 0
+}
+
+to_var t_create <<"_END"
+d log-database1
+f log-database1/in.txt
+_END
+
+to_var t_script <<"_END"
+@enable environment-variables
+@enable remove-remains
+@enable log-database
+
+db = "log-database1/state.dblog"
+input = "log-database1/in\\.txt"
+
+process : A { foreach {
+	destination = "{?:directory}/out1.txt"
+	echo output1 > "{destination}"
+} }
+
+process : B { foreach {
+	destination = "{?:directory}/out2.txt"
+	echo output2 > "{destination}"
+} }
+
+execution : default {
+	@if TEST_RUN is "1"
+		A("{input}")
+	@else
+		B("{input}")
+	@end
+}
+
+_END
+
+to_var t_text <<"_END"
+^deleting "log-database1/out1.txt": ok$
+_END
+
+to_var t_nerror <<"_END"
+^process\\.parallel:.*:.*:.*$
+_END
+
+to_var t_check <<"_END"
+f log-database1/out2.txt
+f log-database1/state.dblog
+_END
+
+to_var t_ncheck <<"_END"
+f log-database1/out1.txt
+_END
+
+t_runs="2"
+
+t_exit="0"
+
+t_before="log_database1_cleanup"
+if [ "${clean}" -eq 1 ]; then
+	t_after="log_database1_cleanup"
+fi
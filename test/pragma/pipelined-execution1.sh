@@ -0,0 +1,80 @@
+# @file pipelined-execution1.sh
+# @author Daniel Starke
+# @copyright Copyright 2026 Daniel Starke
+# @date 2026-10-17
+# @version 2026-10-17
+
+pipelined_execution1_cleanup() {
+	rm -rf pipelined-execution1
+	return 0
+}
+
+to_var t_create <<"_END"
+d pipelined-execution1
+f pipelined-execution1/in1.txt
+f pipelined-execution1/in2.txt
+f pipelined-execution1/in3.txt
+_END
+
+to_var t_script <<"_END"
+@enable pipelined-execution
+@disable remove-temporaries
+@disable remove-remains
+@disable clean-up-incompletes
+
+input = "pipelined-execution1/in(?<num>[0-9]+)\\.txt"
+
+process : A { foreach {
+	destination = "{?:directory}/l1_{num}.txt"
+	echo {?} > "{destination}"
+} }
+
+process : B { foreach ".*l1_(?<num>[0-9])\\.txt" {
+	destination = "{?:directory}/l2_{num}.txt"
+	echo {?} > "{destination}"
+} }
+
+process : C { all {
+	destination = "pipelined-execution1/out.txt"
+	echo {*} > "{destination}"
+} }
+
+process : D { none {
+	destination = "pipelined-execution1/done.txt"
+	echo done > "{destination}"
+} }
+
+execution : default {
+	A("{input}") > B > C > D
+}
+
+_END
+
+t_runs="2"
+
+to_var t_ntext <<"_END"
+echo pipelined-execution1/in1.txt
+echo pipelined-execution1/l1_1.txt
+_END
+
+to_var t_nerror <<"_END"
+^process\\.parallel:.*:.*:.*$
+_END
+
+to_var t_check <<"_END"
+f pipelined-execution1/l1_1.txt
+f pipelined-execution1/l1_2.txt
+f pipelined-execution1/l1_3.txt
+f pipelined-execution1/l2_1.txt
+f pipelined-execution1/l2_2.txt
+f pipelined-execution1/l2_3.txt
+f pipelined-execution1/out.txt
+f pipelined-execution1/done.txt
+_END
+
+t_exit="0"
+
+t_before="pipelined_execution1_cleanup"
+if [ "${clean}" -eq 1 ]; then
+	t_after="pipelined_execution1_cleanup"
+fi
@@ -0,0 +1,68 @@
+# @file pipelined-execution2.sh
+# @author Daniel Starke
+# @copyright Copyright 2026 Daniel Starke
+# @date 2026-10-17
+# @version 2026-10-17
+
+pipelined_execution2_cleanup() {
+	rm -rf pipelined-execution2
+	return 0
+}
+
+to_var t_create <<"_END"
+d pipelined-execution2
+f pipelined-execution2/in1.txt
+f pipelined-execution2/in2.txt
+_END
+
+to_var t_script <<"_END"
+@enable pipelined-execution
+@disable remove-temporaries
+@disable remove-remains
+@disable clean-up-incompletes
+
+input = "pipelined-execution2/in(?<num>[0-9]+)\\.txt"
+
+process : A { foreach {
+	destination = "{?:directory}/a{num}.txt"
+	echo {?} > "{destination}"
+	printf "A{num}," >> "pipelined-execution2/order.txt"
+} }
+
+process : B { foreach ".*a(?<num>2)\\.txt" {
+	destination = "{?:directory}/b{num}.txt"
+	echo {?} > "{destination}"
+	printf "B{num}," >> "pipelined-execution2/order.txt"
+} }
+
+process : C { none {
+	destination = "pipelined-execution2/done.txt"
+	cat "pipelined-execution2/order.txt" > "{destination}"
+	cat "pipelined-execution2/order.txt"
+} }
+
+execution : default {
+	A("{input}") > B > C
+}
+
+_END
+
+t_cmdline="-j 1"
+
+to_var t_text <<"_END"
+^A2,B2,A1,$
+_END
+
+to_var t_check <<"_END"
+f pipelined-execution2/a1.txt
+f pipelined-execution2/a2.txt
+f pipelined-execution2/b2.txt
+f pipelined-execution2/done.txt
+_END
+
+t_exit="0"
+
+t_before="pipelined_execution2_cleanup"
+if [ "${clean}" -eq 1 ]; then
+	t_after="pipelined_execution2_cleanup"
+fi
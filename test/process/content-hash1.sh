@@ -0,0 +1,76 @@
+# @file content-hash1.sh
+# @author Daniel Starke
+# @copyright Copyright 2026 Daniel Starke
+# @date 2026-10-17
+# @version 2026-10-17
+
+content_hash1_before() {
+	rm -rf content-hash1
+	mkdir -p content-hash1 || return 1
+	echo 1 > content-hash1/in1.txt || return 1
+	echo 2 > content-hash1/in2.txt || return 1
+	return 0
+}
+
+content_hash1_after() {
+	[ "${clean}" -eq 1 ] && rm -rf content-hash1
+	return 0
+}
+
+to_var t_script <<"_END"
+@disable remove-temporaries
+@enable remove-remains
+@disable clean-up-incompletes
+
+input = "content-hash1/in(?<num>[0-9]+)\\.txt"
+
+@enable content-hash
+process : A { foreach {
+	destination = "{?:directory}/a{num}.txt"
+	echo A {?} > "{destination}"
+} }
+
+@disable content-hash
+process : B { foreach {
+	destination = "{?:directory}/b{num}.txt"
+	echo B {?} > "{destination}"
+} }
+
+execution : default {
+	A("{input}")
+	B("{input}")
+}
+
+_END
+
+t_runs="2"
+
+to_var t_touch1 <<"_END"
+f content-hash1/in1.txt
+_END
+
+to_var t_text <<"_END"
+echo B content-hash1/in1.txt
+_END
+
+to_var t_ntext <<"_END"
+echo A content-hash1/in1.txt
+echo A content-hash1/in2.txt
+echo B content-hash1/in2.txt
+_END
+
+to_var t_nerror <<"_END"
+^process\\.parallel:.*:.*:.*$
+_END
+
+to_var t_check <<"_END"
+f content-hash1/a1.txt
+f content-hash1/a2.txt
+f content-hash1/b1.txt
+f content-hash1/b2.txt
+_END
+
+t_exit="0"
+
+t_before="content_hash1_before"
+t_after="content_hash1_after"
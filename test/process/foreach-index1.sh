@@ -0,0 +1,67 @@
+# @file foreach-index1.sh
+# @author Daniel Starke
+# @copyright Copyright 2026 Daniel Starke
+# @date 2026-10-17
+# @version 2026-10-17
+
+foreach_index1_before() {
+	rm -rf foreach-index1
+	mkdir -p foreach-index1/in foreach-index1/out || return 1
+	touch foreach-index1/in/in1.txt foreach-index1/in/in2.txt || return 1
+	# directory listings are only stored if the directory was not changed recently
+	sleep 3
+	return 0
+}
+
+foreach_index1_after() {
+	[ "${clean}" -eq 1 ] && rm -rf foreach-index1
+	return 0
+}
+
+to_var t_script <<"_END"
+@disable remove-temporaries
+@enable remove-remains
+@disable clean-up-incompletes
+
+input = "foreach-index1/in/in(?<num>[0-9]+)\\.txt"
+
+process : A { foreach {
+	destination = "foreach-index1/out/{num}.txt"
+	echo {?} > "{destination}"
+} }
+
+execution : default {
+	A("{input}")
+}
+
+_END
+
+t_runs="2"
+
+to_var t_touch1 <<"_END"
+f foreach-index1/in/in3.txt
+_END
+
+to_var t_text <<"_END"
+echo foreach-index1/in/in3.txt
+_END
+
+to_var t_ntext <<"_END"
+echo foreach-index1/in/in1.txt
+echo foreach-index1/in/in2.txt
+_END
+
+to_var t_nerror <<"_END"
+^process\\.parallel:.*:.*:.*$
+_END
+
+to_var t_check <<"_END"
+f foreach-index1/out/1.txt
+f foreach-index1/out/2.txt
+f foreach-index1/out/3.txt
+_END
+
+t_exit="0"
+
+t_before="foreach_index1_before"
+t_after="foreach_index1_after"
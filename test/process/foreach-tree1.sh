@@ -0,0 +1,75 @@
+# @file foreach-tree1.sh
+# @author Daniel Starke
+# @copyright Copyright 2026 Daniel Starke
+# @date 2026-10-17
+# @version 2026-10-17
+
+foreach_tree1_cleanup() {
+	rm -rf foreach-tree1
+	return 0
+}
+
+to_var t_create <<"_END"
+d foreach-tree1
+d foreach-tree1/a
+d foreach-tree1/a/x
+f foreach-tree1/a/x/in.txt
+f foreach-tree1/a/x/skip.dat
+d foreach-tree1/a/y
+f foreach-tree1/a/y/in.txt
+f foreach-tree1/a/y/skip.dat
+d foreach-tree1/b
+d foreach-tree1/b/x
+f foreach-tree1/b/x/in.txt
+f foreach-tree1/b/x/skip.dat
+d foreach-tree1/b/y
+f foreach-tree1/b/y/in.txt
+f foreach-tree1/b/y/skip.dat
+d foreach-tree1/c
+d foreach-tree1/c/x
+f foreach-tree1/c/x/in.txt
+f foreach-tree1/c/x/skip.dat
+d foreach-tree1/c/y
+f foreach-tree1/c/y/in.txt
+f foreach-tree1/c/y/skip.dat
+f foreach-tree1/a/skip.txt
+_END
+
+to_var t_script <<"_END"
+@disable remove-temporaries
+@disable remove-remains
+@disable clean-up-incompletes
+@disable full-recursive-match
+
+input = "foreach-tree1/.+/.+/in\\.txt"
+
+process : A { foreach {
+	destination = "{?:directory}/out.txt"
+	echo output > "{destination}"
+} }
+
+execution : default {
+	A("{input}")
+}
+
+_END
+
+to_var t_nerror <<"_END"
+^process\\.parallel:.*:.*:.*$
+_END
+
+to_var t_check <<"_END"
+f foreach-tree1/a/x/out.txt
+f foreach-tree1/a/y/out.txt
+f foreach-tree1/b/x/out.txt
+f foreach-tree1/b/y/out.txt
+f foreach-tree1/c/x/out.txt
+f foreach-tree1/c/y/out.txt
+_END
+
+t_exit="0"
+
+t_before="foreach_tree1_cleanup"
+if [ "${clean}" -eq 1 ]; then
+	t_after="foreach_tree1_cleanup"
+fi
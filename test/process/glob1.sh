@@ -0,0 +1,77 @@
+# @file glob1.sh
+# @author Daniel Starke
+# @copyright Copyright 2026 Daniel Starke
+# @date 2026-10-17
+# @version 2026-10-17
+
+glob1_cleanup() {
+	rm -rf glob1
+	return 0
+}
+
+to_var t_create <<"_END"
+f glob1/data/a.csv
+f glob1/data/b.txt
+f glob1/data/x/c.csv
+f glob1/data/x/y/d.csv
+f glob1/data/x/y/e.txt
+f glob1/data/z1/g.csv
+f glob1/other/f.csv
+_END
+
+to_var t_script <<"_END"
+@disable remove-temporaries
+@disable remove-remains
+@disable clean-up-incompletes
+
+process : A { foreach {
+	destination = "{?}.a"
+	echo A {?} > "{destination}"
+} }
+
+process : B { foreach {
+	destination = "{?}.b"
+	echo B {?} > "{destination}"
+} }
+
+process : C { foreach {
+	destination = "{?}.c"
+	echo C {?} > "{destination}"
+} }
+
+execution : default {
+	A("glob:glob1/data/**/*.csv")
+	B("glob:glob1/data/*/*.csv")
+	C("glob:glob1/data/z#/*.csv")
+}
+_END
+
+to_var t_text <<"_END"
+echo A glob1/data/a\\.csv
+echo A glob1/data/x/c\\.csv
+echo A glob1/data/x/y/d\\.csv
+echo A glob1/data/z1/g\\.csv
+echo B glob1/data/x/c\\.csv
+echo B glob1/data/z1/g\\.csv
+echo C glob1/data/z1/g\\.csv
+_END
+
+to_var t_ntext <<"_END"
+echo A glob1/data/b\\.txt
+echo A glob1/data/x/y/e\\.txt
+echo A glob1/other/f\\.csv
+echo B glob1/data/a\\.csv
+echo B glob1/data/x/y/d\\.csv
+echo C glob1/data/x/c\\.csv
+_END
+
+to_var t_nerror <<"_END"
+^process\\.parallel:.*:.*:.*$
+_END
+
+t_exit="0"
+
+t_before="glob1_cleanup"
+if [ "${clean}" -eq 1 ]; then
+	t_after="glob1_cleanup"
+fi
@@ -0,0 +1,55 @@
+# @file input-list1.sh
+# @author Daniel Starke
+# @copyright Copyright 2026 Daniel Starke
+# @date 2026-10-17
+# @version 2026-10-17
+
+input_list1_before() {
+	rm -rf input-list1
+	mkdir -p input-list1 || return 1
+	touch input-list1/in1.txt input-list1/in2.txt input-list1/in3.txt || return 1
+	printf 'input-list1/in1.txt\n\n  \t\ninput-list1/missing.txt\n\tinput-list1/in2.txt  \r\ninput-list1/in3.txt' > input-list1/list.txt || return 1
+	return 0
+}
+
+input_list1_after() {
+	[ "${clean}" -eq 1 ] && rm -rf input-list1
+	return 0
+}
+
+to_var t_script <<"_END"
+@disable remove-temporaries
+@disable remove-remains
+@disable clean-up-incompletes
+
+process : A { foreach {
+	destination = "{?}.out"
+	echo {?} > "{destination}"
+} }
+
+execution : default {
+	A("@input-list1/list.txt")
+}
+
+_END
+
+to_var t_text <<"_END"
+echo input-list1/in1\\.txt
+echo input-list1/in2\\.txt
+echo input-list1/in3\\.txt
+_END
+
+to_var t_error <<"_END"
+^input-list1/list\\.txt:4: Warning: Input file does not exist and will be ignored "input-list1/missing\\.txt"\\.$
+_END
+
+to_var t_check <<"_END"
+f input-list1/in1.txt.out
+f input-list1/in2.txt.out
+f input-list1/in3.txt.out
+_END
+
+t_exit="0"
+
+t_before="input_list1_before"
+t_after="input_list1_after"
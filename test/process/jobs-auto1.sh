@@ -0,0 +1,64 @@
+# @file jobs-auto1.sh
+# @author Daniel Starke
+# @copyright Copyright 2026 Daniel Starke
+# @date 2026-10-17
+# @version 2026-10-17
+
+jobs_auto1_cleanup() {
+	rm -rf jobs-auto1
+	return 0
+}
+
+to_var t_create <<"_END"
+d jobs-auto1
+f jobs-auto1/in1.txt
+f jobs-auto1/in2.txt
+f jobs-auto1/in3.txt
+_END
+
+to_var t_script <<"_END"
+@disable remove-temporaries
+@disable remove-remains
+@disable clean-up-incompletes
+
+@if PP_THREADS is "2"
+	@warn "ok"
+@else
+	@warn "nok"
+@end
+
+input = "jobs-auto1/in.\\.txt"
+
+process : A { foreach {
+	destination = "{?}.out"
+	echo output > "{destination}"
+} }
+
+execution : default {
+	A("{input}")
+}
+
+_END
+
+t_cmdline="-j auto:2"
+
+to_var t_error <<"_END"
+^process\\.parallel:.*:.*: Warn: ok$
+_END
+
+to_var t_nerror <<"_END"
+^process\\.parallel:.*:.*: Warn: nok$
+_END
+
+to_var t_check <<"_END"
+f jobs-auto1/in1.txt.out
+f jobs-auto1/in2.txt.out
+f jobs-auto1/in3.txt.out
+_END
+
+t_exit="0"
+
+t_before="jobs_auto1_cleanup"
+if [ "${clean}" -eq 1 ]; then
+	t_after="jobs_auto1_cleanup"
+fi
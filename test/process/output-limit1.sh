@@ -0,0 +1,30 @@
+# @file output-limit1.sh
+# @author Daniel Starke
+# @copyright Copyright 2026 Daniel Starke
+# @date 2026-10-17
+# @version 2026-10-17
+
+to_var t_script <<"_END"
+process : A { none {
+	printf "first line of a long output\r\nsecond line of a long output"
+} }
+
+process : B { none {
+	echo short
+} }
+
+execution : default {
+	A > B
+}
+
+_END
+
+t_cmdline="-b --output-limit 16"
+
+to_var t_text <<"_END"
+^first line of a long output$
+^second line of a long output$
+^short$
+_END
+
+t_exit="0"
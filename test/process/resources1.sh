@@ -0,0 +1,59 @@
+# @file resources1.sh
+# @author Daniel Starke
+# @copyright Copyright 2026 Daniel Starke
+# @date 2026-10-17
+# @version 2026-10-17
+
+resources1_cleanup() {
+	rm -rf resources1
+	return 0
+}
+
+to_var t_create <<"_END"
+d resources1
+f resources1/in1.txt
+f resources1/in2.txt
+f resources1/in3.txt
+f resources1/in4.txt
+_END
+
+to_var t_script <<"_END"
+@disable remove-temporaries
+@disable remove-remains
+@disable clean-up-incompletes
+
+input = "resources1/in.\\.txt"
+
+process : A {
+	@resources mem=2 unlimited=5
+	foreach {
+		destination = "{?}.out"
+		mkdir resources1/lock && sleep 0.2 && rmdir resources1/lock && echo output > "{destination}"
+	}
+}
+
+execution : default {
+	A("{input}")
+}
+
+_END
+
+t_cmdline="-j 4 -r mem=3"
+
+to_var t_nerror <<"_END"
+^process\\.parallel:.*:.*:.*$
+_END
+
+to_var t_check <<"_END"
+f resources1/in1.txt.out
+f resources1/in2.txt.out
+f resources1/in3.txt.out
+f resources1/in4.txt.out
+_END
+
+t_exit="0"
+
+t_before="resources1_cleanup"
+if [ "${clean}" -eq 1 ]; then
+	t_after="resources1_cleanup"
+fi
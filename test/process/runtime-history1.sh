@@ -0,0 +1,61 @@
+# @file runtime-history1.sh
+# @author Daniel Starke
+# @copyright Copyright 2026 Daniel Starke
+# @date 2026-10-17
+# @version 2026-10-17
+
+runtime_history1_cleanup() {
+	rm -rf runtime-history1
+	return 0
+}
+
+to_var t_create <<"_END"
+d runtime-history1
+f runtime-history1/in1.txt
+f runtime-history1/in5.txt
+_END
+
+to_var t_script <<"_END"
+@enable remove-remains
+
+db = "runtime-history1/state.db"
+input = "runtime-history1/in(?<num>[0-9]+)\\.txt"
+
+process : A { foreach {
+	destination = "{?:directory}/out{num}.txt"
+	sleep 0.{num}
+	printf "{num}," >> "runtime-history1/order.txt"
+	echo {?} > "{destination}"
+} }
+
+process : B { none {
+	cat "runtime-history1/order.txt"
+	rm "runtime-history1/order.txt"
+} }
+
+execution : default {
+	A("{input}") > B
+}
+
+_END
+
+t_cmdline="-b -j 1"
+
+t_runs="2"
+
+to_var t_text <<"_END"
+^5,1,$
+_END
+
+to_var t_check <<"_END"
+f runtime-history1/out1.txt
+f runtime-history1/out5.txt
+f runtime-history1/state.db
+_END
+
+t_exit="0"
+
+t_before="runtime_history1_cleanup"
+if [ "${clean}" -eq 1 ]; then
+	t_after="runtime_history1_cleanup"
+fi
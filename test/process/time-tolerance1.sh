@@ -0,0 +1,57 @@
+# @file time-tolerance1.sh
+# @author Daniel Starke
+# @copyright Copyright 2026 Daniel Starke
+# @date 2026-10-17
+# @version 2026-10-17
+
+time_tolerance1_before() {
+	rm -rf time-tolerance1
+	mkdir -p time-tolerance1 || return 1
+	# inputs changed within the same second after their outputs were created
+	touch -d "2020-01-01 00:00:00.100" time-tolerance1/out1.txt time-tolerance1/out2.txt || return 1
+	touch -d "2020-01-01 00:00:00.500" time-tolerance1/in1.txt || return 1
+	touch -d "2020-01-01 00:00:00.050" time-tolerance1/in2.txt || return 1
+	return 0
+}
+
+time_tolerance1_after() {
+	[ "${clean}" -eq 1 ] && rm -rf time-tolerance1
+	return 0
+}
+
+to_var t_script <<"_END"
+@disable remove-temporaries
+@disable remove-remains
+@disable clean-up-incompletes
+
+input = "time-tolerance1/in(?<num>[0-9]+)\\.txt"
+
+process : A { foreach {
+	destination = "{?:directory}/out{num}.txt"
+	echo {?} > "{destination}"
+} }
+
+execution : default {
+	A("{input}")
+}
+
+_END
+
+t_cmdline="--time-tolerance 100"
+
+to_var t_text <<"_END"
+echo time-tolerance1/in1.txt
+_END
+
+to_var t_ntext <<"_END"
+echo time-tolerance1/in2.txt
+_END
+
+to_var t_nerror <<"_END"
+^process\\.parallel:.*:.*:.*$
+_END
+
+t_exit="0"
+
+t_before="time_tolerance1_before"
+t_after="time_tolerance1_after"
@@ -0,0 +1,57 @@
+# @file time-tolerance2.sh
+# @author Daniel Starke
+# @copyright Copyright 2026 Daniel Starke
+# @date 2026-10-17
+# @version 2026-10-17
+
+time_tolerance2_before() {
+	rm -rf time-tolerance2
+	mkdir -p time-tolerance2 || return 1
+	# in1 changed less than a second after its output but in a later second,
+	# in2 changed later within the same second
+	touch -d "2020-01-01 00:00:00.900" time-tolerance2/out1.txt || return 1
+	touch -d "2020-01-01 00:00:01.400" time-tolerance2/in1.txt || return 1
+	touch -d "2020-01-01 00:00:00.100" time-tolerance2/out2.txt || return 1
+	touch -d "2020-01-01 00:00:00.900" time-tolerance2/in2.txt || return 1
+	return 0
+}
+
+time_tolerance2_after() {
+	[ "${clean}" -eq 1 ] && rm -rf time-tolerance2
+	return 0
+}
+
+to_var t_script <<"_END"
+@disable remove-temporaries
+@disable remove-remains
+@disable clean-up-incompletes
+
+input = "time-tolerance2/in(?<num>[0-9]+)\\.txt"
+
+process : A { foreach {
+	destination = "{?:directory}/out{num}.txt"
+	echo {?} > "{destination}"
+} }
+
+execution : default {
+	A("{input}")
+}
+
+_END
+
+to_var t_text <<"_END"
+echo time-tolerance2/in1.txt
+_END
+
+to_var t_ntext <<"_END"
+echo time-tolerance2/in2.txt
+_END
+
+to_var t_nerror <<"_END"
+^process\\.parallel:.*:.*:.*$
+_END
+
+t_exit="0"
+
+t_before="time_tolerance2_before"
+t_after="time_tolerance2_after"
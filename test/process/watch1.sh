@@ -0,0 +1,67 @@
+# @file watch1.sh
+# @author Daniel Starke
+# @copyright Copyright 2026 Daniel Starke
+# @date 2026-10-17
+# @version 2026-10-17
+
+watch1_before() {
+	rm -rf watch1
+	mkdir -p watch1 || return 1
+	echo 1 > watch1/in1.txt || return 1
+	echo 2 > watch1/in2.txt || return 1
+	return 0
+}
+
+watch1_after() {
+	[ "${clean}" -eq 1 ] && rm -rf watch1
+	return 0
+}
+
+# The first run changes an input file while the commands are still running. Only the affected
+# transitions are executed again. The second run stops pp. The guard stops pp if the change
+# was missed.
+to_var t_script <<"_END"
+@disable remove-temporaries
+@disable remove-remains
+@disable clean-up-incompletes
+
+input = "watch1/in(?<num>[0-9]+)\\.txt"
+
+process : A { foreach {
+	destination = "{?:directory}/a{num}.txt"
+	cat {?} > "{destination}"
+	echo {?} >> watch1.runs
+} }
+
+process : B { all {
+	destination = "watch1/b.txt"
+	cat {*} > "{destination}"
+	if grep -q changed "{destination}"; then kill $(cat watch1.guard); echo "runs: $(wc -l < watch1.runs)"; kill -INT $PPID; else (sleep 30; kill -INT $PPID) > /dev/null 2>&1 & echo $! > watch1.guard; echo changed > watch1/in1.txt; fi
+} }
+
+execution : default {
+	A("{input}") > B
+}
+
+_END
+
+t_cmdline="--watch"
+
+to_var t_text <<"_END"
+runs: 3
+_END
+
+to_var t_nerror <<"_END"
+^process\\.parallel:.*:.*:.*$
+_END
+
+to_var t_check <<"_END"
+f watch1/a1.txt
+f watch1/a2.txt
+f watch1/b.txt
+_END
+
+t_exit="0"
+
+t_before="watch1_before"
+t_after="watch1_after"
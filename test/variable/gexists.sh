@@ -0,0 +1,33 @@
+# @file gexists.sh
+# @author Daniel Starke
+# @copyright Copyright 2026 Daniel Starke
+# @date 2026-10-17
+# @version 2026-10-17
+
+to_var t_script <<"_END"
+a = "gexists.*"
+b = "*.sh"
+c = "unknown.file"
+d = "**/gexists.sh"
+e = "**/*.unknown"
+
+@warn "{PP_SCRIPT:unix:gexists}"
+@warn "{a:gexists}"
+@warn "{b:gexists}"
+@warn "{c:gexists}"
+@warn "{d:gexists}"
+@warn "{e:gexists}"
+
+execution : default {}
+_END
+
+to_var t_error <<"_END"
+^process\\.parallel:7:.*: Warn: true$
+^process\\.parallel:8:.*: Warn: true$
+^process\\.parallel:9:.*: Warn: true$
+^process\\.parallel:10:.*: Warn: false$
+^process\\.parallel:11:.*: Warn: true$
+^process\\.parallel:12:.*: Warn: false$
+_END
+
+t_exit="0"